@@ -0,0 +1,204 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__AGGREGATION_TREE_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__AGGREGATION_TREE_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "collector.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * Rolls the statistics of collectors up into groups at several levels, e.g. per subscription, per
+ * topic across subscriptions, and per node, without ingesting any measurement more than once.
+ *
+ * The leaves of the tree are collectors, measured as usual: the tree never touches the
+ * measurement path. A group holds no state of its own. Its statistics are merged from those of
+ * its children with moving_average_statistics::AccumulatorState::Merge only when they are read,
+ * by GetStatistics or at publish time, see GetStatisticsAndReset. Merged statistics are exact for
+ * collectors accumulating a MovingAverageStatistics, and their sample rate is the ratio of the
+ * samples to the estimated observations of the children.
+ *
+ * The tree takes and resets the statistics of its collectors when publishing, so a collector
+ * should not also be published by other means, e.g. a CollectorRegistry. The reset runs on the
+ * publishing thread while the collectors keep accepting data, which every
+ * moving_average_statistics::WriterMode and accumulator of this package supports, see
+ * CollectorRegistry. All members are thread safe and serialized by a mutex.
+ */
+class AggregationTree
+{
+public:
+  /// Identifies a node of the tree
+  using NodeId = size_t;
+
+  /// The parent of the root groups
+  static constexpr NodeId kNoParent = std::numeric_limits<NodeId>::max();
+
+  /**
+   * Construct an empty tree.
+   *
+   * @param node_name the measurement source name of all generated messages
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit AggregationTree(const std::string & node_name);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~AggregationTree() = default;
+
+  /**
+   * Add a group, rolling up the statistics of its children.
+   *
+   * @param metric_name the metric name of the group, e.g. "/chatter/message_age"
+   * @param metric_unit the metric unit of the group, the unit of its children
+   * @param parent the group to add the group to, or kNoParent for a root group
+   * @return the id of the group
+   * @throws std::invalid_argument if parent is neither kNoParent nor a group of this tree
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  NodeId AddGroup(
+    const std::string & metric_name, const std::string & metric_unit,
+    const NodeId parent = kNoParent);
+
+  /**
+   * Add a collector to a group. Its metric unit is the one of the collector.
+   *
+   * @param collector the collector to add
+   * @param metric_name the metric name of the collector, e.g. "/chatter/subscription_1/message_age"
+   * @param parent the group to add the collector to
+   * @return the id of the collector in the tree
+   * @throws std::invalid_argument if collector is null or parent is not a group of this tree
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  NodeId AddCollector(
+    std::shared_ptr<Collector> collector, const std::string & metric_name, const NodeId parent);
+
+  /**
+   * Remove a node and all nodes below it. Ids are not reused. Unknown or already removed ids are
+   * ignored.
+   *
+   * @param id the id of the node
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Remove(const NodeId id);
+
+  /**
+   * Return the current statistics of a node, merging those of the collectors below it, without
+   * resetting them.
+   *
+   * @param id the id of the node
+   * @return the statistics of the node
+   * @throws std::invalid_argument if id is not a node of this tree
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  moving_average_statistics::StatisticData GetStatistics(const NodeId id) const;
+
+  /**
+   * Take and reset the statistics of every collector once, and roll them up into the groups in a
+   * single pass from the leaves to the roots.
+   *
+   * @return the statistics of every node, indexed by NodeId, empty for removed nodes
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::vector<moving_average_statistics::StatisticData> GetStatisticsAndReset();
+
+  /**
+   * Take and reset the statistics of every collector, see GetStatisticsAndReset, and return one
+   * MetricsMessage per node of the tree, in NodeId order.
+   *
+   * @param window_start measurement window start time of all messages
+   * @param window_stop measurement window end time of all messages
+   * @return the generated messages
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::vector<statistics_msgs::msg::MetricsMessage> GenerateStatisticMessages(
+    const builtin_interfaces::msg::Time window_start,
+    const builtin_interfaces::msg::Time window_stop);
+
+  /**
+   * Return the number of nodes of the tree, groups and collectors.
+   *
+   * @return the number of nodes that were not removed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetNodeCount() const;
+
+private:
+  /**
+   * A group, or a collector if collector is not null.
+   */
+  struct Node
+  {
+    std::string metric_name;
+    std::string metric_unit;
+    std::shared_ptr<Collector> collector;
+    NodeId parent;
+    std::vector<NodeId> children;
+    bool removed;
+  };
+
+  /**
+   * The merged statistics of a node, with the estimated number of observations they sample.
+   */
+  struct Rollup
+  {
+    moving_average_statistics::AccumulatorState state;
+    double observation_count = 0;
+
+    void Add(const moving_average_statistics::StatisticData & data);
+    void Merge(const Rollup & other);
+    moving_average_statistics::StatisticData ToStatisticData() const;
+  };
+
+  NodeId AddNode(Node node) RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  bool IsGroup(const NodeId id) const RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Merge the current statistics of the collectors below a node.
+   */
+  Rollup GetRollup(const NodeId id) const RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  std::vector<moving_average_statistics::StatisticData> GetStatisticsAndResetUnsynchronized()
+  RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  const std::string node_name_;
+
+  mutable std::mutex mutex_;
+  /// Every node ever added, in NodeId order, so that children always follow their parent
+  std::vector<Node> nodes_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  size_t node_count_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__AGGREGATION_TREE_HPP_
@@ -0,0 +1,219 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__BACKGROUND_PUBLISHER_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__BACKGROUND_PUBLISHER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "bounded_queue.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * Generates and publishes MetricsMessages on a background thread, so that the thread ending the
+ * statistics windows, e.g. a timer callback on the executor of a control loop, only takes the
+ * statistics of its collectors and hands them off.
+ *
+ * Submit copies a window's statistics into a BoundedQueue without locking, allocating or waking
+ * the background thread. The background thread drains the queue every poll period, updates one
+ * reused MetricsMessage per metric with UpdateStatisticMessage and passes it to the publish
+ * callback, e.g. one calling rclcpp::Publisher::publish. When the queue is full, Submit drops the
+ * window and counts it.
+ */
+class BackgroundPublisher
+{
+public:
+  /// Called on the background thread with every generated message
+  using PublishCallback = std::function<void (const statistics_msgs::msg::MetricsMessage &)>;
+
+  /**
+   * Options of a BackgroundPublisher
+   */
+  struct LIBSTATISTICS_COLLECTOR_PUBLIC Options
+  {
+    /// maximum number of submitted windows waiting for the background thread
+    size_t queue_capacity = 256;
+    /// period at which the background thread checks for submitted windows, which bounds the
+    /// publishing latency
+    std::chrono::nanoseconds poll_period = std::chrono::milliseconds{10};
+  };
+
+  /**
+   * Construct a stopped publisher.
+   *
+   * @param node_name the measurement source name of all published messages
+   * @param publish_callback the callback publishing the messages, called on the background
+   * thread only. Exceptions thrown by it are caught and counted, see GetPublishFailureCount.
+   * @param options the queue capacity and poll period
+   * @throws std::invalid_argument if publish_callback is empty, or if options has a zero queue
+   * capacity or a non-positive poll period
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  BackgroundPublisher(
+    const std::string & node_name, PublishCallback publish_callback, const Options & options);
+
+  /**
+   * Construct a stopped publisher with the default Options.
+   *
+   * @param node_name the measurement source name of all published messages
+   * @param publish_callback the callback publishing the messages, see above
+   * @throws std::invalid_argument if publish_callback is empty
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  BackgroundPublisher(const std::string & node_name, PublishCallback publish_callback);
+
+  /**
+   * Stop the background thread, publishing the windows submitted so far.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~BackgroundPublisher();
+
+  BackgroundPublisher(const BackgroundPublisher &) = delete;
+  BackgroundPublisher & operator=(const BackgroundPublisher &) = delete;
+
+  /**
+   * Add a metric to publish the windows of. Thread safe, but may wait for the background thread
+   * to finish publishing the messages of a poll, so metrics should be added before the first
+   * window is submitted.
+   *
+   * @param metric_name the name of the metric
+   * @param metric_unit the name of the unit of the metric
+   * @return the id to submit the windows of the metric with
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t AddMetric(const std::string & metric_name, const std::string & metric_unit);
+
+  /**
+   * Hand off the statistics of a window to the background thread. Lock-free and allocation
+   * free, may be called from any thread, and whether or not the publisher is started.
+   *
+   * @param metric_id the id returned by AddMetric
+   * @param window_start measurement window start time
+   * @param window_stop measurement window end time
+   * @param statistics statistics derived from the measurements made in the window, e.g. the
+   * result of Collector::GetStatisticsAndReset
+   * @return false if the window was dropped, because the queue is full or the metric is unknown
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool Submit(
+    size_t metric_id, const builtin_interfaces::msg::Time & window_start,
+    const builtin_interfaces::msg::Time & window_stop,
+    const moving_average_statistics::StatisticData & statistics);
+
+  /**
+   * Start the background thread.
+   *
+   * @return true if started, false if the publisher was already started
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool Start();
+
+  /**
+   * Stop the background thread after it published the windows submitted so far.
+   *
+   * @return true if stopped, false if the publisher was not started
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool Stop();
+
+  /**
+   * @return true if the background thread is started
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool IsStarted() const;
+
+  /**
+   * @return the number of messages published since construction
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetPublishedCount() const;
+
+  /**
+   * @return the number of windows dropped by Submit since construction
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetDroppedCount() const;
+
+  /**
+   * @return the number of calls of the publish callback that threw an exception
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetPublishFailureCount() const;
+
+private:
+  /**
+   * A submitted window
+   */
+  struct Snapshot
+  {
+    size_t metric_id;
+    builtin_interfaces::msg::Time window_start;
+    builtin_interfaces::msg::Time window_stop;
+    moving_average_statistics::StatisticData statistics;
+  };
+
+  void Run();
+  void PublishSubmitted();
+
+  const std::string node_name_;
+  const PublishCallback publish_callback_;
+  const std::chrono::nanoseconds poll_period_;
+  BoundedQueue<Snapshot> queue_;
+
+  /// guards the messages against AddMetric while the background thread publishes
+  std::mutex messages_mutex_;
+  std::vector<statistics_msgs::msg::MetricsMessage> messages_
+  RCPPUTILS_TSA_GUARDED_BY(messages_mutex_);
+  /// number of messages, stored after a message is added so that Submit can check ids lock-free
+  std::atomic<size_t> metric_count_{0};
+
+  /// serializes Start and Stop
+  std::mutex thread_mutex_;
+  std::thread thread_ RCPPUTILS_TSA_GUARDED_BY(thread_mutex_);
+  /// wakes the background thread early to stop
+  std::mutex wake_mutex_;
+  std::condition_variable wake_condition_;
+  bool running_ RCPPUTILS_TSA_GUARDED_BY(wake_mutex_) = false;
+  std::atomic<bool> started_{false};
+
+  std::atomic<uint64_t> published_count_{0};
+  std::atomic<uint64_t> dropped_count_{0};
+  std::atomic<uint64_t> publish_failure_count_{0};
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__BACKGROUND_PUBLISHER_HPP_
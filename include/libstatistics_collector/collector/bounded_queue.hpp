@@ -0,0 +1,160 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__BOUNDED_QUEUE_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__BOUNDED_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * A bounded lock-free queue for any number of producer and consumer threads, which never blocks
+ * and never allocates after construction: TryPush fails when the queue is full, TryPop when it is
+ * empty.
+ *
+ * This is the array queue of Dmitry Vyukov: every cell has a sequence number telling whether it
+ * is free for the producer or filled for the consumer of a given position, so that a push or a
+ * pop is one compare-and-swap of the position plus a release store of the cell sequence.
+ *
+ * @tparam T the element type, copied in and out of the queue
+ */
+template<typename T>
+class BoundedQueue
+{
+public:
+  /**
+   * Construct a queue.
+   *
+   * @param capacity the maximum number of elements, rounded up to a power of two
+   * @throws std::invalid_argument if capacity is 0
+   */
+  explicit BoundedQueue(const size_t capacity)
+  {
+    if (capacity == 0) {
+      throw std::invalid_argument("capacity must be positive");
+    }
+    size_t cell_count = 1;
+    while (cell_count < capacity) {
+      cell_count *= 2;
+    }
+    mask_ = cell_count - 1;
+    cells_ = std::make_unique<Cell[]>(cell_count);
+    for (size_t i = 0; i < cell_count; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue & operator=(const BoundedQueue &) = delete;
+
+  /**
+   * Add an element at the back of the queue.
+   *
+   * @param value the element to add
+   * @return false if the queue is full and the element was not added
+   */
+  bool TryPush(const T & value)
+  {
+    Cell * cell;
+    size_t position = push_position_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[position & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference =
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (push_position_.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;  // the cell still holds the element of the previous lap
+      } else {
+        position = push_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove the element at the front of the queue.
+   *
+   * @param value set to the removed element
+   * @return false if the queue is empty and value was not set
+   */
+  bool TryPop(T & value)
+  {
+    Cell * cell;
+    size_t position = pop_position_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[position & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference =
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+      if (difference == 0) {
+        if (pop_position_.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;  // the cell was not filled yet
+      } else {
+        position = pop_position_.load(std::memory_order_relaxed);
+      }
+    }
+    value = cell->value;
+    cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @return the maximum number of elements of the queue
+   */
+  size_t GetCapacity() const
+  {
+    return mask_ + 1;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+  /// the positions are written by different threads, keep them on separate cache lines
+  alignas(moving_average_statistics::kCacheLineSize) std::atomic<size_t> push_position_{0};
+  alignas(moving_average_statistics::kCacheLineSize) std::atomic<size_t> pop_position_{0};
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__BOUNDED_QUEUE_HPP_
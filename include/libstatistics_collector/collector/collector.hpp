@@ -15,11 +15,24 @@
 #ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_HPP_
 #define LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "libstatistics_collector/instrumentation.hpp"
 #include "libstatistics_collector/visibility_control.hpp"
+#include "libstatistics_collector/moving_average_statistics/accumulator_interface.hpp"
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
 #include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+#include "libstatistics_collector/moving_average_statistics/quantile_sketch.hpp"
 #include "libstatistics_collector/moving_average_statistics/types.hpp"
 
 #include "metric_details_interface.hpp"
@@ -33,6 +46,10 @@ namespace collector
 
 /**
  * Simple class in order to collect observed data and generate statistics for the given observations.
+ *
+ * A collector is cache line aligned and 256 bytes on x86-64 with libstdc++, or 320 with
+ * instrumentation, see kInstrumentationEnabled and the README for the size of the derived
+ * collectors.
  */
 class Collector : public MetricDetailsInterface
 {
@@ -40,17 +57,70 @@ public:
   LIBSTATISTICS_COLLECTOR_PUBLIC
   Collector() = default;
 
+  /**
+   * Construct a collector whose measurements are aggregated with the given writer mode.
+   * Use moving_average_statistics::WriterMode::kSingleWriter when AcceptData is only ever called
+   * from one thread at a time, e.g. a subscription callback, to avoid taking a lock per
+   * measurement; GetStatisticsAndReset and ClearCurrentMeasurements may still be called from
+   * another thread, e.g. a publisher. Use
+   * moving_average_statistics::WriterMode::kSharded when many threads call AcceptData
+   * concurrently, e.g. from a multi-threaded executor.
+   *
+   * @param writer_mode the writer mode of the underlying moving average statistics
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit Collector(moving_average_statistics::WriterMode writer_mode);
+
+  /**
+   * Construct a collector whose measurements are aggregated with the given accumulator instead of
+   * the default moving average, e.g. a moving_average_statistics::SlidingWindowStatistics to
+   * report statistics over a recent time window.
+   *
+   * @param accumulator the accumulator aggregating the measurements
+   * @throws std::invalid_argument if accumulator is null
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit Collector(std::unique_ptr<moving_average_statistics::AccumulatorInterface> accumulator);
+
   LIBSTATISTICS_COLLECTOR_PUBLIC
   virtual ~Collector() = default;
 
   /**
    * Add an observed measurement. This aggregates the measurement and calculates statistics
-   * via the moving_average class.
+   * via the moving_average class. Defined inline so that non-virtual calls, e.g. from the
+   * OnMessageReceived of a final topic statistics collector, are inlined into the caller.
    *
    * @param measurement the measurement observed
    */
   LIBSTATISTICS_COLLECTOR_PUBLIC
-  virtual void AcceptData(const double measurement);
+  virtual void AcceptData(const double measurement)
+  {
+    const auto timer = instrumentation_.TimeAcceptData();
+    if constexpr (kInstrumentationEnabled) {
+      if (std::isnan(measurement)) {
+        instrumentation_.CountDroppedSamples();
+      }
+    }
+    if (accumulator_) {
+      accumulator_->AddMeasurement(measurement);
+    } else {
+      collected_data_.AddMeasurement(measurement);
+    }
+    if (quantile_sketch_) {
+      quantile_sketch_->AddMeasurement(measurement);
+    }
+  }
+
+  /**
+   * Add a block of observed measurements at once. This is equivalent to calling AcceptData for
+   * each measurement, but aggregates the whole block with a single update of the moving_average
+   * class.
+   *
+   * @param measurements pointer to the first measurement observed
+   * @param measurement_count number of measurements observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual void AcceptData(const double * measurements, size_t measurement_count);
 
   /**
    * Return the statistics for all of the observed data.
@@ -60,6 +130,87 @@ public:
   LIBSTATISTICS_COLLECTOR_PUBLIC
   virtual moving_average_statistics::StatisticData GetStatisticsResults() const;
 
+  /**
+   * Return the statistics for all of the observed data and clear the measurements in a single
+   * operation, so that no measurement accepted concurrently is lost between the two steps as it
+   * can be when calling GetStatisticsResults and ClearCurrentMeasurements. Meant to be called
+   * once per publishing window. The quantile estimates are reset as well, as by
+   * ClearCurrentMeasurements, so that the next window starts afresh for all of them.
+   *
+   * @return the StatisticData for all the observed measurements before they were cleared
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual moving_average_statistics::StatisticData GetStatisticsAndReset();
+
+  /**
+   * Return the statistics and quantile estimates for all of the observed data and clear the
+   * measurements, so that the statistics and the quantiles of a published window cover the same
+   * measurements, see GetStatisticsAndReset.
+   *
+   * @param quantiles set to the QuantileData of the observed measurements before they were cleared,
+   * see GetQuantileResults
+   * @return the StatisticData for all the observed measurements before they were cleared
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  moving_average_statistics::StatisticData GetStatisticsAndQuantilesAndReset(
+    moving_average_statistics::QuantileData & quantiles);
+
+  /**
+   * Return the statistics and the histogram buckets of all of the observed data and clear the
+   * measurements, so that the statistics and the buckets of a published window cover the same
+   * measurements, e.g. to publish the distribution with AppendHistogramDataPoints. Without a
+   * histogram, see IsHistogramEnabled, this is GetStatisticsAndReset. Otherwise the window is moved
+   * out of the histogram without losing any measurement made concurrently, at the cost of
+   * allocating a histogram of the same options per call.
+   *
+   * @param buckets set to the non-empty buckets of the observed measurements before they were
+   * cleared, or cleared if the collector has no histogram
+   * @return the StatisticData for all the observed measurements before they were cleared
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual moving_average_statistics::StatisticData GetStatisticsAndHistogramAndReset(
+    std::vector<moving_average_statistics::HistogramBucket> & buckets);
+
+  /**
+   * Return true if the measurements are accumulated with a
+   * moving_average_statistics::LogLinearHistogram, see the accumulator constructor.
+   *
+   * @return whether the buckets of the measurements are available
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool IsHistogramEnabled() const;
+
+  /**
+   * Return quantile estimates for all of the observed data, see EnableQuantileEstimation.
+   *
+   * @return the QuantileData for all the observed measurements, all NaN if quantile estimation
+   * is not enabled or no measurements were observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual moving_average_statistics::QuantileData GetQuantileResults() const;
+
+  /**
+   * Additionally estimate quantiles of the observed data with a
+   * moving_average_statistics::QuantileSketch. Quantile estimation is disabled by default because
+   * the sketch's buckets use much more memory than the moving average. Not thread safe: must be
+   * called before the collector accepts any data, e.g. right after construction.
+   *
+   * @param options configuration of the quantile sketch
+   * @throws std::invalid_argument if any of the options are out of range
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void EnableQuantileEstimation(
+    const moving_average_statistics::QuantileSketch::Options & options =
+    moving_average_statistics::QuantileSketch::Options{});
+
+  /**
+   * Return true if EnableQuantileEstimation has been called.
+   *
+   * @return whether quantiles are estimated
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool IsQuantileEstimationEnabled() const;
+
   /**
    * Clear / reset all current measurements.
    */
@@ -67,7 +218,7 @@ public:
   virtual void ClearCurrentMeasurements();
 
   /**
-   * Return true is start has been called, false otherwise.
+   * Return true is start has been called, false otherwise. This does not take a lock.
    *
    * @return the started state of this collector
    */
@@ -82,10 +233,35 @@ public:
   LIBSTATISTICS_COLLECTOR_PUBLIC
   virtual std::string GetStatusString() const;
 
+  /// The longest string FormatStatusString can produce
+  static constexpr size_t kStatusStringMaxLength =
+    sizeof("started=false, ") - 1 + moving_average_statistics::kStatisticsDataStringMaxLength;
+
+  /**
+   * Print the default status representation of GetStatusString into a caller provided buffer,
+   * without allocating. The result is not null terminated.
+   *
+   * @param buffer the buffer to print into
+   * @param buffer_size size of buffer, at least kStatusStringMaxLength to never truncate
+   * @return the printed status within buffer, or an empty view if buffer is too small
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::string_view FormatStatusString(char * buffer, size_t buffer_size) const;
+
+  /**
+   * Return the overhead of this collector since its construction, all 0 unless
+   * kInstrumentationEnabled, e.g. to only enable expensive collectors where it is acceptable or to
+   * publish it with GenerateInstrumentationMessage. This does not take a lock.
+   *
+   * @return the instrumentation counters of this collector and of its accumulator
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  InstrumentationData GetInstrumentationData() const;
+
   // TODO(dabonnie): uptime (once start has been called)
 
   /**
-   * Start collecting data. Meant to be called after construction. Note: this locks the recursive mutex class
+   * Start collecting data. Meant to be called after construction. Note: this locks the mutex class
    * member 'mutex'. This method is public in order for the caller to manually manage starting and
    * stopping this collector.
    *
@@ -106,6 +282,40 @@ public:
   LIBSTATISTICS_COLLECTOR_PUBLIC
   virtual bool Stop();
 
+protected:
+  /**
+   * Add an observed duration in nanoseconds, e.g. a message age or period. This is equivalent to
+   * AcceptData with the duration in milliseconds, except that a
+   * moving_average_statistics::ExactDurationStatistics accumulator, see the accumulator
+   * constructor, aggregates the integer duration without converting it.
+   *
+   * @param duration_nanoseconds the duration observed
+   */
+  void AcceptNanoseconds(const int64_t duration_nanoseconds)
+  {
+    const double duration_milliseconds = std::chrono::duration<double, std::milli>(
+      std::chrono::nanoseconds{duration_nanoseconds}).count();
+    if (!exact_accumulator_) {
+      Collector::AcceptData(duration_milliseconds);
+      return;
+    }
+    const auto timer = instrumentation_.TimeAcceptData();
+    exact_accumulator_->AddDuration(duration_nanoseconds);
+    if (quantile_sketch_) {
+      quantile_sketch_->AddMeasurement(duration_milliseconds);
+    }
+  }
+
+  /**
+   * Return the instrumentation counters, for derived classes to count their own overhead.
+   *
+   * @return the instrumentation counters of this collector
+   */
+  InstrumentationCounters & GetInstrumentationCounters()
+  {
+    return instrumentation_;
+  }
+
 private:
   /**
    * Override in order to perform necessary starting steps.
@@ -121,11 +331,37 @@ private:
    */
   virtual bool SetupStop() RCPPUTILS_TSA_REQUIRES(mutex_) = 0;
 
-  mutable std::mutex mutex_;
+  // Only the members written per measurement get cache lines of their own: the vtable pointer,
+  // accumulator_, quantile_sketch_ and started_ share the first one, as they are only read by the
+  // measuring threads, and mutex_ follows the instrumentation counters, as it is only used by
+  // Start and Stop.
+
+  /// Optional accumulator used instead of collected_data_, see the accumulator constructor
+  std::unique_ptr<moving_average_statistics::AccumulatorInterface> accumulator_;
+
+  /// accumulator_ if it is an ExactDurationStatistics, fed by AcceptNanoseconds
+  moving_average_statistics::ExactDurationStatistics * exact_accumulator_ = nullptr;
+
+  /// accumulator_ if it is a LogLinearHistogram, see GetStatisticsAndHistogramAndReset
+  moving_average_statistics::LogLinearHistogram * histogram_accumulator_ = nullptr;
 
+  /// Optional quantile estimator, only allocated by EnableQuantileEstimation
+  std::unique_ptr<moving_average_statistics::QuantileSketch> quantile_sketch_;
+
+  /// Only modified while holding mutex_, but read without it by IsStarted
+  std::atomic<bool> started_{false};
+
+  /// Accumulates the measurements unless accumulator_ is set
+  alignas(moving_average_statistics::kCacheLineSize)
   moving_average_statistics::MovingAverageStatistics collected_data_;
 
-  bool started_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = false;
+  /// Empty unless kInstrumentationEnabled, and then on its own cache line as it is written per
+  /// measurement
+  alignas(kInstrumentationEnabled ? moving_average_statistics::kCacheLineSize :
+    alignof(InstrumentationCounters)) InstrumentationCounters instrumentation_;
+
+  /// Serializes Start and Stop
+  mutable std::mutex mutex_;
 };
 
 }  // namespace collector
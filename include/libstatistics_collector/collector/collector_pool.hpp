@@ -0,0 +1,331 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_POOL_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * A handle to a collector of a CollectorPool. A handle stays safe to use after its collector is
+ * destroyed: CollectorPool::Get then returns null, even if the slot was reused by another
+ * collector.
+ */
+struct CollectorHandle
+{
+  /// index of an invalid handle
+  static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  /// index of the slot of the collector in the pool
+  uint32_t index = kInvalidIndex;
+  /// generation of the slot when the collector was created, always odd
+  uint32_t generation = 0;
+
+  /**
+   * @return false if the handle was default constructed or returned by a failed Create
+   */
+  bool IsValid() const
+  {
+    return index != kInvalidIndex;
+  }
+
+  bool operator==(const CollectorHandle & other) const
+  {
+    return index == other.index && generation == other.generation;
+  }
+
+  bool operator!=(const CollectorHandle & other) const
+  {
+    return !(*this == other);
+  }
+};
+
+/**
+ * Constructs collectors of type CollectorT in place, in slabs of contiguous slots, for fleets of
+ * collectors created and destroyed as topics come and go. A slab is allocated when all slots are
+ * taken and is only released with the pool, so that creating and destroying collectors does not
+ * fragment the heap: a destroyed collector's slot goes on a free list and Create reuses it in
+ * O(1). Collectors are addressed by CollectorHandle instead of pointers.
+ *
+ * Slots are exactly sizeof(CollectorT) apart: each collector starts on its own cache line, as all
+ * collectors are cache line aligned. The generation counters and free list of a slab are kept
+ * apart from its collectors.
+ *
+ * Create, Destroy and ForEach are thread safe and serialized by a mutex. Get does not take a lock,
+ * but must not race with the Destroy of the same handle. CollectorT is not required to be a
+ * collector.
+ *
+ * @tparam CollectorT the type of the collectors, e.g. FinalReceivedMessageAgeCollector<T>
+ */
+template<typename CollectorT>
+class CollectorPool
+{
+public:
+  /// Default number of collectors per slab
+  static constexpr size_t kDefaultSlabSize = 64;
+  /// Default maximum number of slabs
+  static constexpr size_t kDefaultMaxSlabCount = 1024;
+
+  /**
+   * Construct an empty pool. No slab is allocated until the first Create.
+   *
+   * @param slab_size the number of collectors per slab
+   * @param max_slab_count the maximum number of slabs, bounding the number of collectors
+   * @throws std::invalid_argument if slab_size or max_slab_count is 0, or if the maximum number of
+   * collectors does not fit a CollectorHandle
+   */
+  explicit CollectorPool(
+    const size_t slab_size = kDefaultSlabSize, const size_t max_slab_count = kDefaultMaxSlabCount)
+  : slab_size_{slab_size}, max_slab_count_{max_slab_count}
+  {
+    if (slab_size == 0 || max_slab_count == 0) {
+      throw std::invalid_argument("slab_size and max_slab_count must be positive");
+    }
+    if (slab_size > CollectorHandle::kInvalidIndex / max_slab_count) {
+      throw std::invalid_argument("slab_size * max_slab_count must fit a CollectorHandle");
+    }
+    slabs_ = std::make_unique<std::atomic<Slab *>[]>(max_slab_count);
+  }
+
+  CollectorPool(const CollectorPool &) = delete;
+  CollectorPool & operator=(const CollectorPool &) = delete;
+
+  /**
+   * Destroy the remaining collectors and release the slabs.
+   */
+  ~CollectorPool()
+  {
+    for (size_t i = 0; i < slab_count_; i++) {
+      Slab * slab = slabs_[i].load(std::memory_order_relaxed);
+      for (size_t j = 0; j < slab_size_; j++) {
+        if (IsLive(slab->generations[j].load(std::memory_order_relaxed))) {
+          slab->GetCollector(j)->~CollectorT();
+        }
+      }
+      delete slab;
+    }
+  }
+
+  /**
+   * Construct a collector in a free slot, allocating a slab if there is none.
+   *
+   * @param args the arguments of the constructor of CollectorT
+   * @return the handle of the collector, invalid if the pool holds its maximum number of
+   * collectors
+   * @throws whatever the constructor of CollectorT or the allocation of a slab throws, leaving the
+   * slot free
+   */
+  template<typename ... Args>
+  CollectorHandle Create(Args && ... args)
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    uint32_t index;
+    const bool recycled = free_head_ != CollectorHandle::kInvalidIndex;
+    if (recycled) {
+      index = free_head_;
+    } else if (slot_count_ < slab_count_ * slab_size_) {
+      index = static_cast<uint32_t>(slot_count_);
+    } else if (slab_count_ < max_slab_count_) {
+      slabs_[slab_count_].store(new Slab{slab_size_}, std::memory_order_release);
+      slab_count_++;
+      index = static_cast<uint32_t>(slot_count_);
+    } else {
+      return CollectorHandle{};
+    }
+
+    Slab & slab = GetSlab(index);
+    const size_t offset = index % slab_size_;
+    new (slab.GetCollector(offset)) CollectorT(std::forward<Args>(args)...);
+    if (recycled) {
+      free_head_ = slab.next_free[offset];
+    } else {
+      slot_count_++;
+    }
+    const uint32_t generation = slab.generations[offset].load(std::memory_order_relaxed) + 1;
+    slab.generations[offset].store(generation, std::memory_order_release);
+    size_++;
+    return CollectorHandle{index, generation};
+  }
+
+  /**
+   * Destroy a collector and recycle its slot.
+   *
+   * @param handle the handle of the collector
+   * @return false if the handle is invalid or its collector was already destroyed
+   */
+  bool Destroy(const CollectorHandle & handle)
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    CollectorT * collector = Get(handle);
+    if (collector == nullptr) {
+      return false;
+    }
+    Slab & slab = GetSlab(handle.index);
+    const size_t offset = handle.index % slab_size_;
+    slab.generations[offset].store(handle.generation + 1, std::memory_order_release);
+    collector->~CollectorT();
+    slab.next_free[offset] = free_head_;
+    free_head_ = handle.index;
+    size_--;
+    return true;
+  }
+
+  /**
+   * Return the collector of a handle, in O(1) and without taking a lock.
+   *
+   * @param handle the handle of the collector
+   * @return the collector, or null if the handle is invalid or its collector was destroyed
+   */
+  CollectorT * Get(const CollectorHandle & handle) const
+  {
+    const size_t slab_index = handle.index / slab_size_;
+    if (!handle.IsValid() || slab_index >= max_slab_count_) {
+      return nullptr;
+    }
+    Slab * slab = slabs_[slab_index].load(std::memory_order_acquire);
+    if (slab == nullptr) {
+      return nullptr;
+    }
+    const size_t offset = handle.index % slab_size_;
+    if (slab->generations[offset].load(std::memory_order_acquire) != handle.generation ||
+      !IsLive(handle.generation))
+    {
+      return nullptr;
+    }
+    return slab->GetCollector(offset);
+  }
+
+  /**
+   * Call a function with every collector of the pool, in slot order. Create and Destroy must not
+   * be called from the function.
+   *
+   * @param function called with a CollectorT & and its CollectorHandle
+   */
+  template<typename FunctionT>
+  void ForEach(const FunctionT & function)
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    for (size_t i = 0; i < slab_count_; i++) {
+      Slab * slab = slabs_[i].load(std::memory_order_relaxed);
+      for (size_t j = 0; j < slab_size_; j++) {
+        const uint32_t generation = slab->generations[j].load(std::memory_order_relaxed);
+        if (IsLive(generation)) {
+          function(
+            *slab->GetCollector(j),
+            CollectorHandle{static_cast<uint32_t>(i * slab_size_ + j), generation});
+        }
+      }
+    }
+  }
+
+  /**
+   * @return the number of collectors in the pool
+   */
+  size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return size_;
+  }
+
+  /**
+   * @return the number of collectors the allocated slabs can hold
+   */
+  size_t GetCapacity() const
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return slab_count_ * slab_size_;
+  }
+
+  /**
+   * @return the number of allocated slabs
+   */
+  size_t GetSlabCount() const
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    return slab_count_;
+  }
+
+private:
+  /**
+   * Uninitialized storage of a collector, of the size and alignment of CollectorT.
+   */
+  struct Storage
+  {
+    alignas(CollectorT) unsigned char bytes[sizeof(CollectorT)];
+  };
+
+  /**
+   * The storage of slab_size_ collectors, and the generation and free list link of each slot.
+   */
+  struct Slab
+  {
+    explicit Slab(const size_t slab_size)
+    : storage{std::make_unique<Storage[]>(slab_size)},
+      generations{std::make_unique<std::atomic<uint32_t>[]>(slab_size)},
+      next_free{std::make_unique<uint32_t[]>(slab_size)}
+    {
+    }
+
+    CollectorT * GetCollector(const size_t offset) const
+    {
+      return std::launder(reinterpret_cast<CollectorT *>(storage[offset].bytes));
+    }
+
+    std::unique_ptr<Storage[]> storage;
+    /// Incremented when a collector is created and destroyed: odd while the slot holds one
+    std::unique_ptr<std::atomic<uint32_t>[]> generations;
+    /// Index of the next free slot, only meaningful while the slot is free
+    std::unique_ptr<uint32_t[]> next_free;
+  };
+
+  static bool IsLive(const uint32_t generation)
+  {
+    return (generation & 1u) != 0;
+  }
+
+  Slab & GetSlab(const uint32_t index) const
+  {
+    return *slabs_[index / slab_size_].load(std::memory_order_relaxed);
+  }
+
+  const size_t slab_size_;
+  const size_t max_slab_count_;
+  /// max_slab_count_ slab pointers, published with a release store so that Get does not lock
+  std::unique_ptr<std::atomic<Slab *>[]> slabs_;
+
+  mutable std::mutex mutex_;
+  size_t slab_count_ = 0;
+  /// Number of slots ever used, the slots above are free but not on the free list
+  size_t slot_count_ = 0;
+  size_t size_ = 0;
+  uint32_t free_head_ = CollectorHandle::kInvalidIndex;
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_POOL_HPP_
@@ -0,0 +1,172 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_REGISTRY_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_REGISTRY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "collector.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * Holds many collectors of one node and generates the MetricsMessages of all of them in a single
+ * pass, so that a process with thousands of collectors does not poll and publish them one by one.
+ *
+ * The registry keeps one shared pointer, window start time, and reused MetricsMessage per
+ * collector in parallel vectors. The collectors themselves stay wherever they were allocated, so a
+ * sweep still dereferences one pointer per collector. GenerateStatisticMessages sweeps them in
+ * order, takes every collector's statistics with Collector::GetStatisticsAndReset, and ends all
+ * windows at the same time stamp. The messages are refilled in place with
+ * UpdateStatisticMessage, so that a sweep does not allocate once every message has been generated,
+ * except for collectors accumulating with a moving_average_statistics::LogLinearHistogram: their
+ * buckets are taken with Collector::GetStatisticsAndHistogramAndReset and appended to their
+ * messages with AppendHistogramDataPoints.
+ *
+ * The sweep resets the collectors from its own thread while they keep accepting data. That is safe
+ * in every moving_average_statistics::WriterMode, including WriterMode::kSingleWriter whose reset
+ * may overlap with the writing thread, and for the accumulators of this package, which all
+ * synchronize their resets. A custom accumulator must do the same to be registered.
+ *
+ * Register and Unregister may be called from any thread, including concurrently with a sweep:
+ * they only queue the change under a short lock and never wait for a sweep to finish. The queued
+ * changes are applied at the start of the next sweep. The registry shares ownership of the
+ * collectors, so an unregistered collector stays valid until the sweep that removes it.
+ */
+class CollectorRegistry
+{
+public:
+  /// Identifies a registered collector
+  using Handle = uint64_t;
+
+  /**
+   * Construct an empty registry.
+   *
+   * @param node_name the measurement source name of all generated messages
+   * @param window_start start time of the first window of the collectors registered before the
+   * first sweep, typically the current time of the clock the windows are stamped with
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  CollectorRegistry(
+    const std::string & node_name,
+    const builtin_interfaces::msg::Time window_start);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~CollectorRegistry() = default;
+
+  /**
+   * Add a collector to the next sweeps. Its first window starts at the end of the previous sweep,
+   * or at the window start passed to the constructor if there was none.
+   * Thread safe and does not wait for a sweep in progress.
+   *
+   * @param collector the collector to add
+   * @return the handle to unregister the collector with
+   * @throws std::invalid_argument if collector is null
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  Handle Register(std::shared_ptr<Collector> collector);
+
+  /**
+   * Remove a collector from the next sweeps. Unknown or already unregistered handles are ignored.
+   * Thread safe and does not wait for a sweep in progress.
+   *
+   * @param handle the handle returned by Register
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Unregister(const Handle handle);
+
+  /**
+   * Take and reset the statistics of all registered collectors and return one MetricsMessage per
+   * collector, in registration order except that unregistering moves the last collector into the
+   * freed place. All windows end at window_stop and the next ones start there. Sweeps are
+   * serialized with each other.
+   *
+   * @param window_stop measurement window end time of all messages
+   * @return the generated messages, valid until the next call
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  const std::vector<statistics_msgs::msg::MetricsMessage> & GenerateStatisticMessages(
+    const builtin_interfaces::msg::Time window_stop);
+
+  /**
+   * Return the number of collectors included in the last sweep.
+   *
+   * @return the number of collectors
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetCollectorCount() const;
+
+private:
+  /**
+   * A queued Register or Unregister call, applied by the next sweep.
+   */
+  struct PendingChange
+  {
+    Handle handle;
+    /// the collector to add, null to remove handle
+    std::shared_ptr<Collector> collector;
+  };
+
+  /**
+   * Apply the queued Register and Unregister calls to the parallel vectors.
+   */
+  void ApplyPendingChanges() RCPPUTILS_TSA_REQUIRES(sweep_mutex_);
+
+  void Add(const Handle handle, std::shared_ptr<Collector> collector)
+  RCPPUTILS_TSA_REQUIRES(sweep_mutex_);
+
+  void Remove(const Handle handle) RCPPUTILS_TSA_REQUIRES(sweep_mutex_);
+
+  const std::string node_name_;
+
+  /// Guards the queued changes only, never held during a sweep
+  mutable std::mutex pending_mutex_;
+  std::vector<PendingChange> pending_changes_ RCPPUTILS_TSA_GUARDED_BY(pending_mutex_);
+  Handle next_handle_ RCPPUTILS_TSA_GUARDED_BY(pending_mutex_) = 0;
+
+  /// Serializes sweeps
+  mutable std::mutex sweep_mutex_;
+  // Parallel vectors, one element per registered collector.
+  std::vector<std::shared_ptr<Collector>> collectors_ RCPPUTILS_TSA_GUARDED_BY(sweep_mutex_);
+  std::vector<Handle> handles_ RCPPUTILS_TSA_GUARDED_BY(sweep_mutex_);
+  std::vector<builtin_interfaces::msg::Time> window_starts_ RCPPUTILS_TSA_GUARDED_BY(sweep_mutex_);
+  std::vector<statistics_msgs::msg::MetricsMessage> messages_
+  RCPPUTILS_TSA_GUARDED_BY(sweep_mutex_);
+  /// Position of each registered handle in the parallel vectors
+  std::unordered_map<Handle, size_t> indices_ RCPPUTILS_TSA_GUARDED_BY(sweep_mutex_);
+  /// End of the previous sweep, or the start of the first window before the first sweep
+  builtin_interfaces::msg::Time last_window_stop_ RCPPUTILS_TSA_GUARDED_BY(sweep_mutex_);
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__COLLECTOR_REGISTRY_HPP_
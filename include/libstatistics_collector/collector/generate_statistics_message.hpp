@@ -15,12 +15,16 @@
 #ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__GENERATE_STATISTICS_MESSAGE_HPP_
 #define LIBSTATISTICS_COLLECTOR__COLLECTOR__GENERATE_STATISTICS_MESSAGE_HPP_
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "builtin_interfaces/msg/time.hpp"
 #include "statistics_msgs/msg/metrics_message.hpp"
 
+#include "libstatistics_collector/instrumentation.hpp"
 #include "libstatistics_collector/visibility_control.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
 #include "libstatistics_collector/moving_average_statistics/types.hpp"
 
 namespace libstatistics_collector
@@ -28,6 +32,46 @@ namespace libstatistics_collector
 namespace collector
 {
 
+/**
+ * StatisticDataPoint data_type values for the quantile estimates of QuantileData.
+ * statistics_msgs/StatisticDataType only defines the types up to STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+ * these values extend it and have the high bit set to stay clear of any future upstream types.
+ */
+constexpr const uint8_t kStatisticsDataTypeP50 = 128;
+constexpr const uint8_t kStatisticsDataTypeP90 = 129;
+constexpr const uint8_t kStatisticsDataTypeP99 = 130;
+constexpr const uint8_t kStatisticsDataTypeP999 = 131;
+
+/**
+ * StatisticDataPoint data_type value for StatisticData::sample_rate, which is only added to a
+ * message if it is below 1, i.e. if the measurements were sampled.
+ */
+constexpr const uint8_t kStatisticsDataTypeSampleRate = 132;
+
+/**
+ * StatisticDataPoint data_type values for the buckets of a histogram, see
+ * AppendHistogramDataPoints.
+ */
+constexpr const uint8_t kStatisticsDataTypeHistogramLowerBound = 133;
+constexpr const uint8_t kStatisticsDataTypeHistogramUpperBound = 134;
+constexpr const uint8_t kStatisticsDataTypeHistogramCount = 135;
+
+/**
+ * StatisticDataPoint data_type values of the counters of an InstrumentationData, see
+ * GenerateInstrumentationMessage.
+ */
+constexpr const uint8_t kStatisticsDataTypeAcceptDataCount = 136;
+constexpr const uint8_t kStatisticsDataTypeAcceptDataNanoseconds = 137;
+constexpr const uint8_t kStatisticsDataTypeMessageCount = 138;
+constexpr const uint8_t kStatisticsDataTypeMessageNanoseconds = 139;
+constexpr const uint8_t kStatisticsDataTypeLockContentionCount = 140;
+constexpr const uint8_t kStatisticsDataTypeDroppedSampleCount = 141;
+
+/// Appended to the metric name of a collector for the metrics source of its instrumentation
+constexpr const char kInstrumentationMetricSuffix[] = "_instrumentation";
+/// Unit of the instrumentation messages, whose data points are counts and nanoseconds
+constexpr const char kInstrumentationMetricUnit[] = "count_and_ns";
+
 /**
  * Return a valid MetricsMessage ready to be published to a ROS topic
  *
@@ -49,6 +93,109 @@ statistics_msgs::msg::MetricsMessage GenerateStatisticMessage(
   const libstatistics_collector::moving_average_statistics::StatisticData & data
 );
 
+/**
+ * Return a valid MetricsMessage ready to be published to a ROS topic, containing the quantile
+ * estimates as additional data points with the kStatisticsDataTypeP* data types.
+ *
+ * @param node_name the name of the node that the data originates from
+ * @param metric_name the name of the metric ("cpu_usage", "memory_usage", etc.)
+ * @param unit name of the unit ("percentage", "mb", etc.)
+ * @param window_start measurement window start time
+ * @param window_stop measurement window end time
+ * @param data statistics derived from the measurements made in the window
+ * @param quantiles quantile estimates of the measurements made in the window
+ * @return a MetricsMessage containing the statistics in the data and quantiles parameters
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+statistics_msgs::msg::MetricsMessage GenerateStatisticMessage(
+  const std::string & node_name,
+  const std::string & metric_name,
+  const std::string & unit,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data,
+  const libstatistics_collector::moving_average_statistics::QuantileData & quantiles
+);
+
+/**
+ * Update a MetricsMessage in place with the statistics of a new window, e.g. one previously
+ * returned by GenerateStatisticMessage and kept by the caller for publishing. Only the window
+ * stamps and the statistic data points are written: the strings are left unchanged and the data
+ * points reuse the existing vector capacity, so that once the message holds the data points of a
+ * window no memory is allocated.
+ *
+ * @param msg the message to update
+ * @param window_start measurement window start time
+ * @param window_stop measurement window end time
+ * @param data statistics derived from the measurements made in the window
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+void UpdateStatisticMessage(
+  statistics_msgs::msg::MetricsMessage & msg,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data
+);
+
+/**
+ * Update a MetricsMessage in place with the statistics and quantile estimates of a new window,
+ * see UpdateStatisticMessage above.
+ *
+ * @param msg the message to update
+ * @param window_start measurement window start time
+ * @param window_stop measurement window end time
+ * @param data statistics derived from the measurements made in the window
+ * @param quantiles quantile estimates of the measurements made in the window
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+void UpdateStatisticMessage(
+  statistics_msgs::msg::MetricsMessage & msg,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data,
+  const libstatistics_collector::moving_average_statistics::QuantileData & quantiles
+);
+
+/**
+ * Append the buckets of a histogram to a MetricsMessage, e.g. after GenerateStatisticMessage or
+ * UpdateStatisticMessage with the statistics of the same window. Each bucket is appended as three
+ * data points, of the kStatisticsDataTypeHistogramLowerBound,
+ * kStatisticsDataTypeHistogramUpperBound and kStatisticsDataTypeHistogramCount data types, in this
+ * order.
+ *
+ * @param msg the message to append to
+ * @param buckets the buckets, e.g. the non-empty buckets of a
+ * moving_average_statistics::LogLinearHistogram
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+void AppendHistogramDataPoints(
+  statistics_msgs::msg::MetricsMessage & msg,
+  const std::vector<libstatistics_collector::moving_average_statistics::HistogramBucket> & buckets
+);
+
+/**
+ * Return a MetricsMessage reporting the overhead of a collector, e.g. from
+ * Collector::GetInstrumentationData, with one data point per counter of the
+ * kStatisticsDataTypeAcceptDataCount to kStatisticsDataTypeDroppedSampleCount data types. The
+ * counters are cumulative since the construction of the collector.
+ *
+ * @param node_name the name of the node that the collector belongs to
+ * @param metric_name the name of the metric of the collector, kInstrumentationMetricSuffix is
+ * appended to it
+ * @param window_start measurement window start time
+ * @param window_stop measurement window end time
+ * @param data the instrumentation counters of the collector
+ * @return a MetricsMessage containing the counters
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+statistics_msgs::msg::MetricsMessage GenerateInstrumentationMessage(
+  const std::string & node_name,
+  const std::string & metric_name,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::InstrumentationData & data
+);
+
 }  // namespace collector
 }  // namespace libstatistics_collector
 
@@ -16,6 +16,7 @@
 #define LIBSTATISTICS_COLLECTOR__COLLECTOR__METRIC_DETAILS_INTERFACE_HPP_
 
 #include <string>
+#include <string_view>
 
 #include "libstatistics_collector/visibility_control.hpp"
 
@@ -46,6 +47,28 @@ public:
    * @return a string representing the metric unit
    */
   virtual std::string GetMetricUnit() const = 0;
+
+  /**
+   * Return a single metric's name without allocating. Implementations whose name outlives them,
+   * e.g. a string literal, should override this. The default returns an empty view, meaning that
+   * the name is only available from GetMetricName.
+   *
+   * @return a view of the metric name, or an empty view
+   */
+  virtual std::string_view GetMetricNameView() const
+  {
+    return {};
+  }
+
+  /**
+   * Return a single metric's measurement unit without allocating, see GetMetricNameView.
+   *
+   * @return a view of the metric unit, or an empty view
+   */
+  virtual std::string_view GetMetricUnitView() const
+  {
+    return {};
+  }
 };
 
 }  // namespace collector
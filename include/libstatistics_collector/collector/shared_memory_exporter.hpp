@@ -0,0 +1,288 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__SHARED_MEMORY_EXPORTER_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__SHARED_MEMORY_EXPORTER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "collector.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * The layout of the shared memory region written by SharedMemoryExporter, for readers in other
+ * processes. The region is a RegionHeader followed by RegionHeader::capacity MetricSlots. All
+ * integers and doubles are in the native byte order of the writing host.
+ */
+namespace shared_memory_layout
+{
+
+/// RegionHeader::magic, "LSCSTATS" in ASCII
+constexpr const uint64_t kMagic = 0x535441545343534cull;
+/// RegionHeader::version, incremented on any change of the layout
+constexpr const uint32_t kVersion = 1;
+/// Sizes of the strings, including the terminating null character
+constexpr const size_t kNodeNameSize = 128;
+constexpr const size_t kMetricNameSize = 96;
+constexpr const size_t kMetricUnitSize = 32;
+
+/// MetricSlot::state values
+constexpr const uint32_t kSlotActive = 1;
+constexpr const uint32_t kSlotRetired = 2;
+
+/**
+ * The header of the region, written once when the region is created.
+ */
+struct alignas(64) RegionHeader
+{
+  uint64_t magic;
+  uint32_t version;
+  /// number of metric slots in the region
+  uint32_t capacity;
+  /// sizeof(MetricSlot), to check the layout
+  uint32_t slot_size;
+  uint32_t reserved;
+  /// number of slots in use, stored with release semantics after a slot's names are written
+  std::atomic<uint64_t> metric_count;
+  /// measurement source name of all metrics, null terminated
+  char node_name[kNodeNameSize];
+};
+
+/**
+ * A metric: its name and unit, written once before it is counted in RegionHeader::metric_count,
+ * and its latest statistics, protected by a sequence lock. A reader loads sequence with acquire
+ * semantics, and retries if it is odd or has changed after reading the statistics.
+ */
+struct alignas(64) MetricSlot
+{
+  /// metric name, null terminated
+  char name[kMetricNameSize];
+  /// metric unit, null terminated
+  char unit[kMetricUnitSize];
+  /// kSlotActive, or kSlotRetired once the collector is unregistered
+  std::atomic<uint32_t> state;
+  /// seqlock sequence number, odd while the statistics are written
+  std::atomic<uint64_t> sequence;
+  /// time of the last update, as passed to SharedMemoryExporter::Update
+  std::atomic<int64_t> update_time;
+  std::atomic<uint64_t> sample_count;
+  std::atomic<double> average;
+  std::atomic<double> min;
+  std::atomic<double> max;
+  std::atomic<double> standard_deviation;
+  std::atomic<double> sample_rate;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be lock free");
+static_assert(std::atomic<double>::is_always_lock_free, "shared atomics must be lock free");
+
+}  // namespace shared_memory_layout
+
+/**
+ * Exports the statistics of many collectors to a POSIX shared memory region, so that an agent in
+ * another process can read every metric directly from memory, without any message being generated,
+ * serialized, or published by the monitored process. See shared_memory_layout for the layout and
+ * SharedMemoryReader for a reader.
+ *
+ * Registering a collector writes its name and unit, from MetricDetailsInterface, once into a new
+ * slot. Update then writes the current statistics of every registered collector into its slot
+ * under the slot's sequence lock. Windows are left to the owner of the collectors, e.g. a
+ * CollectorRegistry. This class is thread safe; all members take a mutex.
+ */
+class SharedMemoryExporter
+{
+public:
+  /**
+   * Create the shared memory region, replacing any region of the same name. The region is removed
+   * by the destructor.
+   *
+   * @param region_name the POSIX shared memory object name, e.g. "/my_node_statistics"
+   * @param node_name the measurement source name of all metrics
+   * @param capacity the maximum number of collectors
+   * @throws std::invalid_argument if the name is invalid, the node name too long, or capacity 0
+   * @throws std::runtime_error if the region cannot be created, always on Windows
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  SharedMemoryExporter(
+    const std::string & region_name, const std::string & node_name, size_t capacity);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~SharedMemoryExporter();
+
+  SharedMemoryExporter(const SharedMemoryExporter &) = delete;
+  SharedMemoryExporter & operator=(const SharedMemoryExporter &) = delete;
+
+  /**
+   * Add a collector in a new slot. Names and units longer than the slot's are truncated.
+   *
+   * @param collector the collector to export
+   * @return the index of the collector's slot
+   * @throws std::invalid_argument if collector is null
+   * @throws std::length_error if the region is full
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t Register(std::shared_ptr<Collector> collector);
+
+  /**
+   * Stop exporting a collector. Its slot is marked retired and keeps its last statistics; slots
+   * are not reused.
+   *
+   * @param index the index returned by Register
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Unregister(size_t index);
+
+  /**
+   * Write the current statistics of all registered collectors, see
+   * Collector::GetStatisticsResults.
+   *
+   * @param update_time the time of the update, e.g. in nanoseconds, stored with the statistics
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Update(int64_t update_time);
+
+  /**
+   * Return the number of slots in use, including retired ones.
+   *
+   * @return the metric count
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetMetricCount() const;
+
+  /**
+   * Return the name of the shared memory region.
+   *
+   * @return the region name
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  const std::string & GetRegionName() const;
+
+private:
+  const std::string region_name_;
+  const size_t capacity_;
+  size_t region_size_ = 0;
+  void * region_ = nullptr;
+  shared_memory_layout::RegionHeader * header_ = nullptr;
+  shared_memory_layout::MetricSlot * slots_ = nullptr;
+  mutable std::mutex mutex_;
+  /// Collector of each slot, null once unregistered
+  std::vector<std::shared_ptr<Collector>> collectors_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+};
+
+/**
+ * Reads the statistics exported by a SharedMemoryExporter, e.g. in a monitoring agent. Names and
+ * units are returned without copying, as views into the shared memory.
+ */
+class SharedMemoryReader
+{
+public:
+  /**
+   * Map an existing shared memory region read only.
+   *
+   * @param region_name the name passed to the SharedMemoryExporter
+   * @throws std::runtime_error if the region cannot be opened or has an unknown layout
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit SharedMemoryReader(const std::string & region_name);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~SharedMemoryReader();
+
+  SharedMemoryReader(const SharedMemoryReader &) = delete;
+  SharedMemoryReader & operator=(const SharedMemoryReader &) = delete;
+
+  /**
+   * Return the measurement source name of all metrics.
+   *
+   * @return the node name
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::string_view GetNodeName() const;
+
+  /**
+   * Return the number of metrics currently in the region.
+   *
+   * @return the metric count
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetMetricCount() const;
+
+  /**
+   * Return the name of a metric.
+   *
+   * @param index the metric index, below GetMetricCount
+   * @return the metric name
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::string_view GetMetricName(size_t index) const;
+
+  /**
+   * Return the unit of a metric.
+   *
+   * @param index the metric index, below GetMetricCount
+   * @return the metric unit
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::string_view GetMetricUnit(size_t index) const;
+
+  /**
+   * Return whether the collector of a metric has been unregistered.
+   *
+   * @param index the metric index, below GetMetricCount
+   * @return true if retired
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool IsRetired(size_t index) const;
+
+  /**
+   * Read a consistent snapshot of a metric's latest statistics.
+   *
+   * @param index the metric index, below GetMetricCount
+   * @param statistics the statistics read
+   * @param update_time the time of the update the statistics were written by
+   * @return true if read, false if the index is out of range or no consistent snapshot could be
+   * read, e.g. because the writer died during an update
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool Read(
+    size_t index, moving_average_statistics::StatisticData & statistics,
+    int64_t & update_time) const;
+
+private:
+  size_t region_size_ = 0;
+  const void * region_ = nullptr;
+  const shared_memory_layout::RegionHeader * header_ = nullptr;
+  const shared_memory_layout::MetricSlot * slots_ = nullptr;
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__SHARED_MEMORY_EXPORTER_HPP_
@@ -0,0 +1,300 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__COLLECTOR__STATISTICS_STREAM_HPP_
+#define LIBSTATISTICS_COLLECTOR__COLLECTOR__STATISTICS_STREAM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+#include "libstatistics_collector/visibility_control.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+/**
+ * The format written by StatisticsStreamWriter. A stream is a file header, the 8 bytes "LSCSTRM"
+ * followed by the format version, and a sequence of independently decodable blocks. Each block
+ * starts with a fixed size header holding its size, its number of records and the range of the
+ * window stop times of its records, so that a reader can skip to the blocks of a time range
+ * without decoding the others. The block payload holds the definitions of the metrics first used
+ * in the block, followed by the records stored column by column:
+ *
+ * - metric ids as varints
+ * - window stop times and durations, interleaved, as zigzag varints of the change of the delta
+ *   between window stop times and of the duration since the previous record of the same metric
+ * - sample counts as varints
+ * - average, min, max, standard deviation and sample rate each as a bit stream of the XOR of
+ *   every value with the previous value of the same metric, as in the Gorilla time series
+ *   database, so that unchanged values take a single bit
+ *
+ * All fixed size integers are little endian.
+ */
+namespace statistics_stream_format
+{
+
+/// Version written after the magic, incremented on any change of the format
+constexpr const uint8_t kVersion = 1;
+/// Size of the file header
+constexpr const size_t kFileHeaderSize = 8;
+/// Size of a block header: magic, payload size, record count, definition count and time range
+constexpr const size_t kBlockHeaderSize = 32;
+
+}  // namespace statistics_stream_format
+
+/**
+ * A metric of a statistics stream, identified in the records by its index in the stream.
+ */
+struct LIBSTATISTICS_COLLECTOR_PUBLIC StatisticsStreamMetric
+{
+  /// name of the node that the data originates from
+  std::string node_name;
+  /// name of the metric
+  std::string metric_name;
+  /// name of the unit of the metric
+  std::string metric_unit;
+};
+
+/**
+ * The statistics of one metric over one window.
+ */
+struct LIBSTATISTICS_COLLECTOR_PUBLIC StatisticsStreamRecord
+{
+  /// index of the metric in the stream, see StatisticsStreamWriter::InternMetric
+  uint32_t metric_id = 0;
+  /// measurement window start time in nanoseconds
+  int64_t window_start = 0;
+  /// measurement window end time in nanoseconds
+  int64_t window_stop = 0;
+  /// statistics derived from the measurements made in the window
+  moving_average_statistics::StatisticData statistics;
+};
+
+/**
+ * Writes windows of statistics to a stream in the compact columnar statistics_stream_format,
+ * e.g. for offline analysis instead of recording MetricsMessages. Records are buffered and
+ * written one block at a time. This class is not thread safe.
+ */
+class StatisticsStreamWriter
+{
+public:
+  /// Default number of records per block
+  static constexpr size_t kDefaultRecordsPerBlock = 1024;
+
+  /**
+   * Construct a writer and write the file header to the stream.
+   *
+   * @param stream the stream to write to, opened in binary mode, which must outlive the writer
+   * @param records_per_block number of records buffered before a block is written: larger blocks
+   * compress better while smaller blocks make time range reads more selective
+   * @throws std::invalid_argument if records_per_block is 0
+   * @throws std::runtime_error if writing to the stream fails
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit StatisticsStreamWriter(
+    std::ostream & stream, size_t records_per_block = kDefaultRecordsPerBlock);
+
+  /**
+   * Write the buffered records. Errors are ignored, call Flush() first to handle them.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~StatisticsStreamWriter();
+
+  StatisticsStreamWriter(const StatisticsStreamWriter &) = delete;
+  StatisticsStreamWriter & operator=(const StatisticsStreamWriter &) = delete;
+
+  /**
+   * Return the id of a metric, assigning the next id on the first call for the metric. The
+   * strings of a metric are only written once, in the block of its first record.
+   *
+   * @param node_name the name of the node that the data originates from
+   * @param metric_name the name of the metric
+   * @param metric_unit the name of the unit of the metric
+   * @return the id to pass to Write
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint32_t InternMetric(
+    const std::string & node_name, const std::string & metric_name,
+    const std::string & metric_unit);
+
+  /**
+   * Add the statistics of a window, writing a block once records_per_block records are buffered.
+   *
+   * @param metric_id the id returned by InternMetric
+   * @param window_start measurement window start time in nanoseconds
+   * @param window_stop measurement window end time in nanoseconds
+   * @param statistics statistics derived from the measurements made in the window
+   * @throws std::out_of_range if metric_id was not returned by InternMetric
+   * @throws std::runtime_error if writing to the stream fails
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Write(
+    uint32_t metric_id, int64_t window_start, int64_t window_stop,
+    const moving_average_statistics::StatisticData & statistics);
+
+  /**
+   * Add the statistics of a MetricsMessage, e.g. one generated by GenerateStatisticMessage. Only
+   * the data points of the statistics_msgs/StatisticDataType types and of
+   * kStatisticsDataTypeSampleRate are kept.
+   *
+   * @param msg the message to add
+   * @throws std::runtime_error if writing to the stream fails
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Write(const statistics_msgs::msg::MetricsMessage & msg);
+
+  /**
+   * Write the buffered records as a block and flush the stream.
+   *
+   * @throws std::runtime_error if writing to the stream fails
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Flush();
+
+  /**
+   * @return the number of metrics interned so far
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetMetricCount() const;
+
+private:
+  void WriteBlock();
+
+  std::ostream & stream_;
+  const size_t records_per_block_;
+  std::map<std::tuple<std::string, std::string, std::string>, uint32_t, std::less<>> metric_ids_;
+  std::vector<StatisticsStreamMetric> metrics_;
+  /// number of metrics whose definition was written in a previous block
+  size_t written_metric_count_ = 0;
+  std::vector<StatisticsStreamRecord> records_;
+  /// reused encoding buffer of a block
+  std::vector<uint8_t> block_;
+};
+
+/**
+ * Reads a stream written by StatisticsStreamWriter from a memory mapped file or from memory. The
+ * block headers are indexed on construction, records are only decoded when read. A truncated last
+ * block, e.g. of a file that is still being written, is ignored.
+ */
+class StatisticsStreamReader
+{
+public:
+  /**
+   * Memory map a file and index its blocks.
+   *
+   * @param path the path of the file
+   * @throws std::runtime_error if the file cannot be mapped or is not a valid stream
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit StatisticsStreamReader(const std::string & path);
+
+  /**
+   * Index the blocks of a stream in memory.
+   *
+   * @param data the stream, which must outlive the reader
+   * @param size the size of the stream in bytes
+   * @throws std::runtime_error if the data is not a valid stream
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticsStreamReader(const uint8_t * data, size_t size);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  virtual ~StatisticsStreamReader();
+
+  StatisticsStreamReader(const StatisticsStreamReader &) = delete;
+  StatisticsStreamReader & operator=(const StatisticsStreamReader &) = delete;
+
+  /**
+   * @return the metrics of the stream, indexed by StatisticsStreamRecord::metric_id
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  const std::vector<StatisticsStreamMetric> & GetMetrics() const;
+
+  /**
+   * @return the number of records in the stream
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetRecordCount() const;
+
+  /**
+   * @return the number of blocks in the stream
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetBlockCount() const;
+
+  /**
+   * Decode all records, in the order they were written.
+   *
+   * @return the records
+   * @throws std::runtime_error if a block is corrupted
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::vector<StatisticsStreamRecord> ReadAll() const;
+
+  /**
+   * Decode the records whose window stop time is in [begin, end], only decoding the blocks
+   * overlapping this range.
+   *
+   * @param begin first window stop time in nanoseconds
+   * @param end last window stop time in nanoseconds
+   * @return the records in the range, in the order they were written
+   * @throws std::runtime_error if a block is corrupted
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::vector<StatisticsStreamRecord> ReadRange(int64_t begin, int64_t end) const;
+
+private:
+  /**
+   * Position and time range of a block
+   */
+  struct BlockIndex
+  {
+    /// offset of the first record column
+    size_t columns_offset;
+    /// offset of the end of the block
+    size_t end_offset;
+    uint32_t record_count;
+    int64_t min_window_stop;
+    int64_t max_window_stop;
+  };
+
+  void IndexBlocks();
+  void DecodeBlock(
+    const BlockIndex & block, int64_t begin, int64_t end,
+    std::vector<StatisticsStreamRecord> & records) const;
+
+  const uint8_t * data_ = nullptr;
+  size_t size_ = 0;
+  /// the mapping of the file, null if reading from memory
+  void * mapping_ = nullptr;
+  std::vector<StatisticsStreamMetric> metrics_;
+  std::vector<BlockIndex> blocks_;
+  size_t record_count_ = 0;
+};
+
+}  // namespace collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__COLLECTOR__STATISTICS_STREAM_HPP_
@@ -0,0 +1,239 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__INSTRUMENTATION_HPP_
+#define LIBSTATISTICS_COLLECTOR__INSTRUMENTATION_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+/**
+ * Set to 1, e.g. with the LIBSTATISTICS_COLLECTOR_ENABLE_INSTRUMENTATION CMake option, to count
+ * the overhead of the collectors themselves, see InstrumentationData. The counters are only
+ * stored when it is enabled, so it changes the layout of the collectors and must be the same for
+ * the library and its users; the CMake option exports it.
+ */
+#ifndef LIBSTATISTICS_COLLECTOR_ENABLE_INSTRUMENTATION
+#define LIBSTATISTICS_COLLECTOR_ENABLE_INSTRUMENTATION 0
+#endif
+
+namespace libstatistics_collector
+{
+
+/// Whether the collectors count their own overhead
+constexpr const bool kInstrumentationEnabled = LIBSTATISTICS_COLLECTOR_ENABLE_INSTRUMENTATION != 0;
+
+/**
+ *  The overhead of a collector since its construction, all 0 unless kInstrumentationEnabled.
+ */
+struct LIBSTATISTICS_COLLECTOR_PUBLIC InstrumentationData
+{
+  /// number of calls of collector::Collector::AcceptData
+  uint64_t accept_data_count = 0;
+  /// cumulative time spent in collector::Collector::AcceptData
+  uint64_t accept_data_nanoseconds = 0;
+  /// number of calls of topic_statistics_collector::TopicStatisticsCollector::OnMessageReceived
+  uint64_t message_count = 0;
+  /// cumulative time spent in OnMessageReceived, including its calls of AcceptData
+  uint64_t message_nanoseconds = 0;
+  /// number of times a writer found a lock of the collector or its accumulator taken
+  uint64_t lock_contention_count = 0;
+  /// number of samples dropped for being NaN or otherwise invalid, e.g. a message without stamp
+  uint64_t dropped_sample_count = 0;
+};
+
+/**
+ * Lock a mutex, counting whether it had to wait for another thread if kInstrumentationEnabled.
+ *
+ * @param mutex the mutex to lock
+ * @param contention_count incremented if the mutex was taken
+ * @return the lock of the mutex
+ */
+inline std::unique_lock<std::mutex> LockCountingContention(
+  std::mutex & mutex, std::atomic<uint64_t> & contention_count)
+{
+  if constexpr (kInstrumentationEnabled) {
+    std::unique_lock<std::mutex> lock{mutex, std::try_to_lock};
+    if (!lock.owns_lock()) {
+      contention_count.fetch_add(1, std::memory_order_relaxed);
+      lock.lock();
+    }
+    return lock;
+  } else {
+    (void) contention_count;
+    return std::unique_lock<std::mutex>{mutex};
+  }
+}
+
+/**
+ * Adds the time from its construction to its destruction to a pair of call count and time
+ * counters, see ActiveInstrumentationCounters. Compiles to nothing unless kInstrumentationEnabled.
+ */
+class InstrumentationTimer
+{
+public:
+  InstrumentationTimer(std::atomic<uint64_t> & count, std::atomic<uint64_t> & nanoseconds)
+  : count_{count}, nanoseconds_{nanoseconds}
+  {
+    if constexpr (kInstrumentationEnabled) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~InstrumentationTimer()
+  {
+    if constexpr (kInstrumentationEnabled) {
+      const auto elapsed = std::chrono::steady_clock::now() - start_;
+      count_.fetch_add(1, std::memory_order_relaxed);
+      nanoseconds_.fetch_add(
+        static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+        std::memory_order_relaxed);
+    }
+  }
+
+  InstrumentationTimer(const InstrumentationTimer &) = delete;
+  InstrumentationTimer & operator=(const InstrumentationTimer &) = delete;
+
+private:
+  std::atomic<uint64_t> & count_;
+  std::atomic<uint64_t> & nanoseconds_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ *  The counters of InstrumentationData, updated with relaxed atomics by any thread.
+ */
+class ActiveInstrumentationCounters
+{
+public:
+  /**
+   * @return a timer of the enclosing AcceptData call
+   */
+  InstrumentationTimer TimeAcceptData()
+  {
+    return InstrumentationTimer{accept_data_count_, accept_data_nanoseconds_};
+  }
+
+  /**
+   * @return a timer of the enclosing OnMessageReceived call
+   */
+  InstrumentationTimer TimeMessage()
+  {
+    return InstrumentationTimer{message_count_, message_nanoseconds_};
+  }
+
+  /**
+   * Count dropped samples if kInstrumentationEnabled.
+   *
+   * @param sample_count the number of dropped samples
+   */
+  void CountDroppedSamples(const uint64_t sample_count = 1)
+  {
+    if constexpr (kInstrumentationEnabled) {
+      dropped_sample_count_.fetch_add(sample_count, std::memory_order_relaxed);
+    } else {
+      (void) sample_count;
+    }
+  }
+
+  /**
+   * @return the lock contention counter, see LockCountingContention
+   */
+  std::atomic<uint64_t> & GetLockContentionCounter()
+  {
+    return lock_contention_count_;
+  }
+
+  /**
+   * @return the current values of the counters
+   */
+  InstrumentationData GetData() const
+  {
+    InstrumentationData data;
+    data.accept_data_count = accept_data_count_.load(std::memory_order_relaxed);
+    data.accept_data_nanoseconds = accept_data_nanoseconds_.load(std::memory_order_relaxed);
+    data.message_count = message_count_.load(std::memory_order_relaxed);
+    data.message_nanoseconds = message_nanoseconds_.load(std::memory_order_relaxed);
+    data.lock_contention_count = lock_contention_count_.load(std::memory_order_relaxed);
+    data.dropped_sample_count = dropped_sample_count_.load(std::memory_order_relaxed);
+    return data;
+  }
+
+private:
+  std::atomic<uint64_t> accept_data_count_{0};
+  std::atomic<uint64_t> accept_data_nanoseconds_{0};
+  std::atomic<uint64_t> message_count_{0};
+  std::atomic<uint64_t> message_nanoseconds_{0};
+  std::atomic<uint64_t> lock_contention_count_{0};
+  std::atomic<uint64_t> dropped_sample_count_{0};
+};
+
+/**
+ *  Stands in for ActiveInstrumentationCounters unless kInstrumentationEnabled: an empty class whose
+ *  members do nothing, so that the collectors spend no space on counters they never update.
+ */
+class InactiveInstrumentationCounters
+{
+public:
+  /**
+   * Does nothing, see InstrumentationTimer.
+   */
+  struct Timer
+  {
+    // user provided, so that unused timers are not reported as unused variables
+    ~Timer() {}
+  };
+
+  Timer TimeAcceptData()
+  {
+    return Timer{};
+  }
+
+  Timer TimeMessage()
+  {
+    return Timer{};
+  }
+
+  void CountDroppedSamples(const uint64_t = 1) {}
+
+  /**
+   * @return a counter that is never updated, see LockCountingContention
+   */
+  std::atomic<uint64_t> & GetLockContentionCounter()
+  {
+    return unused_lock_contention_count_;
+  }
+
+  InstrumentationData GetData() const
+  {
+    return InstrumentationData{};
+  }
+
+private:
+  static inline std::atomic<uint64_t> unused_lock_contention_count_{0};
+};
+
+/// The instrumentation counters of a collector, an empty class unless kInstrumentationEnabled
+using InstrumentationCounters = std::conditional_t<kInstrumentationEnabled,
+    ActiveInstrumentationCounters, InactiveInstrumentationCounters>;
+
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__INSTRUMENTATION_HPP_
@@ -0,0 +1,101 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__ACCUMULATOR_INTERFACE_HPP_
+#define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__ACCUMULATOR_INTERFACE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "types.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+/**
+ * Interface for classes that aggregate observations into StatisticData, so that a
+ * collector::Collector can use other aggregation strategies than MovingAverageStatistics.
+ */
+class LIBSTATISTICS_COLLECTOR_PUBLIC AccumulatorInterface
+{
+public:
+  virtual ~AccumulatorInterface() = default;
+
+  /**
+   * Observe a sample. Any input values of NaN must be discarded.
+   *
+   * @param item the item that was observed
+   */
+  virtual void AddMeasurement(const double item) = 0;
+
+  /**
+   * Observe a block of samples. The default implementation adds them one by one.
+   *
+   * @param items pointer to the first observed item
+   * @param item_count number of observed items
+   */
+  virtual void AddMeasurements(const double * items, size_t item_count)
+  {
+    for (size_t i = 0; i < item_count; i++) {
+      AddMeasurement(items[i]);
+    }
+  }
+
+  /**
+   * Return the statistics of the observations.
+   *
+   * @return the StatisticData of the observations
+   */
+  virtual StatisticData GetStatistics() const = 0;
+
+  /**
+   * Discard all observations.
+   */
+  virtual void Reset() = 0;
+
+  /**
+   * Return the statistics of the observations and discard them as one atomic operation, so that
+   * no observation made concurrently is lost between reading and resetting.
+   *
+   * @return the StatisticData of the observations before the reset
+   */
+  virtual StatisticData GetStatisticsAndReset() = 0;
+
+  /**
+   * Return the number of samples the statistics are based on.
+   *
+   * @return the number of samples
+   */
+  virtual uint64_t GetCount() const = 0;
+
+  /**
+   * Return the number of times a writer had to wait for a lock of the accumulator, only counted
+   * if kInstrumentationEnabled. The default implementation returns 0, for lock-free accumulators.
+   *
+   * @return the lock contention count since construction
+   */
+  virtual uint64_t GetLockContentionCount() const
+  {
+    return 0;
+  }
+};
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__ACCUMULATOR_INTERFACE_HPP_
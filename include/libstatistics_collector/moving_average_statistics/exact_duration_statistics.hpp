@@ -0,0 +1,171 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__EXACT_DURATION_STATISTICS_HPP_
+#define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__EXACT_DURATION_STATISTICS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "accumulator_interface.hpp"
+#include "types.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+/**
+ *  A class for calculating the average, minimum, maximum and standard deviation of durations
+ *  observed in integer nanoseconds, without rounding errors accumulating over the observations.
+ *
+ *  Each duration is offset by the first one observed since the last Reset(), and the sum and the
+ *  sum of squares of the offsets are kept in exact 128-bit integers, so an observation costs a few
+ *  integer additions and multiplications and no floating point division. The conversion to
+ *  milliseconds happens only in GetStatistics(), which is exact up to the final rounding to
+ *  double, however many samples were observed. Durations must differ from the first one by less
+ *  than 2^63 nanoseconds, about 292 years.
+ *
+ *  A collector::Collector constructed with this accumulator passes the nanosecond durations of the
+ *  age and period collectors to AddDuration directly. Measurements in milliseconds observed with
+ *  AddMeasurement are rounded to the nearest nanosecond.
+ *
+ *  This class is thread safe and acquires a mutex for each operation.
+ */
+class ExactDurationStatistics : public AccumulatorInterface
+{
+public:
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ExactDurationStatistics() = default;
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ~ExactDurationStatistics() override = default;
+
+  /**
+   *  Observe a duration in nanoseconds.
+   *
+   *  @param duration_nanoseconds the duration that was observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddDuration(const int64_t duration_nanoseconds);
+
+  /**
+   *  Observe a duration in milliseconds, rounded to the nearest nanosecond. Note: any input values
+   *  of NaN will be discarded.
+   *
+   *  @param item the duration that was observed in milliseconds
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurement(const double item) override;
+
+  /**
+   *  Observe a block of durations in milliseconds in order, taking the lock once.
+   *
+   *  @param items pointer to the first observed item
+   *  @param item_count number of observed items
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurements(const double * items, size_t item_count) override;
+
+  /**
+   *  Return the statistics of the observed durations in milliseconds.
+   *
+   *  @return StatisticData of the observations
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatistics() const override;
+
+  /**
+   *  Discard all observations.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Reset() override;
+
+  /**
+   *  Return the statistics of the observed durations in milliseconds and discard all
+   *  observations, holding the lock once.
+   *
+   *  @return StatisticData of the observations before the reset
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatisticsAndReset() override;
+
+  /**
+   *  Return the number of durations observed since construction or the last Reset().
+   *
+   *  @return the number of samples
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetCount() const override;
+
+private:
+  /// A 128-bit two's complement integer, as not all supported compilers provide one
+  struct Int128
+  {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    /**
+     * Add a signed 64-bit integer.
+     */
+    void Add(const int64_t value);
+
+    /**
+     * Add the square of an unsigned 64-bit integer.
+     */
+    void AddSquare(const uint64_t value);
+
+    /**
+     * Return the value rounded to the nearest double.
+     */
+    double ToDouble() const;
+  };
+
+  /**
+   * Accumulate a duration in nanoseconds.
+   */
+  void Update(const int64_t duration_nanoseconds) RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Return the accumulated sums as StatisticData in milliseconds.
+   */
+  StatisticData GetStatisticsUnsynchronized() const RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Discard all observations.
+   */
+  void ResetUnsynchronized() RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  mutable std::mutex mutex_;
+  /// The first duration observed, which all sums are offset by
+  int64_t offset_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+  /// Sum of the durations minus offset_
+  Int128 sum_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  /// Sum of the squares of the durations minus offset_
+  Int128 sum_of_squares_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  int64_t min_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = std::numeric_limits<int64_t>::max();
+  int64_t max_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = std::numeric_limits<int64_t>::min();
+  uint64_t count_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__EXACT_DURATION_STATISTICS_HPP_
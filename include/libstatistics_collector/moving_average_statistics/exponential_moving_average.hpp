@@ -0,0 +1,174 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__EXPONENTIAL_MOVING_AVERAGE_HPP_
+#define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__EXPONENTIAL_MOVING_AVERAGE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "accumulator_interface.hpp"
+#include "types.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+/**
+ *  A class for calculating an exponentially weighted moving average and variance of observations.
+ *  This operates in constant memory and constant time per observation.
+ *
+ *  Each observation x updates the estimates with the smoothing factor alpha as
+ *    diff = x - average
+ *    average += alpha * diff
+ *    variance = (1 - alpha) * (variance + alpha * diff * diff)
+ *  so older observations decay instead of being dropped by a periodic Reset().
+ *
+ *  The reported minimum and maximum decay the same way, as an envelope of the observations: an
+ *  observation beyond the envelope moves it to the observation, any other observation x moves it
+ *    max += alpha * (x - max)
+ *    min += alpha * (x - min)
+ *  so an old extreme fades out with the same half life as the average, which always lies within
+ *  the envelope. The sample count is the number of observations since construction or the last
+ *  Reset(), and is not weighted.
+ *
+ *  This class is thread safe and acquires a mutex for each operation.
+ */
+class ExponentialMovingAverageStatistics : public AccumulatorInterface
+{
+public:
+  /// Smoothing factor of the default constructor, a half life of about 6.6 samples
+  static constexpr double kDefaultAlpha = 0.1;
+
+  /**
+   *  Construct an exponential moving average with kDefaultAlpha.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ExponentialMovingAverageStatistics();
+
+  /**
+   *  Construct an exponential moving average with the given smoothing factor.
+   *
+   *  @param alpha weight of each new observation, in (0, 1]
+   *  @throws std::invalid_argument if alpha is out of range
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit ExponentialMovingAverageStatistics(double alpha);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ~ExponentialMovingAverageStatistics() override = default;
+
+  /**
+   *  Return the smoothing factor for which the weight of an observation halves after the given
+   *  number of subsequent observations.
+   *
+   *  @param half_life half life in number of observations
+   *  @return the smoothing factor alpha
+   *  @throws std::invalid_argument if half_life is not positive
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  static double HalfLifeToAlpha(double half_life);
+
+  /**
+   *  Observe a sample. Note: any input values of NaN will be discarded.
+   *
+   *  @param item the item that was observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurement(const double item) override;
+
+  /**
+   *  Observe a block of samples in order, taking the lock once.
+   *
+   *  @param items pointer to the first observed item
+   *  @param item_count number of observed items
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurements(const double * items, size_t item_count) override;
+
+  /**
+   *  Return the exponentially weighted statistics of the observations.
+   *
+   *  @return StatisticData with the weighted average and standard deviation
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatistics() const override;
+
+  /**
+   *  Discard all observations.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Reset() override;
+
+  /**
+   *  Return the exponentially weighted statistics and discard all observations, holding the lock
+   *  once.
+   *
+   *  @return StatisticData of the observations before the reset
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatisticsAndReset() override;
+
+  /**
+   *  Return the number of samples observed since construction or the last Reset().
+   *
+   *  @return the number of samples
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetCount() const override;
+
+  /**
+   *  Return the smoothing factor.
+   *
+   *  @return alpha
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  double GetAlpha() const;
+
+private:
+  /**
+   * Update the estimates with a sample that is not NaN.
+   */
+  void Update(const double item) RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Return the current estimates as StatisticData.
+   */
+  StatisticData GetStatisticsUnsynchronized() const RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Discard all observations.
+   */
+  void ResetUnsynchronized() RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  const double alpha_;
+  mutable std::mutex mutex_;
+  double average_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+  double variance_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+  double min_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = std::numeric_limits<double>::max();
+  double max_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = std::numeric_limits<double>::lowest();
+  uint64_t count_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__EXPONENTIAL_MOVING_AVERAGE_HPP_
@@ -0,0 +1,216 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__LOG_LINEAR_HISTOGRAM_HPP_
+#define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__LOG_LINEAR_HISTOGRAM_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "accumulator_interface.hpp"
+#include "types.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+/**
+ *  A bucket of a LogLinearHistogram, holding the observations in [lower_bound, upper_bound).
+ */
+struct LIBSTATISTICS_COLLECTOR_PUBLIC HistogramBucket
+{
+  /// smallest value of the bucket
+  double lower_bound = 0;
+  /// smallest value of the next bucket
+  double upper_bound = 0;
+  /// number of observations in the bucket
+  uint64_t count = 0;
+};
+
+/**
+ *  A histogram with fixed log-linear buckets, in the manner of HdrHistogram (reference:
+ *  http://hdrhistogram.org/), recording the full distribution of the observations.
+ *
+ *  Observations are rounded to a multiple of Options::resolution and counted in buckets that are
+ *  one resolution wide up to 2^Options::significant_bits resolutions, and whose width doubles with
+ *  each further power of two, so that every bucket is narrower than
+ *  2^-(Options::significant_bits - 1) times its values. Values below 0 are counted in the first
+ *  bucket and values above Options::max_value in the last one.
+ *
+ *  Each observation is a single relaxed atomic increment, so any number of threads may add
+ *  observations concurrently without a lock, and GetStatisticsAndReset() loses no observation.
+ *  The statistics are derived from the bucket counts: each observation is accounted for with the
+ *  midpoint of its bucket, within the relative precision of the histogram.
+ */
+class LogLinearHistogram : public AccumulatorInterface
+{
+public:
+  /**
+   *  Configuration of the histogram's precision and range.
+   */
+  struct Options
+  {
+    /// width of the narrowest buckets, the smallest distinguished difference, must be positive
+    double resolution = 1e-3;
+    /// number of significant bits of the bucket values, in [1, 16]
+    size_t significant_bits = 7;
+    /// largest value with its own bucket, must be at least the resolution and below 2^62
+    /// resolutions
+    double max_value = 1e6;
+  };
+
+  /**
+   *  Construct a histogram with default options: a relative precision of 1.6% and 0.001 resolution
+   *  for values up to 1e6, e.g. 1 us to 16 min when observing milliseconds, in 1592 buckets.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  LogLinearHistogram();
+
+  /**
+   *  Construct a histogram with the given options.
+   *
+   *  @param options the precision and range configuration
+   *  @throws std::invalid_argument if any of the options are out of range
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit LogLinearHistogram(const Options & options);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ~LogLinearHistogram() override;
+
+  /**
+   *  Observe a sample. Note: any input values of NaN will be discarded.
+   *
+   *  @param item the item that was observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurement(const double item) override;
+
+  /**
+   *  Return the statistics of the observations, derived from the bucket counts.
+   *
+   *  @return StatisticData for all the observed samples
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatistics() const override;
+
+  /**
+   *  Discard all observations. Equivalent to a new window.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Reset() override;
+
+  /**
+   *  Return the statistics of the observations and discard them, see GetAndReset to also keep the
+   *  bucket counts of the window.
+   *
+   *  @return StatisticData for the observations before the reset
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatisticsAndReset() override;
+
+  /**
+   *  Return the number of observations.
+   *
+   *  @return the number of samples observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetCount() const override;
+
+  /**
+   *  Return the non-empty buckets in ascending order of value.
+   *
+   *  @return the buckets holding at least one observation
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::vector<HistogramBucket> GetBuckets() const;
+
+  /**
+   *  Move the observations of this histogram into window, replacing the observations of window,
+   *  and discard them from this histogram without losing any observation made concurrently. This
+   *  ends a measurement window: the statistics and buckets of the window can then be read from
+   *  window consistently. Both histograms must have been constructed with the same options.
+   *
+   *  @param window the histogram receiving the observations
+   *  @return true if moved, false if the options of the histograms differ
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool GetAndReset(LogLinearHistogram & window);
+
+  /**
+   *  Add the observations of another histogram to this one. Both histograms must have been
+   *  constructed with the same options.
+   *
+   *  @param other the histogram to combine into this one, left unchanged
+   *  @return true if merged, false if the options of the histograms differ
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool Merge(const LogLinearHistogram & other);
+
+  /**
+   *  Return the options this histogram was constructed with.
+   *
+   *  @return the options
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  const Options & GetOptions() const;
+
+  /**
+   *  Return the number of buckets of the histogram.
+   *
+   *  @return the bucket count
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetBucketCount() const;
+
+private:
+  /**
+   * Return whether the other histogram has the same bucket layout.
+   */
+  bool HasSameOptions(const LogLinearHistogram & other) const;
+
+  /**
+   * Return the bucket index of a value in resolutions.
+   */
+  size_t GetBucketIndex(const uint64_t value) const;
+
+  /**
+   * Return the smallest value in resolutions of the given bucket.
+   */
+  uint64_t GetBucketLowerBound(const size_t index) const;
+
+  /**
+   * Return the accumulated state of count observations in the given bucket.
+   */
+  AccumulatorState GetBucketState(const size_t index, const uint64_t count) const;
+
+  const Options options_;
+  /// values of at most this many resolutions have their own bucket
+  const uint64_t max_value_;
+  /// number of buckets each one resolution wide, 2^options_.significant_bits
+  const uint64_t linear_bucket_count_;
+  const size_t bucket_count_;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+};
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__LOG_LINEAR_HISTOGRAM_HPP_
@@ -18,22 +18,74 @@
 #include <cmath>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <numeric>
+#include <thread>
 #include <type_traits>
 
+#include "accumulator_interface.hpp"
 #include "types.hpp"
 
+#include "libstatistics_collector/instrumentation.hpp"
 #include "libstatistics_collector/visibility_control.hpp"
 
-#include "rcpputils/thread_safety_annotations.hpp"
-
 namespace libstatistics_collector
 {
 namespace moving_average_statistics
 {
 
+/**
+ *  Describes which threads are allowed to modify a MovingAverageStatistics instance.
+ */
+enum class WriterMode
+{
+  /// Any thread may add measurements or reset. Writers are serialized with a mutex.
+  kMultiWriter,
+  /// Only a single thread at a time adds measurements or resets. Writers never take a lock.
+  kSingleWriter,
+  /// Any thread may add measurements or reset. Each writing thread is mapped to its own
+  /// cache line aligned shard, so concurrent writers rarely contend.
+  kSharded
+};
+
+/**
+ *  A bitmask of the statistics accumulated by BasicMovingAverageStatistics. The sample count is
+ *  always accumulated.
+ */
+using StatisticSet = uint32_t;
+
+/// Accumulate the average of the observations
+constexpr const StatisticSet kStatisticAverage = 1u << 0;
+/// Accumulate the minimum of the observations
+constexpr const StatisticSet kStatisticMin = 1u << 1;
+/// Accumulate the maximum of the observations
+constexpr const StatisticSet kStatisticMax = 1u << 2;
+/// Accumulate the standard deviation of the observations, requires kStatisticAverage
+constexpr const StatisticSet kStatisticStandardDeviation = 1u << 3;
+/// Accumulate only the sample count
+constexpr const StatisticSet kStatisticCountOnly = 0;
+/// Accumulate all statistics, as MovingAverageStatistics does
+constexpr const StatisticSet kAllStatistics =
+  kStatisticAverage | kStatisticMin | kStatisticMax | kStatisticStandardDeviation;
+
+/// Size of a cache line, used to keep independently written data on separate cache lines
+constexpr const size_t kCacheLineSize = 64;
+
+/**
+ *  Return a small process-wide index for the calling thread, assigned round-robin on first use
+ *  so that the first N distinct writer threads map to N distinct shards.
+ *
+ *  @return the index of the calling thread
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+size_t GetThreadShardIndex();
+
 /**
  *  A class for calculating moving average statistics. This operates in constant memory and constant time. Note:
  *  reset() must be called manually in order to start a new measurement window.
@@ -45,39 +97,88 @@ namespace moving_average_statistics
  *  for standard deviation.
  *
  *  When statistics are not available, e.g. no observations have been made, NaNs are returned.
+ *
+ *  Readers (GetStatistics, GetCount, etc.) never take a lock: the accumulated values are published
+ *  with a sequence lock and readers retry until they observe a consistent snapshot. Writers
+ *  (AddMeasurement and Reset) are serialized with a mutex in WriterMode::kMultiWriter, the default.
+ *  In WriterMode::kSingleWriter the caller guarantees that measurements are never added
+ *  concurrently, e.g. they all happen on a single subscription thread, and the mutex is skipped
+ *  entirely. Each write instead claims the sequence lock with a compare-and-swap, so that Reset and
+ *  GetStatisticsAndReset may still be called from another thread, e.g. a publisher.
+ *  In WriterMode::kSharded measurements are accumulated per writing thread in separate shards that
+ *  are combined when the statistics are read, see AccumulatorState::Merge.
+ *
+ *  Statistics not selected by the Statistics template parameter are neither stored nor updated per
+ *  observation, and are reported as NaN. MovingAverageStatistics selects all of them.
+ *
+ *  @tparam Statistics the StatisticSet to accumulate
  */
-class MovingAverageStatistics
+template<StatisticSet Statistics>
+class BasicMovingAverageStatistics : public AccumulatorInterface
 {
+  static_assert(
+    (Statistics & ~kAllStatistics) == 0, "Statistics contains unknown StatisticSet flags");
+  static_assert(
+    !(Statistics & kStatisticStandardDeviation) || (Statistics & kStatisticAverage),
+    "kStatisticStandardDeviation requires kStatisticAverage");
+
 public:
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  MovingAverageStatistics() = default;
+  BasicMovingAverageStatistics()
+  {
+    StoreStateUnsynchronized(AccumulatorState{});
+  }
+
+  /**
+   *  Construct an instance with the given writer concurrency mode.
+   *
+   *  @param writer_mode whether writes may happen concurrently from multiple threads
+   *  @param shard_count number of shards used in WriterMode::kSharded, ignored otherwise.
+   *  0 selects one shard per hardware thread.
+   */
+  explicit BasicMovingAverageStatistics(WriterMode writer_mode, size_t shard_count = 0)
+  : writer_mode_{writer_mode}
+  {
+    StoreStateUnsynchronized(AccumulatorState{});
+    if (writer_mode_ == WriterMode::kSharded) {
+      if (shard_count == 0) {
+        shard_count = std::max(1u, std::thread::hardware_concurrency());
+      }
+      shard_count_ = shard_count;
+      shards_ = std::make_unique<Shard[]>(shard_count_);
+    }
+  }
 
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  ~MovingAverageStatistics() = default;
+  ~BasicMovingAverageStatistics() override = default;
 
   /**
    *  Returns the arithmetic mean of all data recorded. If no observations have been made, returns NaN.
    *
    *  @return The arithmetic mean of all data recorded, or NaN if the sample count is 0.
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  double Average() const RCPPUTILS_TSA_REQUIRES(mutex_);
+  double Average() const
+  {
+    return GetStatistics().average;
+  }
 
   /**
    *  Returns the maximum value recorded. If size of list is zero, returns NaN.
    *
    *  @return The maximum value recorded, or NaN if size of data is zero.
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  double Max() const RCPPUTILS_TSA_REQUIRES(mutex_);
+  double Max() const
+  {
+    return GetStatistics().max;
+  }
 
   /**
    *  Returns the minimum value recorded. If size of list is zero, returns NaN.
    *
    *  @return The minimum value recorded, or NaN if size of data is zero.
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  double Min() const RCPPUTILS_TSA_REQUIRES(mutex_);
+  double Min() const
+  {
+    return GetStatistics().min;
+  }
 
   /**
    *  Returns the standard deviation (population) of all data recorded. If size of list is zero, returns NaN.
@@ -87,8 +188,10 @@ public:
    *
    *  @return The standard deviation (population) of all data recorded, or NaN if size of data is zero.
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  double StandardDeviation() const RCPPUTILS_TSA_REQUIRES(mutex_);
+  double StandardDeviation() const
+  {
+    return GetStatistics().standard_deviation;
+  }
 
   /**
    *  Return a StatisticData object, containing average, minimum, maximum, standard deviation (population),
@@ -98,14 +201,110 @@ public:
    *  @return StatisticData object, containing average, minimum, maximum, standard deviation (population),
    *  and sample count.
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  StatisticData GetStatistics() const;
+  StatisticData GetStatistics() const override
+  {
+    return ToStatisticData(GetState());
+  }
+
+  /**
+   *  Return the statistics of all observations and reset them in a single write, so that no
+   *  observation is lost between reading and resetting, e.g. when publishing every window.
+   *  In WriterMode::kMultiWriter this takes the writer lock once, in WriterMode::kSingleWriter it
+   *  may run concurrently with the writing thread, which retries a measurement that overlapped with
+   *  the reset, and in WriterMode::kSharded each shard is swapped in turn.
+   *
+   *  @return StatisticData object of all observations before the reset
+   */
+  StatisticData GetStatisticsAndReset() override
+  {
+    return ToStatisticData(GetStateAndReset());
+  }
+
+  /**
+   *  Return the running values and reset them in a single write, see GetStatisticsAndReset.
+   *
+   *  @return the accumulated state of all observations before the reset
+   */
+  AccumulatorState GetStateAndReset()
+  {
+    if (writer_mode_ == WriterMode::kSharded) {
+      AccumulatorState state;
+      for (size_t i = 0; i < shard_count_; i++) {
+        state.Merge(shards_[i].statistics.GetStateAndReset());
+      }
+      return state;
+    }
+    auto lock = LockForWrite();
+    return ExchangeStateUnsynchronized([](const AccumulatorState &) {return AccumulatorState{};});
+  }
+
+  /**
+   *  Return a consistent snapshot of the running values, e.g. to merge it into another instance.
+   *  Values of statistics that are not accumulated keep their AccumulatorState defaults.
+   *
+   *  @return the accumulated state of all observations
+   */
+  AccumulatorState GetState() const
+  {
+    if (writer_mode_ != WriterMode::kSharded) {
+      return LoadState();
+    }
+    AccumulatorState state;
+    for (size_t i = 0; i < shard_count_; i++) {
+      state.Merge(shards_[i].statistics.LoadState());
+    }
+    return state;
+  }
+
+  /**
+   *  Combine the observations summarized by the given state into this instance. This is a write
+   *  and follows the same concurrency rules as AddMeasurement.
+   *
+   *  @param state the accumulated state to combine into this instance
+   */
+  void Merge(const AccumulatorState & state)
+  {
+    if (writer_mode_ == WriterMode::kSharded) {
+      GetThreadShard().statistics.Merge(state);
+      return;
+    }
+    auto lock = LockForWrite();
+    ExchangeStateUnsynchronized(
+      [&state](AccumulatorState merged) {
+        merged.Merge(state);
+        return merged;
+      });
+  }
+
+  /**
+   *  Combine all observations of another instance into this one, e.g. to aggregate the windows of
+   *  several collectors. The other instance is left unchanged.
+   *
+   *  @param other the instance to combine into this one
+   */
+  template<StatisticSet OtherStatistics>
+  void Merge(const BasicMovingAverageStatistics<OtherStatistics> & other)
+  {
+    static_assert(
+      (Statistics & ~OtherStatistics) == 0,
+      "Can only merge instances that accumulate at least the same statistics");
+    Merge(other.GetState());
+  }
 
   /**
    *  Reset all calculated values. Equivalent to a new window for a moving average.
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  void Reset();
+  void Reset() override
+  {
+    if (writer_mode_ == WriterMode::kSharded) {
+      for (size_t i = 0; i < shard_count_; i++) {
+        shards_[i].statistics.Reset();
+      }
+      return;
+    }
+    auto lock = LockForWrite();
+    ExchangeStateUnsynchronized([](const AccumulatorState &) {return AccumulatorState{};});
+  }
 
   /**
    *  Observe a sample for the given window. The input item is used to calculate statistics.
@@ -113,26 +312,379 @@ public:
    *
    *  @param item The item that was observed
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  virtual void AddMeasurement(const double item);
+  void AddMeasurement(const double item) override
+  {
+    if (std::isnan(item)) {
+      return;
+    }
+    if (writer_mode_ == WriterMode::kSharded) {
+      GetThreadShard().statistics.AddMeasurement(item);
+      return;
+    }
+    auto lock = LockForWrite();
+    UpdateUnsynchronized(item);
+  }
+
+  /**
+   *  Observe a block of samples for the given window, e.g. a batch drained from a queue. This takes
+   *  the lock at most once for the whole block, see AccumulatorState::AddBlock.
+   *  Note: any input values of NaN will be discarded and not added as a measurement.
+   *
+   *  @param items pointer to the first observed item
+   *  @param item_count number of observed items
+   */
+  void AddMeasurements(const double * items, size_t item_count) override
+  {
+    if (item_count == 0) {
+      return;
+    }
+    if (item_count == 1) {
+      BasicMovingAverageStatistics::AddMeasurement(items[0]);
+      return;
+    }
+    if (writer_mode_ == WriterMode::kSharded) {
+      GetThreadShard().statistics.AddMeasurements(items, item_count);
+      return;
+    }
+    // summarize the block before taking the lock so that the critical section stays short
+    AccumulatorState block;
+    block.AddBlock(items, item_count);
+    Merge(block);
+  }
 
   /**
    * Return the number of samples observed
    *
    * @return the number of samples observed
    */
-  LIBSTATISTICS_COLLECTOR_PUBLIC
-  uint64_t GetCount() const;
+  uint64_t GetCount() const override
+  {
+    if (writer_mode_ != WriterMode::kSharded) {
+      // a single atomic value is always consistent on its own
+      return count_.load(std::memory_order_relaxed);
+    }
+    uint64_t count = 0;
+    for (size_t i = 0; i < shard_count_; i++) {
+      count += shards_[i].statistics.GetCount();
+    }
+    return count;
+  }
+
+  /**
+   * Return the number of writers that had to wait for the writer lock, only counted if
+   * kInstrumentationEnabled. Always 0 in WriterMode::kSingleWriter and WriterMode::kSharded.
+   *
+   * @return the lock contention count since construction
+   */
+  uint64_t GetLockContentionCount() const override
+  {
+    return lock_contention_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the writer concurrency mode this instance was constructed with.
+   *
+   * @return the writer mode
+   */
+  WriterMode GetWriterMode() const
+  {
+    return writer_mode_;
+  }
+
+  /**
+   * Return the number of shards, 1 unless operating in WriterMode::kSharded.
+   *
+   * @return the number of shards
+   */
+  size_t GetShardCount() const
+  {
+    return writer_mode_ == WriterMode::kSharded ? shard_count_ : 1;
+  }
 
 private:
+  static constexpr bool kTracksAverage = (Statistics & kStatisticAverage) != 0;
+  static constexpr bool kTracksMin = (Statistics & kStatisticMin) != 0;
+  static constexpr bool kTracksMax = (Statistics & kStatisticMax) != 0;
+  static constexpr bool kTracksStandardDeviation = (Statistics & kStatisticStandardDeviation) != 0;
+
+  // Positions of the accumulated values in values_; only the tracked ones are stored.
+  static constexpr size_t kAverageIndex = 0;
+  static constexpr size_t kMinIndex = kAverageIndex + kTracksAverage;
+  static constexpr size_t kMaxIndex = kMinIndex + kTracksMin;
+  static constexpr size_t kSumOfSquareDiffIndex = kMaxIndex + kTracksMax;
+  static constexpr size_t kValueCount = kSumOfSquareDiffIndex + kTracksStandardDeviation;
+
+  /// A cache line aligned instance used by WriterMode::kSharded
+  struct Shard;
+
+  /**
+   * Acquire write access: locks mutex_ in WriterMode::kMultiWriter and returns an unlocked
+   * lock in WriterMode::kSingleWriter, where writes are serialized by TryBeginWrite instead.
+   */
+  std::unique_lock<std::mutex> LockForWrite()
+  {
+    if (writer_mode_ == WriterMode::kSingleWriter) {
+      return std::unique_lock<std::mutex>{mutex_, std::defer_lock};
+    }
+    return LockCountingContention(mutex_, lock_contention_count_);
+  }
+
+  /**
+   * Return the shard that the calling thread writes to in WriterMode::kSharded.
+   */
+  Shard & GetThreadShard()
+  {
+    return shards_[GetThreadShardIndex() % shard_count_];
+  }
+
+  /**
+   * Convert the accumulated values to StatisticData, reporting the untracked statistics as NaN.
+   */
+  static StatisticData ToStatisticData(const AccumulatorState & state)
+  {
+    StatisticData to_return = state.ToStatisticData();
+    if constexpr (!kTracksAverage) {
+      to_return.average = std::nan("");
+    }
+    if constexpr (!kTracksMin) {
+      to_return.min = std::nan("");
+    }
+    if constexpr (!kTracksMax) {
+      to_return.max = std::nan("");
+    }
+    if constexpr (!kTracksStandardDeviation) {
+      to_return.standard_deviation = std::nan("");
+    }
+    return to_return;
+  }
+
+  /**
+   * Fold a non-NaN item into the accumulated values, touching only the tracked statistics. The
+   * caller must hold the write access returned by LockForWrite.
+   */
+  void UpdateUnsynchronized(const double item)
+  {
+    uint64_t begin_sequence = 0;
+    uint64_t count = 0;
+    double previous_average = 0;
+    double average = 0;
+    do {
+      begin_sequence = LoadWriteSequence();
+      count = count_.load(std::memory_order_relaxed) + 1;
+      if constexpr (kTracksAverage) {
+        previous_average = LoadValue(kAverageIndex);
+        average = previous_average + (item - previous_average) / static_cast<double>(count);
+      }
+    } while (!TryBeginWrite(begin_sequence));
+    (void) previous_average;
+
+    count_.store(count, std::memory_order_relaxed);
+    if constexpr (kTracksAverage) {
+      StoreValue(kAverageIndex, average);
+    }
+    if constexpr (kTracksMin) {
+      StoreValue(kMinIndex, std::min(LoadValue(kMinIndex), item));
+    }
+    if constexpr (kTracksMax) {
+      StoreValue(kMaxIndex, std::max(LoadValue(kMaxIndex), item));
+    }
+    if constexpr (kTracksStandardDeviation) {
+      StoreValue(
+        kSumOfSquareDiffIndex,
+        LoadValue(kSumOfSquareDiffIndex) + (item - previous_average) * (item - average));
+    }
+    EndWrite();
+  }
+
+  /**
+   * Read a consistent snapshot of this instance's own accumulated values, ignoring shards.
+   */
+  AccumulatorState LoadState() const
+  {
+    AccumulatorState state;
+    uint64_t begin_sequence = 0;
+
+    do {
+      begin_sequence = sequence_.load(std::memory_order_acquire);
+      if (begin_sequence & 1) {
+        continue;  // a write is in progress
+      }
+      state = LoadStateUnsynchronized();
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((begin_sequence & 1) || begin_sequence != sequence_.load(std::memory_order_relaxed));
+
+    return state;
+  }
+
+  /**
+   * Return the accumulated values without the seqlock protocol. Only valid for the exclusive
+   * writer.
+   */
+  AccumulatorState LoadStateUnsynchronized() const
+  {
+    AccumulatorState state;
+    state.count = count_.load(std::memory_order_relaxed);
+    if constexpr (kTracksAverage) {
+      state.average = LoadValue(kAverageIndex);
+    }
+    if constexpr (kTracksMin) {
+      state.min = LoadValue(kMinIndex);
+    }
+    if constexpr (kTracksMax) {
+      state.max = LoadValue(kMaxIndex);
+    }
+    if constexpr (kTracksStandardDeviation) {
+      state.sum_of_square_diff_from_mean = LoadValue(kSumOfSquareDiffIndex);
+    }
+    return state;
+  }
+
+  /**
+   * Replace the accumulated values with modify(current values) in a single write and return the
+   * values they replaced. The caller must hold the write access returned by LockForWrite.
+   */
+  template<typename Modify>
+  AccumulatorState ExchangeStateUnsynchronized(Modify && modify)
+  {
+    while (true) {
+      const uint64_t begin_sequence = LoadWriteSequence();
+      const auto state = LoadStateUnsynchronized();
+      const auto modified = modify(state);
+      if (TryBeginWrite(begin_sequence)) {
+        StoreValuesUnsynchronized(modified);
+        EndWrite();
+        return state;
+      }
+    }
+  }
+
+  /**
+   * Overwrite the accumulated values and publish them to readers. Only used before the instance
+   * is shared with other threads.
+   */
+  void StoreStateUnsynchronized(const AccumulatorState & state)
+  {
+    BeginWrite();
+    StoreValuesUnsynchronized(state);
+    EndWrite();
+  }
+
+  /**
+   * Store the accumulated values between BeginWrite and EndWrite.
+   */
+  void StoreValuesUnsynchronized(const AccumulatorState & state)
+  {
+    count_.store(state.count, std::memory_order_relaxed);
+    if constexpr (kTracksAverage) {
+      StoreValue(kAverageIndex, state.average);
+    }
+    if constexpr (kTracksMin) {
+      StoreValue(kMinIndex, state.min);
+    }
+    if constexpr (kTracksMax) {
+      StoreValue(kMaxIndex, state.max);
+    }
+    if constexpr (kTracksStandardDeviation) {
+      StoreValue(kSumOfSquareDiffIndex, state.sum_of_square_diff_from_mean);
+    }
+  }
+
+  double LoadValue(const size_t index) const
+  {
+    return values_[index].load(std::memory_order_relaxed);
+  }
+
+  void StoreValue(const size_t index, const double value)
+  {
+    values_[index].store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the sequence number that a write reads the accumulated values at, waiting for a write
+   * in progress on another thread. That only happens in WriterMode::kSingleWriter, for a reset
+   * that overlaps with the writing thread, and only lasts a few stores.
+   */
+  uint64_t LoadWriteSequence() const
+  {
+    uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    while (sequence & 1) {
+      sequence = sequence_.load(std::memory_order_acquire);
+    }
+    return sequence;
+  }
+
+  /**
+   * Start a write computed from the accumulated values read at begin_sequence, see
+   * LoadWriteSequence. In WriterMode::kSingleWriter the writing thread and a reset from another
+   * thread may race, so the write claims the sequence with a compare-and-swap and fails if another
+   * write was started since begin_sequence; the caller then recomputes it. Otherwise writes are
+   * exclusive and this always succeeds.
+   *
+   * @return true if the write was started, false if it must be recomputed
+   */
+  bool TryBeginWrite(uint64_t begin_sequence)
+  {
+    if (writer_mode_ != WriterMode::kSingleWriter) {
+      BeginWrite();
+      return true;
+    }
+    // the values the write was computed from must be read before the claim is validated
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!sequence_.compare_exchange_strong(
+        begin_sequence, begin_sequence + 1, std::memory_order_relaxed))
+    {
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Mark the start of a write: readers that overlap with it will retry.
+   */
+  void BeginWrite()
+  {
+    // only the (exclusive) writer modifies sequence_, so a relaxed read-modify-write is enough
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  /**
+   * Mark the end of a write, publishing the accumulated values to readers.
+   */
+  void EndWrite()
+  {
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  const WriterMode writer_mode_ = WriterMode::kMultiWriter;
+  /// Number of elements in shards_
+  size_t shard_count_ = 0;
+  /// Per thread shards, only allocated in WriterMode::kSharded
+  std::unique_ptr<Shard[]> shards_;
+  /// Serializes writers in WriterMode::kMultiWriter, unused otherwise
   mutable std::mutex mutex_;
-  double average_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
-  double min_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = std::numeric_limits<double>::max();
-  double max_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = std::numeric_limits<double>::min();
-  double sum_of_square_diff_from_mean_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
-  uint64_t count_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = 0;
+  /// Writers that found mutex_ locked, see GetLockContentionCount
+  std::atomic<uint64_t> lock_contention_count_{0};
+  /// Seqlock sequence number, odd while a write is in progress
+  std::atomic<uint64_t> sequence_{0};
+  // The accumulated values are atomics only so that lock-free readers do not race with the
+  // writer; every access is relaxed and ordering is provided by sequence_.
+  std::atomic<uint64_t> count_{0};
+  std::array<std::atomic<double>, kValueCount> values_;
+};
+
+template<StatisticSet Statistics>
+struct alignas(kCacheLineSize) BasicMovingAverageStatistics<Statistics>::Shard
+{
+  BasicMovingAverageStatistics<Statistics> statistics;
 };
 
+/**
+ *  Moving average statistics accumulating average, minimum, maximum, and standard deviation.
+ */
+using MovingAverageStatistics = BasicMovingAverageStatistics<kAllStatistics>;
+
 }  // namespace moving_average_statistics
 }  // namespace libstatistics_collector
 
@@ -0,0 +1,163 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__QUANTILE_SKETCH_HPP_
+#define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__QUANTILE_SKETCH_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "types.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+/**
+ *  A streaming quantile estimator operating in constant memory and constant time per observation.
+ *
+ *  This is a fixed-size variant of DDSketch (reference: https://arxiv.org/abs/1908.10693).
+ *  Observations are counted in logarithmically sized buckets, so that any quantile estimate is
+ *  within the configured relative accuracy of the true value. Magnitudes below Options::min_value
+ *  are counted as zero, and magnitudes above the range covered by Options::bucket_count buckets
+ *  are counted in the last bucket.
+ *
+ *  Each observation is a single relaxed atomic increment, so any number of threads may add
+ *  observations concurrently without a lock. Observations made concurrently with Reset() may be
+ *  counted in either window.
+ */
+class QuantileSketch
+{
+public:
+  /**
+   *  Configuration of the sketch's accuracy and memory.
+   */
+  struct Options
+  {
+    /// maximum relative error of any quantile estimate, in (0, 1)
+    double relative_accuracy = 0.01;
+    /// smallest magnitude distinguished from zero, must be positive
+    double min_value = 1e-3;
+    /// number of buckets for each of the positive and negative values, must be positive
+    size_t bucket_count = 1024;
+  };
+
+  /**
+   *  Construct a sketch with default options: 1% relative accuracy for magnitudes between 1e-3 and
+   *  roughly 8e5, e.g. 1 us to 13 min when observing milliseconds.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  QuantileSketch();
+
+  /**
+   *  Construct a sketch with the given options.
+   *
+   *  @param options the accuracy and memory configuration
+   *  @throws std::invalid_argument if any of the options are out of range
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  explicit QuantileSketch(const Options & options);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ~QuantileSketch();
+
+  /**
+   *  Observe a sample. Note: any input values of NaN will be discarded.
+   *
+   *  @param item the item that was observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurement(const double item);
+
+  /**
+   *  Estimate the given quantile of all observations.
+   *
+   *  @param quantile the quantile to estimate, in [0, 1], e.g. 0.99 for the 99th percentile
+   *  @return the estimated quantile, or NaN if there are no observations or if quantile is out of
+   *  range
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  double GetQuantile(const double quantile) const;
+
+  /**
+   *  Estimate the commonly reported quantiles of all observations.
+   *
+   *  @return the estimated quantiles, all NaN if there are no observations
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  QuantileData GetQuantileData() const;
+
+  /**
+   *  Return the number of observations.
+   *
+   *  @return the number of samples observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetCount() const;
+
+  /**
+   *  Add the observations of another sketch to this one. Both sketches must have been constructed
+   *  with the same options.
+   *
+   *  @param other the sketch to combine into this one, left unchanged
+   *  @return true if merged, false if the options of the sketches differ
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  bool Merge(const QuantileSketch & other);
+
+  /**
+   *  Discard all observations. Equivalent to a new window.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Reset();
+
+  /**
+   *  Return the options this sketch was constructed with.
+   *
+   *  @return the options
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  const Options & GetOptions() const;
+
+private:
+  /**
+   * Return the bucket index for a magnitude of at least options_.min_value.
+   */
+  size_t GetBucketIndex(const double magnitude) const;
+
+  /**
+   * Return the value representing all magnitudes of the given bucket within the relative accuracy.
+   */
+  double GetBucketValue(const size_t index) const;
+
+  const Options options_;
+  /// ratio between the upper and lower bounds of each bucket
+  const double gamma_;
+  /// natural logarithm of gamma_
+  const double log_gamma_;
+  std::unique_ptr<std::atomic<uint64_t>[]> positive_buckets_;
+  std::unique_ptr<std::atomic<uint64_t>[]> negative_buckets_;
+  /// magnitudes below options_.min_value
+  std::atomic<uint64_t> zero_bucket_{0};
+};
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__QUANTILE_SKETCH_HPP_
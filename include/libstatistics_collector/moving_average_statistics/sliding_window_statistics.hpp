@@ -0,0 +1,212 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__SLIDING_WINDOW_STATISTICS_HPP_
+#define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__SLIDING_WINDOW_STATISTICS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "accumulator_interface.hpp"
+#include "types.hpp"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+#include "rcpputils/thread_safety_annotations.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+/**
+ *  A class for calculating statistics over a time-based sliding window, e.g. the last second.
+ *  This operates in constant memory and constant time per observation.
+ *
+ *  The window is split into a fixed ring of sub-window buckets, each accumulating an
+ *  AccumulatorState. An observation is added to the bucket of its time, reusing the oldest
+ *  bucket once the window has moved past it. GetStatistics() merges the buckets that are still
+ *  within the window, so the statistics roll forward smoothly instead of dropping to zero
+ *  samples on a manual Reset(). The window therefore covers between
+ *  (bucket_count - 1) * bucket_duration and bucket_count * bucket_duration.
+ *
+ *  Times come from std::chrono::steady_clock unless explicitly provided. This class is thread safe
+ *  and acquires a mutex for each operation.
+ */
+class SlidingWindowStatistics : public AccumulatorInterface
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   *  Construct a sliding window of 10 buckets of 100 ms each.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  SlidingWindowStatistics();
+
+  /**
+   *  Construct a sliding window of bucket_count buckets of bucket_duration each.
+   *
+   *  @param bucket_duration duration of each sub-window bucket
+   *  @param bucket_count number of buckets in the ring
+   *  @throws std::invalid_argument if bucket_duration is not positive or bucket_count is zero
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  SlidingWindowStatistics(std::chrono::nanoseconds bucket_duration, size_t bucket_count);
+
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  ~SlidingWindowStatistics() override = default;
+
+  /**
+   *  Observe a sample at the current time. Note: any input values of NaN will be discarded.
+   *
+   *  @param item the item that was observed
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurement(const double item) override;
+
+  /**
+   *  Observe a sample at the given time. Samples older than the window are discarded.
+   *  Note: any input values of NaN will be discarded.
+   *
+   *  @param item the item that was observed
+   *  @param now the time of the observation
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurement(const double item, const Clock::time_point now);
+
+  /**
+   *  Observe a block of samples at the current time, taking the lock once.
+   *
+   *  @param items pointer to the first observed item
+   *  @param item_count number of observed items
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void AddMeasurements(const double * items, size_t item_count) override;
+
+  /**
+   *  Return the statistics of all observations within the window ending at the current time.
+   *
+   *  @return StatisticData of the observations within the window
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatistics() const override;
+
+  /**
+   *  Return the statistics of all observations within the window ending at the given time.
+   *
+   *  @param now the end of the window
+   *  @return StatisticData of the observations within the window
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatistics(const Clock::time_point now) const;
+
+  /**
+   *  Return the accumulated state of all observations within the window ending at the given time.
+   *
+   *  @param now the end of the window
+   *  @return the merged state of the buckets within the window
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  AccumulatorState GetState(const Clock::time_point now) const;
+
+  /**
+   *  Discard all observations in the window.
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  void Reset() override;
+
+  /**
+   *  Return the statistics of all observations within the window ending at the current time and
+   *  discard all observations, holding the lock once.
+   *
+   *  @return StatisticData of the observations within the window before the reset
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  StatisticData GetStatisticsAndReset() override;
+
+  /**
+   *  Return the number of samples within the window ending at the current time.
+   *
+   *  @return the number of samples within the window
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  uint64_t GetCount() const override;
+
+  /**
+   *  Return the duration of each sub-window bucket.
+   *
+   *  @return the bucket duration
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  std::chrono::nanoseconds GetBucketDuration() const;
+
+  /**
+   *  Return the number of sub-window buckets.
+   *
+   *  @return the bucket count
+   */
+  LIBSTATISTICS_COLLECTOR_PUBLIC
+  size_t GetBucketCount() const;
+
+private:
+  /**
+   * A sub-window of the ring and the number of the bucket_duration_ interval it accumulates.
+   */
+  struct Bucket
+  {
+    int64_t interval = kNoInterval;
+    AccumulatorState state;
+  };
+
+  /// Marks a bucket that has not accumulated any interval yet
+  static constexpr int64_t kNoInterval = std::numeric_limits<int64_t>::min();
+
+  /**
+   * Return the number of the bucket_duration_ interval containing the given time.
+   */
+  int64_t GetInterval(const Clock::time_point time) const;
+
+  /**
+   * Return the bucket for the given interval, recycling it if it holds an older interval.
+   * Returns nullptr if the interval is already outside the window.
+   */
+  Bucket * GetBucketForWrite(const int64_t interval) RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Merge the buckets within the window ending at the given interval.
+   */
+  AccumulatorState GetStateUnsynchronized(const int64_t current_interval) const
+  RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /**
+   * Discard all buckets.
+   */
+  void ResetUnsynchronized() RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  const std::chrono::nanoseconds bucket_duration_;
+  mutable std::mutex mutex_;
+  /// Newest interval observed so far
+  int64_t latest_interval_ RCPPUTILS_TSA_GUARDED_BY(mutex_) = kNoInterval;
+  std::vector<Bucket> buckets_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+};
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__SLIDING_WINDOW_STATISTICS_HPP_
@@ -15,9 +15,14 @@
 #ifndef LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__TYPES_HPP_
 #define LIBSTATISTICS_COLLECTOR__MOVING_AVERAGE_STATISTICS__TYPES_HPP_
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "libstatistics_collector/visibility_control.hpp"
 
@@ -41,6 +46,98 @@ struct LIBSTATISTICS_COLLECTOR_PUBLIC StatisticData
   double standard_deviation = std::nan("");
   /// number of samples of the observation
   uint64_t sample_count = 0;
+  /// expected fraction of the observations that was sampled, below 1 if the observations were
+  /// decimated, e.g. by a topic_statistics_collector::SamplingPolicy
+  double sample_rate = 1.0;
+};
+
+/**
+ *  A container for quantile estimates of a set of recorded observations.
+ */
+struct LIBSTATISTICS_COLLECTOR_PUBLIC QuantileData
+{
+  /// median of the observations
+  double p50 = std::nan("");
+  /// 90th percentile of the observations
+  double p90 = std::nan("");
+  /// 99th percentile of the observations
+  double p99 = std::nan("");
+  /// 99.9th percentile of the observations
+  double p999 = std::nan("");
+};
+
+/**
+ *  The running values from which StatisticData is derived. States accumulated independently, e.g.
+ *  by different threads or different collectors, can be combined with Merge() without access to the
+ *  original observations.
+ */
+struct LIBSTATISTICS_COLLECTOR_PUBLIC AccumulatorState
+{
+  /// running average of the observations
+  double average = 0;
+  /// min value of the observations
+  double min = std::numeric_limits<double>::max();
+  /// max value of the observations
+  double max = std::numeric_limits<double>::lowest();
+  /// sum of the squared differences from the running average (Welford's M2)
+  double sum_of_square_diff_from_mean = 0;
+  /// number of observations
+  uint64_t count = 0;
+
+  /**
+   * Fold a single observation into this state using Welford's online algorithm.
+   * The item must not be NaN.
+   *
+   * @param item the observed value
+   */
+  void Add(const double item)
+  {
+    count++;
+    const double previous_average = average;
+    average = previous_average + (item - previous_average) / static_cast<double>(count);
+    min = std::min(min, item);
+    max = std::max(max, item);
+    sum_of_square_diff_from_mean += (item - previous_average) * (item - average);
+  }
+
+  /**
+   * Fold a block of observations into this state. NaN items are skipped. The block is summarized
+   * with a branch-free two-pass kernel, which is both vectorizable and more accurate than adding
+   * the items one by one, and then combined into this state with Merge().
+   *
+   * @param items pointer to the first observed value
+   * @param item_count number of observed values
+   */
+  void AddBlock(const double * items, size_t item_count);
+
+  /**
+   * Combine another state into this one, as if all of its observations had been added here.
+   * Uses the parallel variance formula by Chan et al.
+   * (reference:
+   * https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm)
+   *
+   * @param other the state to combine into this one
+   */
+  void Merge(const AccumulatorState & other);
+
+  /**
+   * Derive the statistics for this state. For the case of no observations, the average, min, max,
+   * and standard deviation are NaN.
+   *
+   * @return StatisticData for the accumulated observations
+   */
+  StatisticData ToStatisticData() const;
+
+  /**
+   * Return the state that ToStatisticData maps to the given statistics, e.g. to merge the
+   * statistics of accumulators that do not expose their state. The result is exact for the
+   * statistics of a state up to rounding, and an approximation for other accumulators, e.g. the
+   * weighted statistics of ExponentialMovingAverageStatistics.
+   *
+   * @param data the statistics of some observations
+   * @return the state of the observations, empty if data has no samples
+   */
+  static AccumulatorState FromStatisticData(const StatisticData & data);
 };
 
 /**
@@ -53,6 +150,25 @@ struct LIBSTATISTICS_COLLECTOR_PUBLIC StatisticData
 LIBSTATISTICS_COLLECTOR_PUBLIC
 std::string StatisticsDataToString(const StatisticData & results);
 
+/**
+ * The longest string StatisticsDataToString can produce: the labels, four doubles of up to 309
+ * integral digits with sign, point, and 6 decimals, and a 20 digit count.
+ */
+constexpr const size_t kStatisticsDataStringMaxLength = 34 + 4 * 317 + 20;
+
+/**
+ * Pretty print the contents of a StatisticData struct into a caller provided buffer, without
+ * allocating. The result is identical to StatisticsDataToString and is not null terminated.
+ *
+ * @param results the StatisticData to pretty print
+ * @param buffer the buffer to print into
+ * @param buffer_size size of buffer, at least kStatisticsDataStringMaxLength to never truncate
+ * @return the printed contents within buffer, or an empty view if buffer is too small
+ */
+LIBSTATISTICS_COLLECTOR_PUBLIC
+std::string_view StatisticsDataToString(
+  const StatisticData & results, char * buffer, size_t buffer_size);
+
 }  // namespace moving_average_statistics
 }  // namespace libstatistics_collector
 
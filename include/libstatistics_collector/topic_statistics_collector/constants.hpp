@@ -26,7 +26,13 @@ namespace topic_statistics_constants
 {
 constexpr const char kMsgAgeStatName[] = "message_age";
 constexpr const char kMsgPeriodStatName[] = "message_period";
+constexpr const char kMsgJitterStatName[] = "message_jitter";
+constexpr const char kMsgPeriodDeviationStatName[] = "message_period_deviation";
+constexpr const char kMsgRateStatName[] = "message_rate";
+constexpr const char kMsgBandwidthStatName[] = "message_bandwidth";
 constexpr const char kMillisecondUnitName[] = "ms";
+constexpr const char kHertzUnitName[] = "hz";
+constexpr const char kBytesPerSecondUnitName[] = "bytes_per_second";
 
 constexpr const char kCollectStatsTopicNameParam[] = "collect_topic_name";
 constexpr const char kPublishStatsTopicNameParam[] = "publish_topic_name";
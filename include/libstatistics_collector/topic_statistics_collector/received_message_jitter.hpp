@@ -0,0 +1,296 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_JITTER_HPP_
+#define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_JITTER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "constants.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
+
+#include "rcl/time.h"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+/**
+ * Class used to measure the inter-arrival jitter of the messages, tparam T, received from a ROS2
+ * subscriber, and to count bursts and gaps, e.g. from DDS batching and network stalls.
+ *
+ * The jitter of a period is its absolute difference from the expected period, in milliseconds,
+ * published as kMsgPeriodDeviationStatName. This differs from the kMsgJitterStatName of
+ * ReceivedMessageStatisticsCollector, the absolute difference between consecutive periods. A
+ * period shorter than the burst threshold is a burst, a period longer than the gap threshold is a
+ * gap. Periods are measured as by ReceivedMessagePeriodCollector, including its locking and
+ * discarding of negative periods and periods above SetMaxPeriod: the jitter and the burst and gap
+ * counts are updated in the same critical section as the time of the last message, and no sample
+ * is stored. A discarded period is neither a burst nor a gap, so the maximum period, if any,
+ * should be well above the gap threshold.
+ *
+ * Every message is stamped, so that bursts and gaps are counted for every period whatever the
+ * sampling policy, which only applies to the jitter statistics: a message that is not sampled
+ * still takes the lock of ReceivedMessagePeriodCollector.
+ *
+ * The burst and gap counts are kept since construction, like GetDiscardedPeriodCount, so they can
+ * be read at any rate without resetting the jitter statistics. A gap is only counted once the
+ * message ending it arrives: to alert on a topic that stopped publishing, compare
+ * GetTimeSinceLastMessage with the gap threshold.
+ *
+ * @tparam T the message type to receive from the subscriber / listener
+ */
+template<typename T>
+class ReceivedMessageJitterCollector : public ReceivedMessagePeriodCollector<T>
+{
+public:
+  /**
+   * Construct a ReceivedMessageJitterCollector object counting periods shorter than half the
+   * expected period as bursts, and periods longer than twice the expected period as gaps.
+   *
+   * @param expected_period the period the messages are published with
+   * @throws std::invalid_argument if expected_period is not positive
+   */
+  explicit ReceivedMessageJitterCollector(const std::chrono::nanoseconds expected_period)
+  : ReceivedMessageJitterCollector(expected_period, expected_period / 2, expected_period * 2)
+  {
+  }
+
+  /**
+   * Construct a ReceivedMessageJitterCollector object with the given thresholds.
+   *
+   * @param expected_period the period the messages are published with
+   * @param burst_threshold periods shorter than this are counted as bursts
+   * @param gap_threshold periods longer than this are counted as gaps
+   * @param writer_mode the writer mode, see ReceivedMessagePeriodCollector
+   * @throws std::invalid_argument if expected_period is not positive, or if the burst threshold is
+   * above the gap threshold
+   */
+  ReceivedMessageJitterCollector(
+    const std::chrono::nanoseconds expected_period,
+    const std::chrono::nanoseconds burst_threshold,
+    const std::chrono::nanoseconds gap_threshold,
+    const moving_average_statistics::WriterMode writer_mode =
+    moving_average_statistics::WriterMode::kMultiWriter)
+  : ReceivedMessagePeriodCollector<T>{writer_mode},
+    expected_period_nanoseconds_{expected_period.count()},
+    burst_threshold_nanoseconds_{burst_threshold.count()},
+    gap_threshold_nanoseconds_{gap_threshold.count()}
+  {
+    if (expected_period.count() <= 0) {
+      throw std::invalid_argument{"expected_period must be positive"};
+    }
+    if (burst_threshold > gap_threshold) {
+      throw std::invalid_argument{"burst_threshold must not be above gap_threshold"};
+    }
+  }
+
+  virtual ~ReceivedMessageJitterCollector() = default;
+
+  /**
+   * Handle a message received and measure the jitter of its received period. This member is
+   * thread safe and acquires at most one lock, see ReceivedMessagePeriodCollector.
+   *
+   * @param received_message
+   * @param now_nanoseconds time the message was received in nanoseconds
+   */
+  void OnMessageReceived(const T & received_message, const rcl_time_point_value_t now_nanoseconds)
+  override
+  {
+    (void) received_message;
+
+    this->ObserveAndMeasureMessage(
+      [now_nanoseconds]() {return now_nanoseconds;},
+      [this](const rcl_duration_value_t period) {CountBurstOrGap(period);},
+      [this](const rcl_duration_value_t period) {return MeasureJitter(period);});
+  }
+
+  /**
+   * Handle a message received and measure the jitter of its received period, stamping it with the
+   * time source of this collector, see ReceivedMessagePeriodCollector::SetTimeSource.
+   *
+   * @param received_message
+   */
+  void OnMessageReceived(const T & received_message)
+  {
+    (void) received_message;
+
+    this->ObserveAndMeasureMessage(
+      [this]() {return this->GetTimeSource().Now();},
+      [this](const rcl_duration_value_t period) {CountBurstOrGap(period);},
+      [this](const rcl_duration_value_t period) {return MeasureJitter(period);});
+  }
+
+  /**
+   * Return the expected period the jitter is measured against.
+   *
+   * @return the expected period
+   */
+  std::chrono::nanoseconds GetExpectedPeriod() const
+  {
+    return std::chrono::nanoseconds{expected_period_nanoseconds_};
+  }
+
+  /**
+   * Return the number of periods shorter than the burst threshold since construction.
+   *
+   * @return the burst count
+   */
+  uint64_t GetBurstCount() const
+  {
+    return burst_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the number of periods longer than the gap threshold since construction.
+   *
+   * @return the gap count
+   */
+  uint64_t GetGapCount() const
+  {
+    return gap_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the longest gap since construction, to tell a short stall from starvation.
+   *
+   * @return the longest period longer than the gap threshold, or zero if there was no gap
+   */
+  std::chrono::nanoseconds GetLongestGap() const
+  {
+    return std::chrono::nanoseconds{longest_gap_nanoseconds_.load(std::memory_order_relaxed)};
+  }
+
+  /**
+   * Return the time since the last message, the gap that is still open, e.g. to alert on a topic
+   * that stopped publishing. This does not take a lock.
+   *
+   * @param now_nanoseconds the current time, of the same clock as the messages were stamped with
+   * @return the time since the last message, or zero if no message was received since Start
+   */
+  std::chrono::nanoseconds GetTimeSinceLastMessage(const rcl_time_point_value_t now_nanoseconds)
+  const
+  {
+    const rcl_time_point_value_t time_last_message_received = this->GetTimeLastMessageReceived();
+    if (time_last_message_received == kUninitializedTime ||
+      now_nanoseconds < time_last_message_received)
+    {
+      return std::chrono::nanoseconds::zero();
+    }
+    return std::chrono::nanoseconds{now_nanoseconds - time_last_message_received};
+  }
+
+  /**
+   * Return the time since the last message, measured with the time source of this collector, for
+   * messages stamped by it, see OnMessageReceived(const T &).
+   *
+   * @return the time since the last message, or zero if no message was received since Start
+   */
+  std::chrono::nanoseconds GetTimeSinceLastMessage() const
+  {
+    return GetTimeSinceLastMessage(this->GetTimeSource().Now());
+  }
+
+  /**
+   * Return message period deviation metric name
+   *
+   * @return a string representing message period deviation metric name
+   */
+  std::string GetMetricName() const override
+  {
+    return topic_statistics_constants::kMsgPeriodDeviationStatName;
+  }
+
+  /**
+   * Return message period deviation metric unit
+   *
+   * @return a string representing message period deviation metric unit
+   */
+  std::string GetMetricUnit() const override
+  {
+    return topic_statistics_constants::kMillisecondUnitName;
+  }
+
+  std::string_view GetMetricNameView() const override
+  {
+    return topic_statistics_constants::kMsgPeriodDeviationStatName;
+  }
+
+  std::string_view GetMetricUnitView() const override
+  {
+    return topic_statistics_constants::kMillisecondUnitName;
+  }
+
+private:
+  /**
+   * Count a period as a burst or gap if it is one. The writes of the period collector are
+   * serialized, so the counters are incremented without a read-modify-write.
+   */
+  void CountBurstOrGap(const rcl_duration_value_t period_nanoseconds)
+  {
+    if (period_nanoseconds < burst_threshold_nanoseconds_) {
+      Increment(burst_count_);
+    } else if (period_nanoseconds > gap_threshold_nanoseconds_) {
+      Increment(gap_count_);
+      if (period_nanoseconds > longest_gap_nanoseconds_.load(std::memory_order_relaxed)) {
+        longest_gap_nanoseconds_.store(period_nanoseconds, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Return the jitter of a sampled period in nanoseconds.
+   */
+  rcl_duration_value_t MeasureJitter(const rcl_duration_value_t period_nanoseconds) const
+  {
+    return std::abs(period_nanoseconds - expected_period_nanoseconds_);
+  }
+
+  static void Increment(std::atomic<uint64_t> & counter)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  const rcl_duration_value_t expected_period_nanoseconds_;
+  const rcl_duration_value_t burst_threshold_nanoseconds_;
+  const rcl_duration_value_t gap_threshold_nanoseconds_;
+  std::atomic<uint64_t> burst_count_{0};
+  std::atomic<uint64_t> gap_count_{0};
+  std::atomic<rcl_duration_value_t> longest_gap_nanoseconds_{0};
+};
+
+/**
+ * A ReceivedMessageJitterCollector that cannot be derived from, see
+ * FinalReceivedMessageAgeCollector.
+ *
+ * @tparam T the message type to receive from the subscriber / listener
+ */
+template<typename T>
+class FinalReceivedMessageJitterCollector final : public ReceivedMessageJitterCollector<T>
+{
+public:
+  using ReceivedMessageJitterCollector<T>::ReceivedMessageJitterCollector;
+};
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_JITTER_HPP_
@@ -0,0 +1,414 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_RATE_HPP_
+#define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_RATE_HPP_
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "constants.hpp"
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/topic_statistics_collector/steady_time_source.hpp"
+#include "libstatistics_collector/topic_statistics_collector/topic_statistics_collector.hpp"
+
+#include "rcl/time.h"
+#include "rcl/types.h"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+/**
+ * Return a boolean flag indicating the serialized size is unknown and zero, for messages whose
+ * serialized size is not known without serializing them. Specializations returning the size set
+ * known to true.
+ */
+template<typename M>
+struct SerializedSize
+{
+  /// Whether value returns the serialized size of any message, known at compile time
+  static constexpr bool known = false;
+
+  static std::pair<bool, size_t> value(const M &)
+  {
+    return std::make_pair(false, 0);
+  }
+};
+
+/**
+ * Returns the size of a serialized message, e.g. from a generic subscription.
+ */
+template<>
+struct SerializedSize<rcl_serialized_message_t>
+{
+  static constexpr bool known = true;
+
+  static std::pair<bool, size_t> value(const rcl_serialized_message_t & m)
+  {
+    return std::make_pair(true, m.buffer_length);
+  }
+};
+
+/**
+ * The message rate and bandwidth of a window.
+ */
+struct RateData
+{
+  /// number of messages received in the window
+  uint64_t message_count = 0;
+  /// number of serialized bytes received in the window, 0 if the bandwidth is not measured
+  uint64_t byte_count = 0;
+  /// messages per second, NaN if the window is empty
+  double message_rate = std::nan("");
+  /// serialized bytes per second, NaN if the window is empty or the bandwidth is not measured
+  double byte_rate = std::nan("");
+};
+
+/**
+ * Class used to measure the rate and bandwidth of the messages, tparam T, received from a ROS2
+ * subscriber, for when the distribution of the message periods is not needed.
+ *
+ * OnMessageReceived only increments a message counter, and for serialized messages a byte
+ * counter, with relaxed atomics: no time stamp is read and no statistics are updated per
+ * message. The rates are derived when a window ends, from the counts since the previous window
+ * and the duration of the window. All messages are counted regardless of the sampling policy.
+ *
+ * GetStatisticsResults and GetStatisticsAndReset report the message rate in hertz as the average,
+ * min and max of a StatisticData over the window measured with the time source of this
+ * collector, see SetTimeSource. A window yields a single rate, so the sample count is 1, or 0 if
+ * the window has no duration, and the standard deviation is NaN. Use GetRateAndReset or
+ * GenerateStatisticMessages to derive the rates from the caller's window bounds instead, and to
+ * get the bandwidth and the message count.
+ *
+ * @tparam T the message type to receive from the subscriber / listener
+ */
+template<typename T>
+class ReceivedMessageRateCollector : public TopicStatisticsCollector<T>
+{
+public:
+  /**
+   * Construct a ReceivedMessageRateCollector object.
+   *
+   * @param measure_bandwidth whether to count the serialized bytes of the messages, by default
+   * only if SerializedSize knows the size of T
+   */
+  explicit ReceivedMessageRateCollector(
+    const bool measure_bandwidth = SerializedSize<T>::known)
+  : measure_bandwidth_{measure_bandwidth}
+  {
+    window_start_ = time_source_.Now();
+  }
+
+  virtual ~ReceivedMessageRateCollector() = default;
+
+  /**
+   * Handle a message received: count it, and its serialized size if the bandwidth is measured
+   * and SerializedSize knows the size of T.
+   *
+   * @param received_message the message received
+   * @param now_nanoseconds unused, the rates are derived from the window bounds
+   */
+  void OnMessageReceived(const T & received_message, const rcl_time_point_value_t now_nanoseconds)
+  override
+  {
+    (void) now_nanoseconds;
+
+    const auto timer = this->GetInstrumentationCounters().TimeMessage();
+    this->CountMessage();
+    if (measure_bandwidth_) {
+      const auto size = SerializedSize<T>::value(received_message);
+      if (size.first) {
+        byte_count_.fetch_add(size.second, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Handle a message received whose serialized size is known to the caller, e.g. from the
+   * middleware.
+   *
+   * @param received_message the message received
+   * @param serialized_size the serialized size of the message in bytes
+   */
+  void OnSerializedMessageReceived(const T & received_message, const size_t serialized_size)
+  {
+    (void) received_message;
+
+    const auto timer = this->GetInstrumentationCounters().TimeMessage();
+    this->CountMessage();
+    if (measure_bandwidth_) {
+      byte_count_.fetch_add(serialized_size, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Return whether the serialized bytes of the messages are counted.
+   *
+   * @return true if the bandwidth is measured
+   */
+  bool IsBandwidthMeasured() const
+  {
+    return measure_bandwidth_;
+  }
+
+  /**
+   * Set the time source measuring the windows of GetStatisticsResults and GetStatisticsAndReset.
+   * This member is not thread safe: it must be called before messages are received.
+   *
+   * @param time_source the time source, std::chrono::steady_clock by default
+   */
+  void SetTimeSource(const SteadyTimeSource & time_source)
+  {
+    std::lock_guard<std::mutex> guard{window_mutex_};
+    time_source_ = time_source;
+    window_start_ = time_source_.Now();
+  }
+
+  /**
+   * Return the rates of the window since the previous reset, without resetting it.
+   *
+   * @param window_duration duration of the window in nanoseconds
+   * @return the rates of the window
+   */
+  RateData GetRateResults(const rcl_duration_value_t window_duration) const
+  {
+    std::lock_guard<std::mutex> guard{window_mutex_};
+    return MakeRateData(ReadTotals(), window_duration);
+  }
+
+  /**
+   * Return the rates of the window since the previous reset and start a new window, without
+   * losing any message received concurrently.
+   *
+   * @param window_duration duration of the window in nanoseconds, e.g. the difference of the
+   * window bounds of the published message
+   * @return the rates of the window
+   */
+  RateData GetRateAndReset(const rcl_duration_value_t window_duration)
+  {
+    std::lock_guard<std::mutex> guard{window_mutex_};
+    const auto totals = ReadTotals();
+    const auto rate = MakeRateData(totals, window_duration);
+    StartWindow(totals, time_source_.Now());
+    return rate;
+  }
+
+  /**
+   * Return the rate message, followed by the bandwidth message if the bandwidth is measured, of
+   * the window since the previous reset, and start a new window. Unlike in GetStatisticsResults,
+   * the sample count of the messages is the number of messages received in the window.
+   *
+   * @param node_name the name of the node that the data originates from
+   * @param window_start measurement window start time
+   * @param window_stop measurement window end time
+   * @return the rate and bandwidth messages
+   */
+  std::vector<statistics_msgs::msg::MetricsMessage> GenerateStatisticMessages(
+    const std::string & node_name,
+    const builtin_interfaces::msg::Time window_start,
+    const builtin_interfaces::msg::Time window_stop)
+  {
+    const auto rate = GetRateAndReset(ToNanoseconds(window_stop) - ToNanoseconds(window_start));
+    auto message_rate = ToStatisticData(rate.message_rate);
+    message_rate.sample_count = rate.message_count;
+    std::vector<statistics_msgs::msg::MetricsMessage> messages;
+    messages.push_back(
+      collector::GenerateStatisticMessage(
+        node_name, topic_statistics_constants::kMsgRateStatName,
+        topic_statistics_constants::kHertzUnitName, window_start, window_stop, message_rate));
+    if (measure_bandwidth_) {
+      auto byte_rate = ToStatisticData(rate.byte_rate);
+      byte_rate.sample_count = rate.message_count;
+      messages.push_back(
+        collector::GenerateStatisticMessage(
+          node_name, topic_statistics_constants::kMsgBandwidthStatName,
+          topic_statistics_constants::kBytesPerSecondUnitName, window_start, window_stop,
+          byte_rate));
+    }
+    return messages;
+  }
+
+  /**
+   * Return the message rate of the window since the previous reset, measured with the time
+   * source of this collector.
+   *
+   * @return StatisticData of the message rate in hertz
+   */
+  moving_average_statistics::StatisticData GetStatisticsResults() const override
+  {
+    std::lock_guard<std::mutex> guard{window_mutex_};
+    const auto rate = MakeRateData(ReadTotals(), time_source_.Now() - window_start_);
+    return ToStatisticData(rate.message_rate);
+  }
+
+  moving_average_statistics::StatisticData GetStatisticsAndReset() override
+  {
+    std::lock_guard<std::mutex> guard{window_mutex_};
+    const auto totals = ReadTotals();
+    const auto now = time_source_.Now();
+    const auto rate = MakeRateData(totals, now - window_start_);
+    StartWindow(totals, now);
+    return ToStatisticData(rate.message_rate);
+  }
+
+  void ClearCurrentMeasurements() override
+  {
+    std::lock_guard<std::mutex> guard{window_mutex_};
+    StartWindow(ReadTotals(), time_source_.Now());
+  }
+
+  /**
+   * Return message rate metric name
+   *
+   * @return a string representing message rate metric name
+   */
+  std::string GetMetricName() const override
+  {
+    return topic_statistics_constants::kMsgRateStatName;
+  }
+
+  /**
+   * Return message rate metric unit
+   *
+   * @return a string representing message rate metric unit
+   */
+  std::string GetMetricUnit() const override
+  {
+    return topic_statistics_constants::kHertzUnitName;
+  }
+
+  std::string_view GetMetricNameView() const override
+  {
+    return topic_statistics_constants::kMsgRateStatName;
+  }
+
+  std::string_view GetMetricUnitView() const override
+  {
+    return topic_statistics_constants::kHertzUnitName;
+  }
+
+protected:
+  /**
+   * Start a new window.
+   * @return true
+   */
+  bool SetupStart() override
+  {
+    ClearCurrentMeasurements();
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+
+private:
+  /**
+   * The message and byte counts since construction
+   */
+  struct Totals
+  {
+    uint64_t message_count;
+    uint64_t byte_count;
+  };
+
+  Totals ReadTotals() const
+  {
+    return Totals{this->GetMessageCount(), byte_count_.load(std::memory_order_relaxed)};
+  }
+
+  /**
+   * Derive the rates of the window from the counts since its start.
+   */
+  RateData MakeRateData(const Totals & totals, const rcl_duration_value_t window_duration) const
+  {
+    RateData rate;
+    rate.message_count = totals.message_count - window_start_totals_.message_count;
+    rate.byte_count = totals.byte_count - window_start_totals_.byte_count;
+    if (window_duration > 0) {
+      const double seconds = static_cast<double>(window_duration) * 1e-9;
+      rate.message_rate = static_cast<double>(rate.message_count) / seconds;
+      if (measure_bandwidth_) {
+        rate.byte_rate = static_cast<double>(rate.byte_count) / seconds;
+      }
+    }
+    return rate;
+  }
+
+  void StartWindow(const Totals & totals, const rcl_time_point_value_t now)
+  {
+    window_start_totals_ = totals;
+    window_start_ = now;
+  }
+
+  /**
+   * Report the rate of a window as a single sample: the spread of one value is undefined.
+   */
+  static moving_average_statistics::StatisticData ToStatisticData(const double rate)
+  {
+    moving_average_statistics::StatisticData statistics;
+    statistics.average = rate;
+    statistics.min = rate;
+    statistics.max = rate;
+    statistics.sample_count = std::isnan(rate) ? 0 : 1;
+    return statistics;
+  }
+
+  static rcl_time_point_value_t ToNanoseconds(const builtin_interfaces::msg::Time & time)
+  {
+    return RCL_S_TO_NS(static_cast<rcl_time_point_value_t>(time.sec)) + time.nanosec;
+  }
+
+  const bool measure_bandwidth_;
+  /// Counts the serialized bytes since construction, the messages are counted by the base class
+  std::atomic<uint64_t> byte_count_{0};
+
+  /// Guards the window start, only taken when a window ends
+  mutable std::mutex window_mutex_;
+  SteadyTimeSource time_source_;
+  rcl_time_point_value_t window_start_ = 0;
+  Totals window_start_totals_{0, 0};
+};
+
+/**
+ * A ReceivedMessageRateCollector that cannot be derived from, see
+ * FinalReceivedMessageAgeCollector.
+ *
+ * @tparam T the message type to receive from the subscriber / listener
+ */
+template<typename T>
+class FinalReceivedMessageRateCollector final : public ReceivedMessageRateCollector<T>
+{
+public:
+  using ReceivedMessageRateCollector<T>::ReceivedMessageRateCollector;
+};
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_RATE_HPP_
@@ -0,0 +1,510 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_STATISTICS_HPP_
+#define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_STATISTICS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "constants.hpp"
+#include "received_message_age.hpp"
+#include "received_message_period.hpp"
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "rcl/time.h"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+/**
+ * The metrics measured by ReceivedMessageStatisticsCollector.
+ */
+enum class ReceivedMessageMetric : size_t
+{
+  /// Age of the message header stamp when received, as ReceivedMessageAgeCollector
+  kAge,
+  /// Time between consecutive messages, as ReceivedMessagePeriodCollector
+  kPeriod,
+  /// Absolute difference between consecutive periods, optional
+  kJitter
+};
+
+/// Number of ReceivedMessageMetric values
+constexpr const size_t kReceivedMessageMetricCount = 3;
+
+/**
+ * Return the name of a metric of ReceivedMessageStatisticsCollector.
+ *
+ * @param metric the metric
+ * @return the metric name, as used in the MetricsMessage
+ */
+inline std::string_view GetReceivedMessageMetricName(const ReceivedMessageMetric metric)
+{
+  switch (metric) {
+    case ReceivedMessageMetric::kAge:
+      return topic_statistics_constants::kMsgAgeStatName;
+    case ReceivedMessageMetric::kPeriod:
+      return topic_statistics_constants::kMsgPeriodStatName;
+    case ReceivedMessageMetric::kJitter:
+      return topic_statistics_constants::kMsgJitterStatName;
+  }
+  return {};
+}
+
+/**
+ * Return the unit of a metric of ReceivedMessageStatisticsCollector.
+ *
+ * @param metric the metric
+ * @return the metric unit, as used in the MetricsMessage
+ */
+inline std::string_view GetReceivedMessageMetricUnit(const ReceivedMessageMetric metric)
+{
+  (void) metric;  // all metrics are durations
+  return topic_statistics_constants::kMillisecondUnitName;
+}
+
+/**
+ * The age or jitter of a ReceivedMessageStatisticsCollector as a collector of its own, e.g. to
+ * register it with a collector::CollectorRegistry next to the ReceivedMessageStatisticsCollector,
+ * which is the collector of the period. It is measured by its ReceivedMessageStatisticsCollector
+ * only, in the critical section of the period, so its moving average runs in
+ * moving_average_statistics::WriterMode::kSingleWriter: do not call AcceptData. Its statistics
+ * may be read and reset from any thread. It is started and stopped with its
+ * ReceivedMessageStatisticsCollector, and may outlive it.
+ */
+class ReceivedMessageMetricCollector final : public collector::Collector
+{
+public:
+  /**
+   * Construct the collector of a metric.
+   *
+   * @param metric the metric measured
+   */
+  explicit ReceivedMessageMetricCollector(const ReceivedMessageMetric metric)
+  : collector::Collector{moving_average_statistics::WriterMode::kSingleWriter},
+    metric_{metric} {}
+
+  /**
+   * Return the statistics of the metric, with the sample rate of the sampling policy of its
+   * ReceivedMessageStatisticsCollector.
+   *
+   * @return StatisticData of the measured messages
+   */
+  moving_average_statistics::StatisticData GetStatisticsResults() const override
+  {
+    auto statistics = collector::Collector::GetStatisticsResults();
+    statistics.sample_rate = sample_rate_;
+    return statistics;
+  }
+
+  moving_average_statistics::StatisticData GetStatisticsAndReset() override
+  {
+    auto statistics = collector::Collector::GetStatisticsAndReset();
+    statistics.sample_rate = sample_rate_;
+    return statistics;
+  }
+
+  /**
+   * Return the metric measured.
+   *
+   * @return the metric
+   */
+  ReceivedMessageMetric GetMetric() const
+  {
+    return metric_;
+  }
+
+  std::string GetMetricName() const override
+  {
+    return std::string{GetReceivedMessageMetricName(metric_)};
+  }
+
+  std::string GetMetricUnit() const override
+  {
+    return std::string{GetReceivedMessageMetricUnit(metric_)};
+  }
+
+  std::string_view GetMetricNameView() const override
+  {
+    return GetReceivedMessageMetricName(metric_);
+  }
+
+  std::string_view GetMetricUnitView() const override
+  {
+    return GetReceivedMessageMetricUnit(metric_);
+  }
+
+private:
+  template<typename T>
+  friend class ReceivedMessageStatisticsCollector;
+
+  using collector::Collector::AcceptNanoseconds;
+  using collector::Collector::GetInstrumentationCounters;
+
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+
+  const ReceivedMessageMetric metric_;
+  /// The sample rate of the ReceivedMessageStatisticsCollector, set before messages are received
+  double sample_rate_ = 1.0;
+};
+
+/**
+ * Class used to measure the age, period, and optionally jitter of received messages, tparam T, from
+ * a ROS2 subscriber in a single OnMessageReceived call. This replaces a separate
+ * ReceivedMessageAgeCollector and ReceivedMessagePeriodCollector per topic: all metrics are
+ * measured in the one critical section of ReceivedMessagePeriodCollector, with its writer modes,
+ * sampling, time source and discarding of periods, see SetMaxPeriod. A discarded period is not a
+ * previous period of the jitter either.
+ *
+ * The metrics are message age and period in milliseconds, as measured by
+ * ReceivedMessageAgeCollector and ReceivedMessagePeriodCollector, and jitter: the absolute
+ * difference between a period and the previous one, in milliseconds, published as
+ * kMsgJitterStatName. ReceivedMessageJitterCollector instead measures the difference from an
+ * expected period, published as kMsgPeriodDeviationStatName. When jitter is measured, every
+ * message is stamped, so that the previous period is known whatever the sampling policy.
+ *
+ * This collector is the collector of the period. The age and jitter are collectors of their own,
+ * see GetAgeCollector and GetJitterCollector, so that each metric can be registered with a
+ * collector::CollectorRegistry, an exporter or an aggregation tree. Statistics are reported per
+ * metric, e.g. as one MetricsMessage each.
+ *
+ * @tparam T the message type to receive from the subscriber / listener
+ */
+template<typename T>
+class ReceivedMessageStatisticsCollector : public ReceivedMessagePeriodCollector<T>
+{
+public:
+  using ReceivedMessagePeriodCollector<T>::GetMetricName;
+  using ReceivedMessagePeriodCollector<T>::GetMetricUnit;
+  using ReceivedMessagePeriodCollector<T>::GetStatisticsResults;
+
+  /**
+   * Construct a collector measuring age and period, and jitter if requested.
+   *
+   * @param measure_jitter whether to also measure the message jitter
+   * @param writer_mode the writer mode of the period, see ReceivedMessagePeriodCollector
+   */
+  explicit ReceivedMessageStatisticsCollector(
+    const bool measure_jitter = false,
+    const moving_average_statistics::WriterMode writer_mode =
+    moving_average_statistics::WriterMode::kMultiWriter)
+  : ReceivedMessagePeriodCollector<T>{writer_mode},
+    age_{std::make_shared<ReceivedMessageMetricCollector>(ReceivedMessageMetric::kAge)},
+    jitter_{measure_jitter ?
+      std::make_shared<ReceivedMessageMetricCollector>(ReceivedMessageMetric::kJitter) : nullptr}
+  {
+  }
+
+  virtual ~ReceivedMessageStatisticsCollector() = default;
+
+  /**
+   * Handle a message received and measure all metrics in one critical section.
+   *
+   * @param received_message the message to calculate the age of
+   * @param now_nanoseconds time the message was received in nanoseconds
+   */
+  void OnMessageReceived(const T & received_message, const rcl_time_point_value_t now_nanoseconds)
+  override
+  {
+    MeasureMessage(received_message, [now_nanoseconds]() {return now_nanoseconds;});
+  }
+
+  /**
+   * Handle a message received and measure all metrics, stamping it with the time source of this
+   * collector, see ReceivedMessagePeriodCollector::SetTimeSource. The age is only meaningful if
+   * the message stamps come from the same clock.
+   *
+   * @param received_message the message to calculate the age of
+   */
+  void OnMessageReceived(const T & received_message)
+  {
+    MeasureMessage(received_message, [this]() {return this->GetTimeSource().Now();});
+  }
+
+  /**
+   * Set the policy deciding which received messages are measured, for all metrics. This member is
+   * not thread safe: it must be called before messages are received.
+   *
+   * @param sampling_policy the sampling policy, measuring every message by default
+   */
+  void SetSamplingPolicy(const SamplingPolicy & sampling_policy)
+  {
+    TopicStatisticsCollector<T>::SetSamplingPolicy(sampling_policy);
+    for (auto * metric_collector : {age_.get(), jitter_.get()}) {
+      if (metric_collector) {
+        metric_collector->sample_rate_ = sampling_policy.GetSampleRate();
+      }
+    }
+  }
+
+  /**
+   * Return the collector of the message age, e.g. to register it with a
+   * collector::CollectorRegistry next to this collector, the collector of the period.
+   *
+   * @return the collector of the age
+   */
+  std::shared_ptr<ReceivedMessageMetricCollector> GetAgeCollector() const
+  {
+    return age_;
+  }
+
+  /**
+   * Return the collector of the jitter, see GetAgeCollector.
+   *
+   * @return the collector of the jitter, or null if jitter is not measured
+   */
+  std::shared_ptr<ReceivedMessageMetricCollector> GetJitterCollector() const
+  {
+    return jitter_;
+  }
+
+  /**
+   * Return the statistics of the given metric. The jitter statistics are NaN with a sample count
+   * of 0 if jitter is not measured.
+   *
+   * @param metric the metric to return the statistics of
+   * @return the StatisticData of the metric
+   */
+  moving_average_statistics::StatisticData GetStatisticsResults(
+    const ReceivedMessageMetric metric) const
+  {
+    if (metric == ReceivedMessageMetric::kPeriod) {
+      return GetStatisticsResults();
+    }
+    const auto * metric_collector = GetMetricCollector(metric);
+    return metric_collector ?
+           metric_collector->GetStatisticsResults() : moving_average_statistics::StatisticData{};
+  }
+
+  /**
+   * Return the statistics of all metrics and reset them. Each metric is read and reset at once,
+   * so that no measurement is lost, but a message measured concurrently may be in the window of
+   * one metric and not of another.
+   *
+   * @return the StatisticData of all metrics, indexed by ReceivedMessageMetric
+   */
+  std::array<moving_average_statistics::StatisticData, kReceivedMessageMetricCount>
+  GetAllStatisticsAndReset()
+  {
+    std::array<moving_average_statistics::StatisticData, kReceivedMessageMetricCount> results;
+    for (size_t i = 0; i < kReceivedMessageMetricCount; i++) {
+      const auto metric = static_cast<ReceivedMessageMetric>(i);
+      if (metric == ReceivedMessageMetric::kPeriod) {
+        results[i] = this->GetStatisticsAndReset();
+      } else if (auto * metric_collector = GetMetricCollector(metric)) {
+        results[i] = metric_collector->GetStatisticsAndReset();
+      }
+    }
+    return results;
+  }
+
+  /**
+   * Generate one MetricsMessage per measured metric from the statistics of the window, and reset
+   * them for the next window, see GetAllStatisticsAndReset.
+   *
+   * @param node_name the name of the node that the data originates from
+   * @param window_start measurement window start time
+   * @param window_stop measurement window end time
+   * @return the age and period messages, followed by the jitter message if measured
+   */
+  std::vector<statistics_msgs::msg::MetricsMessage> GenerateStatisticMessages(
+    const std::string & node_name,
+    const builtin_interfaces::msg::Time window_start,
+    const builtin_interfaces::msg::Time window_stop)
+  {
+    const auto results = GetAllStatisticsAndReset();
+    std::vector<statistics_msgs::msg::MetricsMessage> messages;
+    messages.reserve(kReceivedMessageMetricCount);
+    for (size_t i = 0; i < kReceivedMessageMetricCount; i++) {
+      const auto metric = static_cast<ReceivedMessageMetric>(i);
+      if (!IsMeasured(metric)) {
+        continue;
+      }
+      messages.push_back(
+        collector::GenerateStatisticMessage(
+          node_name, std::string{GetMetricName(metric)}, std::string{GetMetricUnit(metric)},
+          window_start, window_stop, results[i]));
+    }
+    return messages;
+  }
+
+  /**
+   * Clear / reset all current measurements.
+   */
+  void ClearCurrentMeasurements() override
+  {
+    ReceivedMessagePeriodCollector<T>::ClearCurrentMeasurements();
+    age_->ClearCurrentMeasurements();
+    if (jitter_) {
+      jitter_->ClearCurrentMeasurements();
+    }
+  }
+
+  /**
+   * Return whether the given metric is measured.
+   *
+   * @param metric the metric
+   * @return true for age and period, and for jitter if requested at construction
+   */
+  bool IsMeasured(const ReceivedMessageMetric metric) const
+  {
+    return metric != ReceivedMessageMetric::kJitter || jitter_;
+  }
+
+  /**
+   * Return the name of the given metric, see GetReceivedMessageMetricName.
+   *
+   * @param metric the metric
+   * @return the metric name, as used in the MetricsMessage
+   */
+  static std::string_view GetMetricName(const ReceivedMessageMetric metric)
+  {
+    return GetReceivedMessageMetricName(metric);
+  }
+
+  /**
+   * Return the unit of the given metric, see GetReceivedMessageMetricUnit.
+   *
+   * @param metric the metric
+   * @return the metric unit, as used in the MetricsMessage
+   */
+  static std::string_view GetMetricUnit(const ReceivedMessageMetric metric)
+  {
+    return GetReceivedMessageMetricUnit(metric);
+  }
+
+protected:
+  /**
+   * Start the period, as ReceivedMessagePeriodCollector, and the collectors of the other metrics.
+   * @return true
+   */
+  bool SetupStart() override
+  {
+    ReceivedMessagePeriodCollector<T>::SetupStart();
+    age_->Start();
+    if (jitter_) {
+      jitter_->Start();
+    }
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    age_->Stop();
+    if (jitter_) {
+      jitter_->Stop();
+    }
+    return ReceivedMessagePeriodCollector<T>::SetupStop();
+  }
+
+private:
+  /**
+   * Measure a message received: its age if sampled, the period, and the jitter if measured, all
+   * in the critical section of ReceivedMessagePeriodCollector::HandleMessage.
+   */
+  template<typename NowT>
+  void MeasureMessage(const T & received_message, const NowT & now)
+  {
+    this->HandleMessage(
+      jitter_ != nullptr, now,
+      [this, &received_message](const bool sampled, const rcl_time_point_value_t now_nanoseconds) {
+        if (this->GetTimeLastMessageReceived() == kUninitializedTime) {
+          last_period_end_ = kUninitializedTime;  // started again, there is no previous period
+        }
+        if (sampled) {
+          MeasureAge(received_message, now_nanoseconds);
+        }
+      },
+      [this](const rcl_duration_value_t period_nanoseconds) {
+        const rcl_time_point_value_t period_end = this->GetTimeLastMessageReceived();
+        // only a period ending where the previous one did has a jitter, see MeasurePeriod
+        jitter_pending_ = last_period_end_ != kUninitializedTime &&
+          period_end - period_nanoseconds == last_period_end_;
+        jitter_nanoseconds_ = std::abs(period_nanoseconds - last_period_nanoseconds_);
+        last_period_nanoseconds_ = period_nanoseconds;
+        last_period_end_ = period_end;
+      },
+      [this](const rcl_duration_value_t period_nanoseconds) {
+        if (jitter_ && jitter_pending_) {
+          jitter_->AcceptNanoseconds(jitter_nanoseconds_);
+        }
+        return period_nanoseconds;
+      });
+  }
+
+  /**
+   * Measure the age of a sampled message if TimeStamp finds a time stamp in it, as
+   * ReceivedMessageAgeCollector.
+   */
+  void MeasureAge(const T & received_message, const rcl_time_point_value_t now_nanoseconds)
+  {
+    const auto timestamp_from_header = TimeStamp<T>::value(received_message);
+    if (!timestamp_from_header.first) {
+      return;
+    }
+    // only compare if non-zero
+    if (timestamp_from_header.second && now_nanoseconds) {
+      age_->AcceptNanoseconds(now_nanoseconds - timestamp_from_header.second);
+    } else {
+      // no valid time to compute age
+      age_->GetInstrumentationCounters().CountDroppedSamples();
+    }
+  }
+
+  /**
+   * Return the collector of the age or jitter, or null if not measured.
+   */
+  ReceivedMessageMetricCollector * GetMetricCollector(const ReceivedMessageMetric metric) const
+  {
+    return metric == ReceivedMessageMetric::kAge ? age_.get() :
+           metric == ReceivedMessageMetric::kJitter ? jitter_.get() : nullptr;
+  }
+
+  const std::shared_ptr<ReceivedMessageMetricCollector> age_;
+  /// Null unless jitter is measured
+  const std::shared_ptr<ReceivedMessageMetricCollector> jitter_;
+  /// The previous period and the time it ended, only used in the critical section of the period
+  rcl_duration_value_t last_period_nanoseconds_ = 0;
+  rcl_time_point_value_t last_period_end_ = kUninitializedTime;
+  /// Whether the period being measured has a jitter, and its value
+  bool jitter_pending_ = false;
+  rcl_duration_value_t jitter_nanoseconds_ = 0;
+};
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_MESSAGE_STATISTICS_HPP_
@@ -0,0 +1,207 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_SERIALIZED_MESSAGE_AGE_HPP_
+#define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_SERIALIZED_MESSAGE_AGE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "constants.hpp"
+
+#include "libstatistics_collector/topic_statistics_collector/topic_statistics_collector.hpp"
+
+#include "rcl/time.h"
+#include "rcl/types.h"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+/// Size of the CDR encapsulation header preceding the serialized payload
+constexpr const size_t kCdrEncapsulationHeaderSize = 4;
+/// Size of a CDR serialized builtin_interfaces/Time: int32 sec followed by uint32 nanosec
+constexpr const size_t kCdrTimeSize = 8;
+
+/**
+ * Read a builtin_interfaces/Time stamp straight from a CDR serialized message, without
+ * deserializing it. Plain CDR and XCDR2 encapsulations of either endianness are supported.
+ *
+ * @param serialized_message the serialized message, as received by a generic or serialized
+ * subscription
+ * @param stamp_offset offset of the stamp in the serialized payload, after the encapsulation
+ * header: 0 for messages starting with a std_msgs/Header
+ * @return a pair of true and the stamp in nanoseconds if it could be read, or a pair of false and
+ * 0 if the buffer is too short or the encapsulation is not supported
+ */
+inline std::pair<bool, int64_t> ReadSerializedStamp(
+  const rcl_serialized_message_t & serialized_message, const size_t stamp_offset = 0)
+{
+  const uint8_t * const buffer = serialized_message.buffer;
+  if (buffer == nullptr ||
+    serialized_message.buffer_length < kCdrEncapsulationHeaderSize ||
+    serialized_message.buffer_length - kCdrEncapsulationHeaderSize < stamp_offset ||
+    serialized_message.buffer_length - kCdrEncapsulationHeaderSize - stamp_offset < kCdrTimeSize)
+  {
+    return std::make_pair(false, 0);
+  }
+
+  // the representation identifier is big endian: 0x0000 / 0x0001 are CDR_BE / CDR_LE and
+  // 0x0006 / 0x0007 are PLAIN_CDR2_BE / PLAIN_CDR2_LE, the odd ones being little endian
+  const uint8_t representation = buffer[1];
+  if (buffer[0] != 0 || (representation != 0x00 && representation != 0x01 &&
+    representation != 0x06 && representation != 0x07))
+  {
+    return std::make_pair(false, 0);
+  }
+  const bool little_endian = (representation & 0x01) != 0;
+
+  const uint8_t * const stamp = buffer + kCdrEncapsulationHeaderSize + stamp_offset;
+  const auto read_uint32 = [little_endian](const uint8_t * const bytes) {
+      return little_endian ?
+             static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+             static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24 :
+             static_cast<uint32_t>(bytes[3]) | static_cast<uint32_t>(bytes[2]) << 8 |
+             static_cast<uint32_t>(bytes[1]) << 16 | static_cast<uint32_t>(bytes[0]) << 24;
+    };
+  const auto sec = static_cast<int32_t>(read_uint32(stamp));
+  const uint32_t nanosec = read_uint32(stamp + 4);
+  return std::make_pair(true, RCL_S_TO_NS(static_cast<int64_t>(sec)) + nanosec);
+}
+
+/**
+ * Class used to measure the age of serialized messages, e.g. from a generic or serialized
+ * subscription, without deserializing them: the header stamp is read from the CDR serialized
+ * buffer at a fixed offset, see ReadSerializedStamp. Messages whose stamp cannot be read are not
+ * measured, nor are messages with a zero stamp, as in ReceivedMessageAgeCollector.
+ *
+ * The offset of the stamp is the same for all messages of a type. It is 0 for types starting with
+ * a std_msgs/Header, the convention for stamped messages; for other types it can be determined
+ * once, e.g. from the type's introspection typesupport.
+ */
+class ReceivedSerializedMessageAgeCollector
+  : public TopicStatisticsCollector<rcl_serialized_message_t>
+{
+public:
+  /**
+   * Construct a ReceivedSerializedMessageAgeCollector object.
+   *
+   * @param stamp_offset offset of the stamp in the serialized payload, see ReadSerializedStamp
+   * @param writer_mode the writer mode of the underlying moving average statistics
+   * @throws std::invalid_argument if stamp_offset is not a multiple of 4, the CDR alignment of
+   * the stamp
+   */
+  explicit ReceivedSerializedMessageAgeCollector(
+    const size_t stamp_offset = 0,
+    const moving_average_statistics::WriterMode writer_mode =
+    moving_average_statistics::WriterMode::kMultiWriter)
+  : TopicStatisticsCollector<rcl_serialized_message_t>{writer_mode},
+    stamp_offset_{stamp_offset}
+  {
+    if (stamp_offset % 4 != 0) {
+      throw std::invalid_argument("stamp_offset must be a multiple of 4");
+    }
+  }
+
+  virtual ~ReceivedSerializedMessageAgeCollector() = default;
+
+  /**
+   * Handle a new incoming serialized message. Calculate message age if its stamp can be read.
+   *
+   * @param received_message the serialized message to calculate age of
+   * @param now_nanoseconds time the message was received in nanoseconds
+   */
+  void OnMessageReceived(
+    const rcl_serialized_message_t & received_message,
+    const rcl_time_point_value_t now_nanoseconds) override
+  {
+    const auto timer = this->GetInstrumentationCounters().TimeMessage();
+    if (!this->SampleMessage()) {
+      return;
+    }
+
+    const auto timestamp = ReadSerializedStamp(received_message, stamp_offset_);
+    // only compare if non-zero
+    if (timestamp.first && timestamp.second && now_nanoseconds) {
+      this->AcceptNanoseconds(now_nanoseconds - timestamp.second);
+    } else {
+      this->GetInstrumentationCounters().CountDroppedSamples();
+    }
+  }
+
+  /**
+   * Return the offset of the stamp in the serialized payload.
+   *
+   * @return the stamp offset
+   */
+  size_t GetStampOffset() const
+  {
+    return stamp_offset_;
+  }
+
+  /**
+   * Return message age metric name
+   *
+   * @return a string representing message age metric name
+   */
+  std::string GetMetricName() const override
+  {
+    return topic_statistics_constants::kMsgAgeStatName;
+  }
+
+  /**
+   * Return message age metric unit
+   *
+   * @return a string representing message age metric unit
+   */
+  std::string GetMetricUnit() const override
+  {
+    return topic_statistics_constants::kMillisecondUnitName;
+  }
+
+  std::string_view GetMetricNameView() const override
+  {
+    return topic_statistics_constants::kMsgAgeStatName;
+  }
+
+  std::string_view GetMetricUnitView() const override
+  {
+    return topic_statistics_constants::kMillisecondUnitName;
+  }
+
+protected:
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+
+private:
+  const size_t stamp_offset_;
+};
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__RECEIVED_SERIALIZED_MESSAGE_AGE_HPP_
@@ -0,0 +1,126 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__SAMPLING_POLICY_HPP_
+#define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__SAMPLING_POLICY_HPP_
+
+#include <cstdint>
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+/**
+ * Policy deciding which received messages a TopicStatisticsCollector measures, to bound the
+ * overhead on very high-rate topics. By default every message is measured. Otherwise either every
+ * Nth message is measured, or each message is measured independently with a given probability,
+ * drawn from a thread-local pseudo-random number generator.
+ */
+class LIBSTATISTICS_COLLECTOR_PUBLIC SamplingPolicy
+{
+public:
+  /**
+   * Construct a policy measuring every message.
+   */
+  SamplingPolicy() = default;
+
+  /**
+   * Return a policy measuring every nth message, starting with the first one.
+   *
+   * @param n the interval between measured messages, 1 to measure every message
+   * @return the sampling policy
+   * @throws std::invalid_argument if n is 0
+   */
+  static SamplingPolicy EveryNth(uint64_t n);
+
+  /**
+   * Return a policy measuring each message with the given probability.
+   *
+   * @param probability the probability to measure a message, in (0, 1]
+   * @return the sampling policy
+   * @throws std::invalid_argument if probability is not in (0, 1]
+   */
+  static SamplingPolicy Bernoulli(double probability);
+
+  /**
+   * Return whether the message with the given index is measured.
+   *
+   * @param message_index index of the message in the order of reception, counting from 0
+   * @return true if the message is measured
+   */
+  bool IsSampled(const uint64_t message_index) const
+  {
+    switch (type_) {
+      case Type::kEveryNth:
+        return message_index % every_nth_ == 0;
+      case Type::kBernoulli:
+        return (NextRandom() >> kRandomDiscardedBits) < threshold_;
+      case Type::kAll:
+      default:
+        return true;
+    }
+  }
+
+  /**
+   * Return whether every message is measured.
+   *
+   * @return true if this policy measures every message
+   */
+  bool SamplesAll() const
+  {
+    return type_ == Type::kAll;
+  }
+
+  /**
+   * Return the expected fraction of the received messages that is measured, e.g. to rescale a
+   * sample count to a message count.
+   *
+   * @return the sample rate, in (0, 1]
+   */
+  double GetSampleRate() const
+  {
+    return sample_rate_;
+  }
+
+private:
+  enum class Type
+  {
+    kAll,
+    kEveryNth,
+    kBernoulli
+  };
+
+  /// Bits dropped from the random numbers, leaving the exactly representable doubles in [0, 1)
+  static constexpr int kRandomDiscardedBits = 11;
+
+  /**
+   * Return the next number of the calling thread's xorshift64* generator.
+   */
+  static uint64_t NextRandom();
+
+  Type type_ = Type::kAll;
+  /// The interval for Type::kEveryNth
+  uint64_t every_nth_ = 1;
+  /// The probability for Type::kBernoulli, scaled to the range of the random numbers
+  uint64_t threshold_ = 0;
+  double sample_rate_ = 1.0;
+};
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__SAMPLING_POLICY_HPP_
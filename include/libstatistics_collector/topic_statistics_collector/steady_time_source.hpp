@@ -0,0 +1,89 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__STEADY_TIME_SOURCE_HPP_
+#define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__STEADY_TIME_SOURCE_HPP_
+
+#include "rcl/time.h"
+
+#include "libstatistics_collector/visibility_control.hpp"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+/**
+ * The clocks a SteadyTimeSource can read.
+ */
+enum class SteadyTimeSourceType
+{
+  /// std::chrono::steady_clock, available everywhere
+  kSteadyClock,
+  /// CLOCK_MONOTONIC_COARSE: cheaper than kSteadyClock, with a resolution of a scheduler tick
+  /// (typically 1 to 4 ms). Linux only.
+  kMonotonicCoarse,
+  /// the time stamp counter of the CPU, calibrated against kSteadyClock once per process. Only
+  /// supported with an invariant TSC, as reported by CPUID, and assumes it is synchronized across
+  /// cores, as on all recent x86 processors. x86 only.
+  kTsc
+};
+
+/**
+ * A cheap source of steady time, unaffected by ROS time and system time jumps, for collectors to
+ * stamp messages themselves instead of the caller reading a ROS clock for every message.
+ */
+class LIBSTATISTICS_COLLECTOR_PUBLIC SteadyTimeSource
+{
+public:
+  /**
+   * Construct a time source reading the given clock. A clock that is not supported on this
+   * platform is replaced with SteadyTimeSourceType::kSteadyClock, see GetType. The first
+   * construction with SteadyTimeSourceType::kTsc in a process calibrates the time stamp counter,
+   * which takes about 10 ms.
+   *
+   * @param type the clock to read
+   */
+  explicit SteadyTimeSource(SteadyTimeSourceType type = SteadyTimeSourceType::kSteadyClock);
+
+  /**
+   * Return the current time of the clock. Times of different clocks are not comparable.
+   *
+   * @return the current time in nanoseconds
+   */
+  rcl_time_point_value_t Now() const;
+
+  /**
+   * Return the clock this time source reads.
+   *
+   * @return the type of the clock, kSteadyClock if the requested clock is not supported
+   */
+  SteadyTimeSourceType GetType() const;
+
+  /**
+   * Return whether a clock is supported on this platform.
+   *
+   * @param type the clock
+   * @return true if the clock can be read, and for kTsc if the time stamp counter is invariant
+   */
+  static bool IsSupported(SteadyTimeSourceType type);
+
+private:
+  SteadyTimeSourceType type_;
+};
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
+#endif  // LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__STEADY_TIME_SOURCE_HPP_
@@ -16,12 +16,18 @@
 #ifndef LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR_HPP_
 #define LIBSTATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR__TOPIC_STATISTICS_COLLECTOR_HPP_
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "rcl/time.h"
 
 #include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/topic_statistics_collector/sampling_policy.hpp"
 
 namespace libstatistics_collector
 {
@@ -31,6 +37,13 @@ namespace topic_statistics_collector
 /**
  * Interface to collect and perform measurements for ROS2 topic statistics.
  *
+ * On very high-rate topics only a sample of the messages can be measured, see SetSamplingPolicy.
+ * The total number of messages received is still counted exactly, and the statistics state the
+ * sample rate in StatisticData::sample_rate.
+ *
+ * The sampling policy and message count take one more cache line than a collector::Collector, for
+ * 320 bytes on x86-64 with libstdc++. With instrumentation they fit in its tail padding instead.
+ *
  * @tparam T the ROS2 message type to collect
  */
 template<typename T>
@@ -39,6 +52,24 @@ class TopicStatisticsCollector : public collector::Collector
 public:
   TopicStatisticsCollector() = default;
 
+  /**
+   * Construct a collector with the given writer mode, see collector::Collector.
+   *
+   * @param writer_mode the writer mode of the underlying moving average statistics
+   */
+  explicit TopicStatisticsCollector(moving_average_statistics::WriterMode writer_mode)
+  : collector::Collector{writer_mode} {}
+
+  /**
+   * Construct a collector aggregating with the given accumulator, see collector::Collector.
+   *
+   * @param accumulator the accumulator aggregating the measurements
+   * @throws std::invalid_argument if accumulator is null
+   */
+  explicit TopicStatisticsCollector(
+    std::unique_ptr<moving_average_statistics::AccumulatorInterface> accumulator)
+  : collector::Collector{std::move(accumulator)} {}
+
   virtual ~TopicStatisticsCollector() = default;
 
   /**
@@ -52,6 +83,90 @@ public:
   virtual void OnMessageReceived(
     const T & received_message,
     const rcl_time_point_value_t now_nanoseconds) = 0;
+
+  /**
+   * Set the policy deciding which received messages are measured. This member is not thread safe:
+   * it must be called before messages are received.
+   *
+   * @param sampling_policy the sampling policy, measuring every message by default
+   */
+  void SetSamplingPolicy(const SamplingPolicy & sampling_policy)
+  {
+    sampling_policy_ = sampling_policy;
+  }
+
+  /**
+   * Return the policy deciding which received messages are measured.
+   *
+   * @return the sampling policy
+   */
+  const SamplingPolicy & GetSamplingPolicy() const
+  {
+    return sampling_policy_;
+  }
+
+  /**
+   * Return the number of messages received since construction, whether measured or not.
+   *
+   * @return the message count
+   */
+  uint64_t GetMessageCount() const
+  {
+    return message_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Return the statistics of the measured messages, with the sample rate of the sampling policy.
+   *
+   * @return StatisticData of the measured messages
+   */
+  moving_average_statistics::StatisticData GetStatisticsResults() const override
+  {
+    auto statistics = collector::Collector::GetStatisticsResults();
+    statistics.sample_rate = sampling_policy_.GetSampleRate();
+    return statistics;
+  }
+
+  moving_average_statistics::StatisticData GetStatisticsAndReset() override
+  {
+    auto statistics = collector::Collector::GetStatisticsAndReset();
+    statistics.sample_rate = sampling_policy_.GetSampleRate();
+    return statistics;
+  }
+
+  moving_average_statistics::StatisticData GetStatisticsAndHistogramAndReset(
+    std::vector<moving_average_statistics::HistogramBucket> & buckets) override
+  {
+    auto statistics = collector::Collector::GetStatisticsAndHistogramAndReset(buckets);
+    statistics.sample_rate = sampling_policy_.GetSampleRate();
+    return statistics;
+  }
+
+protected:
+  /**
+   * Count a received message and return whether it is measured according to the sampling policy.
+   * Meant to be called first by OnMessageReceived, so that a message that is not measured costs
+   * only this call.
+   *
+   * @return true if the message is to be measured
+   */
+  bool SampleMessage()
+  {
+    return sampling_policy_.IsSampled(message_count_.fetch_add(1, std::memory_order_relaxed));
+  }
+
+  /**
+   * Count a received message regardless of the sampling policy, for collectors that do not
+   * measure individual messages.
+   */
+  void CountMessage()
+  {
+    message_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  SamplingPolicy sampling_policy_;
+  std::atomic<uint64_t> message_count_{0};
 };
 
 }  // namespace topic_statistics_collector
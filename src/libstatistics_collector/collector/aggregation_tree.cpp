@@ -0,0 +1,214 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libstatistics_collector/collector/aggregation_tree.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+using moving_average_statistics::AccumulatorState;
+using moving_average_statistics::StatisticData;
+using statistics_msgs::msg::MetricsMessage;
+
+void AggregationTree::Rollup::Add(const StatisticData & data)
+{
+  if (data.sample_count == 0) {
+    return;
+  }
+  state.Merge(AccumulatorState::FromStatisticData(data));
+  const double sample_count = static_cast<double>(data.sample_count);
+  observation_count += data.sample_rate > 0 ? sample_count / data.sample_rate : sample_count;
+}
+
+void AggregationTree::Rollup::Merge(const Rollup & other)
+{
+  state.Merge(other.state);
+  observation_count += other.observation_count;
+}
+
+StatisticData AggregationTree::Rollup::ToStatisticData() const
+{
+  auto data = state.ToStatisticData();
+  if (state.count > 0 && observation_count > 0) {
+    data.sample_rate = std::min(1.0, static_cast<double>(state.count) / observation_count);
+  }
+  return data;
+}
+
+AggregationTree::AggregationTree(const std::string & node_name)
+: node_name_{node_name}
+{
+}
+
+AggregationTree::NodeId AggregationTree::AddGroup(
+  const std::string & metric_name, const std::string & metric_unit, const NodeId parent)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (parent != kNoParent && !IsGroup(parent)) {
+    throw std::invalid_argument("parent must be a group of this tree");
+  }
+  return AddNode(Node{metric_name, metric_unit, nullptr, parent, {}, false});
+}
+
+AggregationTree::NodeId AggregationTree::AddCollector(
+  std::shared_ptr<Collector> collector, const std::string & metric_name, const NodeId parent)
+{
+  if (!collector) {
+    throw std::invalid_argument("collector must not be null");
+  }
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (!IsGroup(parent)) {
+    throw std::invalid_argument("parent must be a group of this tree");
+  }
+  auto metric_unit = collector->GetMetricUnit();
+  return AddNode(
+    Node{metric_name, std::move(metric_unit), std::move(collector), parent, {}, false});
+}
+
+void AggregationTree::Remove(const NodeId id)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (id >= nodes_.size() || nodes_[id].removed) {
+    return;
+  }
+  const NodeId parent = nodes_[id].parent;
+  if (parent != kNoParent) {
+    auto & siblings = nodes_[parent].children;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), id));
+  }
+
+  std::vector<NodeId> pending{id};
+  while (!pending.empty()) {
+    Node & node = nodes_[pending.back()];
+    pending.pop_back();
+    pending.insert(pending.end(), node.children.begin(), node.children.end());
+    node.children.clear();
+    node.collector.reset();
+    node.removed = true;
+    node_count_--;
+  }
+}
+
+StatisticData AggregationTree::GetStatistics(const NodeId id) const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (id >= nodes_.size() || nodes_[id].removed) {
+    throw std::invalid_argument("id must be a node of this tree");
+  }
+  if (nodes_[id].collector) {
+    return nodes_[id].collector->GetStatisticsResults();
+  }
+  return GetRollup(id).ToStatisticData();
+}
+
+std::vector<StatisticData> AggregationTree::GetStatisticsAndReset()
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return GetStatisticsAndResetUnsynchronized();
+}
+
+std::vector<MetricsMessage> AggregationTree::GenerateStatisticMessages(
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  const auto statistics = GetStatisticsAndResetUnsynchronized();
+  std::vector<MetricsMessage> messages;
+  messages.reserve(node_count_);
+  for (NodeId id = 0; id < nodes_.size(); id++) {
+    const Node & node = nodes_[id];
+    if (!node.removed) {
+      messages.push_back(
+        GenerateStatisticMessage(
+          node_name_, node.metric_name, node.metric_unit, window_start, window_stop,
+          statistics[id]));
+    }
+  }
+  return messages;
+}
+
+size_t AggregationTree::GetNodeCount() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return node_count_;
+}
+
+AggregationTree::NodeId AggregationTree::AddNode(Node node)
+{
+  const NodeId id = nodes_.size();
+  if (node.parent != kNoParent) {
+    nodes_[node.parent].children.push_back(id);
+  }
+  nodes_.push_back(std::move(node));
+  node_count_++;
+  return id;
+}
+
+bool AggregationTree::IsGroup(const NodeId id) const
+{
+  return id < nodes_.size() && !nodes_[id].removed && !nodes_[id].collector;
+}
+
+AggregationTree::Rollup AggregationTree::GetRollup(const NodeId id) const
+{
+  const Node & node = nodes_[id];
+  Rollup rollup;
+  if (node.collector) {
+    rollup.Add(node.collector->GetStatisticsResults());
+    return rollup;
+  }
+  for (const NodeId child : node.children) {
+    rollup.Merge(GetRollup(child));
+  }
+  return rollup;
+}
+
+std::vector<StatisticData> AggregationTree::GetStatisticsAndResetUnsynchronized()
+{
+  std::vector<StatisticData> statistics(nodes_.size());
+  std::vector<Rollup> rollups(nodes_.size());
+  // children have higher ids than their parent, so a reverse sweep completes every node before
+  // merging it into its parent
+  for (NodeId id = nodes_.size(); id-- > 0; ) {
+    const Node & node = nodes_[id];
+    if (node.removed) {
+      continue;
+    }
+    if (node.collector) {
+      statistics[id] = node.collector->GetStatisticsAndReset();
+      rollups[id].Add(statistics[id]);
+    } else {
+      statistics[id] = rollups[id].ToStatisticData();
+    }
+    if (node.parent != kNoParent) {
+      rollups[node.parent].Merge(rollups[id]);
+    }
+  }
+  return statistics;
+}
+
+}  // namespace collector
+}  // namespace libstatistics_collector
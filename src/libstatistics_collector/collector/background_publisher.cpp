@@ -0,0 +1,164 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "libstatistics_collector/collector/background_publisher.hpp"
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+BackgroundPublisher::BackgroundPublisher(
+  const std::string & node_name, PublishCallback publish_callback, const Options & options)
+: node_name_{node_name},
+  publish_callback_{std::move(publish_callback)},
+  poll_period_{options.poll_period},
+  queue_{options.queue_capacity}
+{
+  if (!publish_callback_) {
+    throw std::invalid_argument("publish_callback must not be empty");
+  }
+  if (poll_period_.count() <= 0) {
+    throw std::invalid_argument("poll_period must be positive");
+  }
+}
+
+BackgroundPublisher::BackgroundPublisher(
+  const std::string & node_name, PublishCallback publish_callback)
+: BackgroundPublisher{node_name, std::move(publish_callback), Options{}}
+{
+}
+
+BackgroundPublisher::~BackgroundPublisher()
+{
+  Stop();
+}
+
+size_t BackgroundPublisher::AddMetric(
+  const std::string & metric_name, const std::string & metric_unit)
+{
+  std::lock_guard<std::mutex> guard{messages_mutex_};
+  messages_.push_back(
+    GenerateStatisticMessage(
+      node_name_, metric_name, metric_unit, builtin_interfaces::msg::Time{},
+      builtin_interfaces::msg::Time{}, moving_average_statistics::StatisticData{}));
+  metric_count_.store(messages_.size(), std::memory_order_release);
+  return messages_.size() - 1;
+}
+
+bool BackgroundPublisher::Submit(
+  const size_t metric_id, const builtin_interfaces::msg::Time & window_start,
+  const builtin_interfaces::msg::Time & window_stop,
+  const moving_average_statistics::StatisticData & statistics)
+{
+  if (metric_id >= metric_count_.load(std::memory_order_acquire) ||
+    !queue_.TryPush(Snapshot{metric_id, window_start, window_stop, statistics}))
+  {
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+bool BackgroundPublisher::Start()
+{
+  std::lock_guard<std::mutex> guard{thread_mutex_};
+  if (thread_.joinable()) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> wake_guard{wake_mutex_};
+    running_ = true;
+  }
+  thread_ = std::thread{&BackgroundPublisher::Run, this};
+  started_.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+bool BackgroundPublisher::Stop()
+{
+  std::lock_guard<std::mutex> guard{thread_mutex_};
+  if (!thread_.joinable()) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> wake_guard{wake_mutex_};
+    running_ = false;
+  }
+  wake_condition_.notify_one();
+  thread_.join();
+  started_.store(false, std::memory_order_relaxed);
+  return true;
+}
+
+bool BackgroundPublisher::IsStarted() const
+{
+  return started_.load(std::memory_order_relaxed);
+}
+
+uint64_t BackgroundPublisher::GetPublishedCount() const
+{
+  return published_count_.load(std::memory_order_relaxed);
+}
+
+uint64_t BackgroundPublisher::GetDroppedCount() const
+{
+  return dropped_count_.load(std::memory_order_relaxed);
+}
+
+uint64_t BackgroundPublisher::GetPublishFailureCount() const
+{
+  return publish_failure_count_.load(std::memory_order_relaxed);
+}
+
+void BackgroundPublisher::Run()
+{
+  bool running = true;
+  while (running) {
+    PublishSubmitted();
+    std::unique_lock<std::mutex> lock{wake_mutex_};
+    running = !wake_condition_.wait_for(lock, poll_period_, [this]() {return !running_;});
+  }
+  // publish what was submitted before Stop
+  PublishSubmitted();
+}
+
+void BackgroundPublisher::PublishSubmitted()
+{
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> guard{messages_mutex_};
+  while (queue_.TryPop(snapshot)) {
+    auto & msg = messages_[snapshot.metric_id];
+    UpdateStatisticMessage(msg, snapshot.window_start, snapshot.window_stop, snapshot.statistics);
+    try {
+      publish_callback_(msg);
+      published_count_.fetch_add(1, std::memory_order_relaxed);
+    } catch (...) {
+      publish_failure_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace collector
+}  // namespace libstatistics_collector
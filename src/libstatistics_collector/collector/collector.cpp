@@ -13,11 +13,23 @@
 // limitations under the License.
 
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <mutex>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/moving_average_statistics/accumulator_interface.hpp"
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
 #include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
 #include "libstatistics_collector/moving_average_statistics/types.hpp"
 
@@ -26,13 +38,31 @@ namespace libstatistics_collector
 namespace collector
 {
 
+Collector::Collector(moving_average_statistics::WriterMode writer_mode)
+: collected_data_{writer_mode}
+{
+}
+
+Collector::Collector(
+  std::unique_ptr<moving_average_statistics::AccumulatorInterface> accumulator)
+: accumulator_{std::move(accumulator)}
+{
+  if (!accumulator_) {
+    throw std::invalid_argument("accumulator must not be null");
+  }
+  exact_accumulator_ =
+    dynamic_cast<moving_average_statistics::ExactDurationStatistics *>(accumulator_.get());
+  histogram_accumulator_ =
+    dynamic_cast<moving_average_statistics::LogLinearHistogram *>(accumulator_.get());
+}
+
 bool Collector::Start()
 {
   std::unique_lock<std::mutex> ulock{mutex_};
-  if (started_) {
+  if (started_.load(std::memory_order_relaxed)) {
     return false;
   }
-  started_ = true;
+  started_.store(true, std::memory_order_release);
   return SetupStart();
 }
 
@@ -41,10 +71,10 @@ bool Collector::Stop()
   bool ret = false;
   {
     std::unique_lock<std::mutex> ulock{mutex_};
-    if (!started_) {
+    if (!started_.load(std::memory_order_relaxed)) {
       return false;
     }
-    started_ = false;
+    started_.store(false, std::memory_order_release);
 
     ret = SetupStop();
   }
@@ -52,33 +82,137 @@ bool Collector::Stop()
   return ret;
 }
 
-void Collector::AcceptData(const double measurement)
+void Collector::AcceptData(const double * measurements, size_t measurement_count)
 {
-  collected_data_.AddMeasurement(measurement);
+  const auto timer = instrumentation_.TimeAcceptData();
+  if constexpr (kInstrumentationEnabled) {
+    instrumentation_.CountDroppedSamples(
+      static_cast<uint64_t>(std::count_if(
+        measurements, measurements + measurement_count,
+        [](const double measurement) {return std::isnan(measurement);})));
+  }
+  if (accumulator_) {
+    accumulator_->AddMeasurements(measurements, measurement_count);
+  } else {
+    collected_data_.AddMeasurements(measurements, measurement_count);
+  }
+  if (quantile_sketch_) {
+    for (size_t i = 0; i < measurement_count; i++) {
+      quantile_sketch_->AddMeasurement(measurements[i]);
+    }
+  }
 }
 
 moving_average_statistics::StatisticData Collector::GetStatisticsResults() const
 {
+  if (accumulator_) {
+    return accumulator_->GetStatistics();
+  }
   return collected_data_.GetStatistics();
 }
 
+moving_average_statistics::StatisticData Collector::GetStatisticsAndReset()
+{
+  const auto data = accumulator_ ?
+    accumulator_->GetStatisticsAndReset() : collected_data_.GetStatisticsAndReset();
+  if (quantile_sketch_) {
+    quantile_sketch_->Reset();
+  }
+  return data;
+}
+
+moving_average_statistics::StatisticData Collector::GetStatisticsAndQuantilesAndReset(
+  moving_average_statistics::QuantileData & quantiles)
+{
+  // the sketch is lock-free, so measurements made concurrently may be in either window anyway
+  quantiles = GetQuantileResults();
+  return GetStatisticsAndReset();
+}
+
+moving_average_statistics::StatisticData Collector::GetStatisticsAndHistogramAndReset(
+  std::vector<moving_average_statistics::HistogramBucket> & buckets)
+{
+  if (!histogram_accumulator_) {
+    buckets.clear();
+    return GetStatisticsAndReset();
+  }
+  moving_average_statistics::LogLinearHistogram window{histogram_accumulator_->GetOptions()};
+  histogram_accumulator_->GetAndReset(window);
+  if (quantile_sketch_) {
+    quantile_sketch_->Reset();
+  }
+  buckets = window.GetBuckets();
+  return window.GetStatistics();
+}
+
+bool Collector::IsHistogramEnabled() const
+{
+  return histogram_accumulator_ != nullptr;
+}
+
+moving_average_statistics::QuantileData Collector::GetQuantileResults() const
+{
+  if (!quantile_sketch_) {
+    return moving_average_statistics::QuantileData{};
+  }
+  return quantile_sketch_->GetQuantileData();
+}
+
+void Collector::EnableQuantileEstimation(
+  const moving_average_statistics::QuantileSketch::Options & options)
+{
+  quantile_sketch_ = std::make_unique<moving_average_statistics::QuantileSketch>(options);
+}
+
+bool Collector::IsQuantileEstimationEnabled() const
+{
+  return quantile_sketch_ != nullptr;
+}
+
 void Collector::ClearCurrentMeasurements()
 {
-  collected_data_.Reset();
+  if (accumulator_) {
+    accumulator_->Reset();
+  } else {
+    collected_data_.Reset();
+  }
+  if (quantile_sketch_) {
+    quantile_sketch_->Reset();
+  }
 }
 
 bool Collector::IsStarted() const
 {
-  std::unique_lock<std::mutex> ulock{mutex_};
-  return started_;
+  return started_.load(std::memory_order_acquire);
+}
+
+InstrumentationData Collector::GetInstrumentationData() const
+{
+  InstrumentationData data = instrumentation_.GetData();
+  data.lock_contention_count += accumulator_ ?
+    accumulator_->GetLockContentionCount() : collected_data_.GetLockContentionCount();
+  return data;
 }
 
 std::string Collector::GetStatusString() const
 {
-  std::stringstream ss;
-  ss << "started=" << (IsStarted() ? "true" : "false") <<
-    ", " << StatisticsDataToString(GetStatisticsResults());
-  return ss.str();
+  char buffer[kStatusStringMaxLength];
+  return std::string{FormatStatusString(buffer, sizeof(buffer))};
+}
+
+std::string_view Collector::FormatStatusString(char * buffer, size_t buffer_size) const
+{
+  const std::string_view started = IsStarted() ? "started=true, " : "started=false, ";
+  if (buffer_size < started.size()) {
+    return {};
+  }
+  std::memcpy(buffer, started.data(), started.size());
+  const auto statistics = moving_average_statistics::StatisticsDataToString(
+    GetStatisticsResults(), buffer + started.size(), buffer_size - started.size());
+  if (statistics.empty()) {
+    return {};
+  }
+  return std::string_view{buffer, started.size() + statistics.size()};
 }
 
 }  // namespace collector
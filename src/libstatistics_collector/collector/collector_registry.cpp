@@ -0,0 +1,150 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "libstatistics_collector/collector/collector_registry.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+using statistics_msgs::msg::MetricsMessage;
+
+CollectorRegistry::CollectorRegistry(
+  const std::string & node_name,
+  const builtin_interfaces::msg::Time window_start)
+: node_name_{node_name},
+  last_window_stop_{window_start}
+{
+}
+
+CollectorRegistry::Handle CollectorRegistry::Register(std::shared_ptr<Collector> collector)
+{
+  if (!collector) {
+    throw std::invalid_argument("collector must not be null");
+  }
+  std::lock_guard<std::mutex> guard{pending_mutex_};
+  const Handle handle = next_handle_++;
+  pending_changes_.push_back(PendingChange{handle, std::move(collector)});
+  return handle;
+}
+
+void CollectorRegistry::Unregister(const Handle handle)
+{
+  std::lock_guard<std::mutex> guard{pending_mutex_};
+  pending_changes_.push_back(PendingChange{handle, nullptr});
+}
+
+const std::vector<MetricsMessage> & CollectorRegistry::GenerateStatisticMessages(
+  const builtin_interfaces::msg::Time window_stop)
+{
+  std::lock_guard<std::mutex> guard{sweep_mutex_};
+  ApplyPendingChanges();
+
+  std::vector<moving_average_statistics::HistogramBucket> buckets;
+  for (size_t i = 0; i < collectors_.size(); i++) {
+    Collector & collector = *collectors_[i];
+    moving_average_statistics::QuantileData quantiles;
+    if (collector.IsQuantileEstimationEnabled()) {
+      // as GetStatisticsAndQuantilesAndReset, which cannot also return the buckets
+      quantiles = collector.GetQuantileResults();
+    }
+    const auto data = collector.IsHistogramEnabled() ?
+      collector.GetStatisticsAndHistogramAndReset(buckets) : collector.GetStatisticsAndReset();
+    if (collector.IsQuantileEstimationEnabled()) {
+      UpdateStatisticMessage(messages_[i], window_starts_[i], window_stop, data, quantiles);
+    } else {
+      UpdateStatisticMessage(messages_[i], window_starts_[i], window_stop, data);
+    }
+    if (collector.IsHistogramEnabled()) {
+      AppendHistogramDataPoints(messages_[i], buckets);
+    }
+    window_starts_[i] = window_stop;
+  }
+  last_window_stop_ = window_stop;
+  return messages_;
+}
+
+size_t CollectorRegistry::GetCollectorCount() const
+{
+  std::lock_guard<std::mutex> guard{sweep_mutex_};
+  return collectors_.size();
+}
+
+void CollectorRegistry::ApplyPendingChanges()
+{
+  std::vector<PendingChange> changes;
+  {
+    std::lock_guard<std::mutex> guard{pending_mutex_};
+    changes.swap(pending_changes_);
+  }
+  for (auto & change : changes) {
+    if (change.collector) {
+      Add(change.handle, std::move(change.collector));
+    } else {
+      Remove(change.handle);
+    }
+  }
+}
+
+void CollectorRegistry::Add(const Handle handle, std::shared_ptr<Collector> collector)
+{
+  MetricsMessage msg;
+  msg.measurement_source_name = node_name_;
+  msg.metrics_source = collector->GetMetricName();
+  msg.unit = collector->GetMetricUnit();
+
+  indices_[handle] = collectors_.size();
+  collectors_.push_back(std::move(collector));
+  handles_.push_back(handle);
+  window_starts_.push_back(last_window_stop_);
+  messages_.push_back(std::move(msg));
+}
+
+void CollectorRegistry::Remove(const Handle handle)
+{
+  const auto it = indices_.find(handle);
+  if (it == indices_.end()) {
+    return;
+  }
+  const size_t index = it->second;
+  indices_.erase(it);
+
+  // keep the vectors dense by moving the last collector into the freed place
+  const size_t last = collectors_.size() - 1;
+  if (index != last) {
+    collectors_[index] = std::move(collectors_[last]);
+    handles_[index] = handles_[last];
+    window_starts_[index] = window_starts_[last];
+    messages_[index] = std::move(messages_[last]);
+    indices_[handles_[index]] = index;
+  }
+  collectors_.pop_back();
+  handles_.pop_back();
+  window_starts_.pop_back();
+  messages_.pop_back();
+}
+
+}  // namespace collector
+}  // namespace libstatistics_collector
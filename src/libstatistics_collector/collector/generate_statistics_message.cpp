@@ -14,8 +14,11 @@
 
 #include "libstatistics_collector/collector/generate_statistics_message.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "statistics_msgs/msg/statistic_data_type.hpp"
 
@@ -28,44 +31,164 @@ using statistics_msgs::msg::MetricsMessage;
 using statistics_msgs::msg::StatisticDataPoint;
 using statistics_msgs::msg::StatisticDataType;
 
-MetricsMessage GenerateStatisticMessage(
-  const std::string & node_name,
-  const std::string & metric_name,
-  const std::string & unit,
+namespace
+{
+
+/// Number of data points of a message without quantile estimates
+constexpr const size_t kStatisticDataPointCount = 5;
+/// Number of data points of a message with quantile estimates
+constexpr const size_t kQuantileDataPointCount = kStatisticDataPointCount + 4;
+
+void SetDataPoint(
+  MetricsMessage & msg, const size_t index, const uint8_t data_type, const double data)
+{
+  msg.statistics[index].data_type = data_type;
+  msg.statistics[index].data = data;
+}
+
+/**
+ * Write the window and the statistic data points, with room for point_count data points in total
+ * followed by the sample rate data point if the data was sampled.
+ */
+void SetStatistics(
+  MetricsMessage & msg,
+  const size_t point_count,
   const builtin_interfaces::msg::Time window_start,
   const builtin_interfaces::msg::Time window_stop,
   const libstatistics_collector::moving_average_statistics::StatisticData & data)
+{
+  msg.window_start = window_start;
+  msg.window_stop = window_stop;
+
+  // does not allocate once the message has held point_count data points
+  const bool sampled = data.sample_rate < 1;
+  msg.statistics.resize(sampled ? point_count + 1 : point_count);
+
+  SetDataPoint(msg, 0, StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE, data.average);
+  SetDataPoint(msg, 1, StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM, data.max);
+  SetDataPoint(msg, 2, StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM, data.min);
+  SetDataPoint(
+    msg, 3, StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT,
+    static_cast<double>(data.sample_count));
+  SetDataPoint(
+    msg, 4, StatisticDataType::STATISTICS_DATA_TYPE_STDDEV, data.standard_deviation);
+  if (sampled) {
+    SetDataPoint(msg, point_count, kStatisticsDataTypeSampleRate, data.sample_rate);
+  }
+}
+
+void SetQuantiles(
+  MetricsMessage & msg,
+  const libstatistics_collector::moving_average_statistics::QuantileData & quantiles)
+{
+  SetDataPoint(msg, kStatisticDataPointCount + 0, kStatisticsDataTypeP50, quantiles.p50);
+  SetDataPoint(msg, kStatisticDataPointCount + 1, kStatisticsDataTypeP90, quantiles.p90);
+  SetDataPoint(msg, kStatisticDataPointCount + 2, kStatisticsDataTypeP99, quantiles.p99);
+  SetDataPoint(msg, kStatisticDataPointCount + 3, kStatisticsDataTypeP999, quantiles.p999);
+}
+
+MetricsMessage MakeMessage(
+  const std::string & node_name,
+  const std::string & metric_name,
+  const std::string & unit)
 {
   MetricsMessage msg;
 
   msg.measurement_source_name = node_name;
   msg.metrics_source = metric_name;
   msg.unit = unit;
-  msg.window_start = window_start;
-  msg.window_stop = window_stop;
 
-  msg.statistics.reserve(5);
+  return msg;
+}
 
-  msg.statistics.emplace_back();
-  msg.statistics.back().data_type = StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE;
-  msg.statistics.back().data = data.average;
+}  // namespace
 
-  msg.statistics.emplace_back();
-  msg.statistics.back().data_type = StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM;
-  msg.statistics.back().data = data.max;
+MetricsMessage GenerateStatisticMessage(
+  const std::string & node_name,
+  const std::string & metric_name,
+  const std::string & unit,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data)
+{
+  MetricsMessage msg = MakeMessage(node_name, metric_name, unit);
+  UpdateStatisticMessage(msg, window_start, window_stop, data);
+  return msg;
+}
+
+MetricsMessage GenerateStatisticMessage(
+  const std::string & node_name,
+  const std::string & metric_name,
+  const std::string & unit,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data,
+  const libstatistics_collector::moving_average_statistics::QuantileData & quantiles)
+{
+  MetricsMessage msg = MakeMessage(node_name, metric_name, unit);
+  UpdateStatisticMessage(msg, window_start, window_stop, data, quantiles);
+  return msg;
+}
+
+void UpdateStatisticMessage(
+  MetricsMessage & msg,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data)
+{
+  SetStatistics(msg, kStatisticDataPointCount, window_start, window_stop, data);
+}
 
-  msg.statistics.emplace_back();
-  msg.statistics.back().data_type = StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM;
-  msg.statistics.back().data = data.min;
+void UpdateStatisticMessage(
+  MetricsMessage & msg,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::moving_average_statistics::StatisticData & data,
+  const libstatistics_collector::moving_average_statistics::QuantileData & quantiles)
+{
+  SetStatistics(msg, kQuantileDataPointCount, window_start, window_stop, data);
+  SetQuantiles(msg, quantiles);
+}
 
-  msg.statistics.emplace_back();
-  msg.statistics.back().data_type = StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT;
-  msg.statistics.back().data = static_cast<double>(data.sample_count);
+void AppendHistogramDataPoints(
+  MetricsMessage & msg,
+  const std::vector<libstatistics_collector::moving_average_statistics::HistogramBucket> & buckets)
+{
+  size_t index = msg.statistics.size();
+  msg.statistics.resize(index + 3 * buckets.size());
+  for (const auto & bucket : buckets) {
+    SetDataPoint(msg, index++, kStatisticsDataTypeHistogramLowerBound, bucket.lower_bound);
+    SetDataPoint(msg, index++, kStatisticsDataTypeHistogramUpperBound, bucket.upper_bound);
+    SetDataPoint(
+      msg, index++, kStatisticsDataTypeHistogramCount, static_cast<double>(bucket.count));
+  }
+}
 
-  msg.statistics.emplace_back();
-  msg.statistics.back().data_type = StatisticDataType::STATISTICS_DATA_TYPE_STDDEV;
-  msg.statistics.back().data = data.standard_deviation;
+MetricsMessage GenerateInstrumentationMessage(
+  const std::string & node_name,
+  const std::string & metric_name,
+  const builtin_interfaces::msg::Time window_start,
+  const builtin_interfaces::msg::Time window_stop,
+  const libstatistics_collector::InstrumentationData & data)
+{
+  MetricsMessage msg = MakeMessage(
+    node_name, metric_name + kInstrumentationMetricSuffix, kInstrumentationMetricUnit);
+  msg.window_start = window_start;
+  msg.window_stop = window_stop;
 
+  const std::pair<uint8_t, uint64_t> counters[] = {
+    {kStatisticsDataTypeAcceptDataCount, data.accept_data_count},
+    {kStatisticsDataTypeAcceptDataNanoseconds, data.accept_data_nanoseconds},
+    {kStatisticsDataTypeMessageCount, data.message_count},
+    {kStatisticsDataTypeMessageNanoseconds, data.message_nanoseconds},
+    {kStatisticsDataTypeLockContentionCount, data.lock_contention_count},
+    {kStatisticsDataTypeDroppedSampleCount, data.dropped_sample_count},
+  };
+  msg.statistics.resize(sizeof(counters) / sizeof(counters[0]));
+  size_t index = 0;
+  for (const auto & counter : counters) {
+    SetDataPoint(msg, index++, counter.first, static_cast<double>(counter.second));
+  }
   return msg;
 }
 
@@ -0,0 +1,343 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "libstatistics_collector/collector/shared_memory_exporter.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+using shared_memory_layout::MetricSlot;
+using shared_memory_layout::RegionHeader;
+
+namespace
+{
+
+/// Attempts of SharedMemoryReader::Read to get a snapshot not overlapping with an update
+constexpr const int kReadAttempts = 1000;
+
+#if !defined(_WIN32)
+
+size_t GetRegionSize(const size_t capacity)
+{
+  return sizeof(RegionHeader) + capacity * sizeof(MetricSlot);
+}
+
+std::runtime_error MakeSystemError(const std::string & what, const std::string & region_name)
+{
+  return std::runtime_error{what + " '" + region_name + "': " + std::strerror(errno)};
+}
+
+#endif
+
+/**
+ * Copy a string into a fixed size buffer, truncating it and terminating it with a null character.
+ */
+void CopyString(char * destination, const size_t destination_size, const std::string_view source)
+{
+  const size_t length = std::min(source.size(), destination_size - 1);
+  std::memcpy(destination, source.data(), length);
+  std::memset(destination + length, 0, destination_size - length);
+}
+
+std::string_view ToStringView(const char * source, const size_t source_size)
+{
+  return std::string_view{source, strnlen(source, source_size)};
+}
+
+}  // namespace
+
+#if defined(_WIN32)
+
+SharedMemoryExporter::SharedMemoryExporter(
+  const std::string & region_name, const std::string &, const size_t capacity)
+: region_name_{region_name}, capacity_{capacity}
+{
+  throw std::runtime_error{"shared memory export is not supported on this platform"};
+}
+
+SharedMemoryExporter::~SharedMemoryExporter() = default;
+
+SharedMemoryReader::SharedMemoryReader(const std::string &)
+{
+  throw std::runtime_error{"shared memory export is not supported on this platform"};
+}
+
+SharedMemoryReader::~SharedMemoryReader() = default;
+
+#else
+
+SharedMemoryExporter::SharedMemoryExporter(
+  const std::string & region_name, const std::string & node_name, const size_t capacity)
+: region_name_{region_name}, capacity_{capacity}
+{
+  if (region_name.size() < 2 || region_name[0] != '/' ||
+    region_name.find('/', 1) != std::string::npos)
+  {
+    throw std::invalid_argument("region_name must be a '/' followed by a name without '/'");
+  }
+  if (node_name.size() >= shared_memory_layout::kNodeNameSize) {
+    throw std::invalid_argument("node_name is too long");
+  }
+  if (capacity == 0 || capacity > UINT32_MAX) {
+    throw std::invalid_argument("capacity must be positive and fit 32 bits");
+  }
+
+  // start from an empty region, so that readers never see slots of a previous process
+  shm_unlink(region_name_.c_str());
+  const int fd = shm_open(region_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw MakeSystemError("cannot create shared memory region", region_name_);
+  }
+  region_size_ = GetRegionSize(capacity_);
+  if (ftruncate(fd, static_cast<off_t>(region_size_)) != 0) {
+    const auto error = MakeSystemError("cannot size shared memory region", region_name_);
+    close(fd);
+    shm_unlink(region_name_.c_str());
+    throw error;
+  }
+  region_ = mmap(nullptr, region_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (region_ == MAP_FAILED) {
+    const auto error = MakeSystemError("cannot map shared memory region", region_name_);
+    shm_unlink(region_name_.c_str());
+    throw error;
+  }
+
+  slots_ = reinterpret_cast<MetricSlot *>(static_cast<char *>(region_) + sizeof(RegionHeader));
+  for (size_t i = 0; i < capacity_; i++) {
+    new (&slots_[i]) MetricSlot{};
+  }
+  header_ = new (region_) RegionHeader{};
+  header_->magic = shared_memory_layout::kMagic;
+  header_->version = shared_memory_layout::kVersion;
+  header_->capacity = static_cast<uint32_t>(capacity_);
+  header_->slot_size = static_cast<uint32_t>(sizeof(MetricSlot));
+  CopyString(header_->node_name, sizeof(header_->node_name), node_name);
+  header_->metric_count.store(0, std::memory_order_release);
+
+  collectors_.reserve(capacity_);
+}
+
+SharedMemoryExporter::~SharedMemoryExporter()
+{
+  munmap(region_, region_size_);
+  shm_unlink(region_name_.c_str());
+}
+
+SharedMemoryReader::SharedMemoryReader(const std::string & region_name)
+{
+  const int fd = shm_open(region_name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw MakeSystemError("cannot open shared memory region", region_name);
+  }
+  struct stat region_stat;
+  if (fstat(fd, &region_stat) != 0) {
+    const auto error = MakeSystemError("cannot stat shared memory region", region_name);
+    close(fd);
+    throw error;
+  }
+  region_size_ = static_cast<size_t>(region_stat.st_size);
+  if (region_size_ < sizeof(RegionHeader)) {
+    close(fd);
+    throw std::runtime_error{"shared memory region '" + region_name + "' is too small"};
+  }
+  region_ = mmap(nullptr, region_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (region_ == MAP_FAILED) {
+    throw MakeSystemError("cannot map shared memory region", region_name);
+  }
+
+  header_ = static_cast<const RegionHeader *>(region_);
+  if (header_->magic != shared_memory_layout::kMagic ||
+    header_->version != shared_memory_layout::kVersion ||
+    header_->slot_size != sizeof(MetricSlot) ||
+    region_size_ < GetRegionSize(header_->capacity))
+  {
+    munmap(const_cast<void *>(region_), region_size_);
+    throw std::runtime_error{"shared memory region '" + region_name + "' has an unknown layout"};
+  }
+  slots_ = reinterpret_cast<const MetricSlot *>(
+    static_cast<const char *>(region_) + sizeof(RegionHeader));
+}
+
+SharedMemoryReader::~SharedMemoryReader()
+{
+  munmap(const_cast<void *>(region_), region_size_);
+}
+
+#endif
+
+size_t SharedMemoryExporter::Register(std::shared_ptr<Collector> collector)
+{
+  if (!collector) {
+    throw std::invalid_argument("collector must not be null");
+  }
+
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (collectors_.size() == capacity_) {
+    throw std::length_error("shared memory region is full");
+  }
+  const size_t index = collectors_.size();
+  MetricSlot & slot = slots_[index];
+
+  const std::string_view name_view = collector->GetMetricNameView();
+  const std::string_view unit_view = collector->GetMetricUnitView();
+  CopyString(
+    slot.name, sizeof(slot.name),
+    name_view.empty() ? std::string_view{collector->GetMetricName()} : name_view);
+  CopyString(
+    slot.unit, sizeof(slot.unit),
+    unit_view.empty() ? std::string_view{collector->GetMetricUnit()} : unit_view);
+  slot.state.store(shared_memory_layout::kSlotActive, std::memory_order_relaxed);
+
+  collectors_.push_back(std::move(collector));
+  // publish the names of the slot
+  header_->metric_count.store(collectors_.size(), std::memory_order_release);
+  return index;
+}
+
+void SharedMemoryExporter::Unregister(const size_t index)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  if (index >= collectors_.size()) {
+    return;
+  }
+  collectors_[index].reset();
+  slots_[index].state.store(shared_memory_layout::kSlotRetired, std::memory_order_release);
+}
+
+void SharedMemoryExporter::Update(const int64_t update_time)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  for (size_t i = 0; i < collectors_.size(); i++) {
+    if (!collectors_[i]) {
+      continue;
+    }
+    const auto statistics = collectors_[i]->GetStatisticsResults();
+    MetricSlot & slot = slots_[i];
+
+    // seqlock write, as in moving_average_statistics::BasicMovingAverageStatistics
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.update_time.store(update_time, std::memory_order_relaxed);
+    slot.sample_count.store(statistics.sample_count, std::memory_order_relaxed);
+    slot.average.store(statistics.average, std::memory_order_relaxed);
+    slot.min.store(statistics.min, std::memory_order_relaxed);
+    slot.max.store(statistics.max, std::memory_order_relaxed);
+    slot.standard_deviation.store(statistics.standard_deviation, std::memory_order_relaxed);
+    slot.sample_rate.store(statistics.sample_rate, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+  }
+}
+
+size_t SharedMemoryExporter::GetMetricCount() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return collectors_.size();
+}
+
+const std::string & SharedMemoryExporter::GetRegionName() const
+{
+  return region_name_;
+}
+
+std::string_view SharedMemoryReader::GetNodeName() const
+{
+  return ToStringView(header_->node_name, sizeof(header_->node_name));
+}
+
+size_t SharedMemoryReader::GetMetricCount() const
+{
+  const uint64_t count = header_->metric_count.load(std::memory_order_acquire);
+  return static_cast<size_t>(std::min<uint64_t>(count, header_->capacity));
+}
+
+std::string_view SharedMemoryReader::GetMetricName(const size_t index) const
+{
+  if (index >= GetMetricCount()) {
+    return {};
+  }
+  return ToStringView(slots_[index].name, sizeof(slots_[index].name));
+}
+
+std::string_view SharedMemoryReader::GetMetricUnit(const size_t index) const
+{
+  if (index >= GetMetricCount()) {
+    return {};
+  }
+  return ToStringView(slots_[index].unit, sizeof(slots_[index].unit));
+}
+
+bool SharedMemoryReader::IsRetired(const size_t index) const
+{
+  return index < GetMetricCount() &&
+         slots_[index].state.load(std::memory_order_acquire) == shared_memory_layout::kSlotRetired;
+}
+
+bool SharedMemoryReader::Read(
+  const size_t index, moving_average_statistics::StatisticData & statistics,
+  int64_t & update_time) const
+{
+  if (index >= GetMetricCount()) {
+    return false;
+  }
+  const MetricSlot & slot = slots_[index];
+
+  for (int attempt = 0; attempt < kReadAttempts; attempt++) {
+    const uint64_t begin_sequence = slot.sequence.load(std::memory_order_acquire);
+    if (begin_sequence & 1) {
+      continue;  // an update is in progress
+    }
+    update_time = slot.update_time.load(std::memory_order_relaxed);
+    statistics.sample_count = slot.sample_count.load(std::memory_order_relaxed);
+    statistics.average = slot.average.load(std::memory_order_relaxed);
+    statistics.min = slot.min.load(std::memory_order_relaxed);
+    statistics.max = slot.max.load(std::memory_order_relaxed);
+    statistics.standard_deviation = slot.standard_deviation.load(std::memory_order_relaxed);
+    statistics.sample_rate = slot.sample_rate.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (begin_sequence == slot.sequence.load(std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace collector
+}  // namespace libstatistics_collector
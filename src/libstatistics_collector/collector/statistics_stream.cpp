@@ -0,0 +1,690 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/collector/statistics_stream.hpp"
+
+namespace libstatistics_collector
+{
+namespace collector
+{
+
+using moving_average_statistics::StatisticData;
+
+namespace
+{
+
+constexpr const char kFileMagic[] = "LSCSTRM";
+/// Magic of a block header, "SBLK" in ASCII
+constexpr const uint32_t kBlockMagic = 0x4b4c4253;
+
+/// The double columns of a block, in the order they are stored
+constexpr const std::array<double StatisticData::*, 5> kDoubleColumns = {
+  &StatisticData::average,
+  &StatisticData::min,
+  &StatisticData::max,
+  &StatisticData::standard_deviation,
+  &StatisticData::sample_rate,
+};
+
+std::runtime_error MakeCorruptedError()
+{
+  return std::runtime_error{"corrupted statistics stream"};
+}
+
+void PutFixed(std::vector<uint8_t> & bytes, const size_t offset, uint64_t value, const int size)
+{
+  for (int i = 0; i < size; i++) {
+    bytes[offset + static_cast<size_t>(i)] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+uint64_t GetFixed(const uint8_t * bytes, const int size)
+{
+  uint64_t value = 0;
+  for (int i = size - 1; i >= 0; i--) {
+    value = (value << 8) | bytes[i];
+  }
+  return value;
+}
+
+void PutVarint(std::vector<uint8_t> & bytes, uint64_t value)
+{
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+void PutString(std::vector<uint8_t> & bytes, const std::string & value)
+{
+  PutVarint(bytes, value.size());
+  bytes.insert(bytes.end(), value.begin(), value.end());
+}
+
+/**
+ * Map signed deltas to unsigned integers, so that small negative deltas have short varints.
+ */
+uint64_t ZigZagEncode(const uint64_t delta)
+{
+  return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+uint64_t ZigZagDecode(const uint64_t value)
+{
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+/**
+ * Bounds checked decoding of the bytes of a block.
+ */
+class ByteReader
+{
+public:
+  ByteReader(const uint8_t * data, const size_t begin, const size_t end)
+  : data_{data}, position_{begin}, end_{end} {}
+
+  uint64_t ReadVarint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (position_ == end_) {
+        throw MakeCorruptedError();
+      }
+      const uint8_t byte = data_[position_++];
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    throw MakeCorruptedError();
+  }
+
+  const uint8_t * ReadBytes(const size_t size)
+  {
+    if (size > end_ - position_) {
+      throw MakeCorruptedError();
+    }
+    const uint8_t * bytes = data_ + position_;
+    position_ += size;
+    return bytes;
+  }
+
+  std::string ReadString()
+  {
+    const size_t size = ReadVarint();
+    const auto * bytes = reinterpret_cast<const char *>(ReadBytes(size));
+    return std::string{bytes, size};
+  }
+
+  size_t GetPosition() const
+  {
+    return position_;
+  }
+
+private:
+  const uint8_t * data_;
+  size_t position_;
+  const size_t end_;
+};
+
+class BitWriter
+{
+public:
+  explicit BitWriter(std::vector<uint8_t> & bytes)
+  : bytes_{bytes} {}
+
+  /**
+   * Append the count low bits of value, most significant first.
+   */
+  void Write(const uint64_t value, int count)
+  {
+    while (count > 0) {
+      if (used_bits_ == 0) {
+        bytes_.push_back(0);
+      }
+      const int free_bits = 8 - used_bits_;
+      const int chunk_bits = std::min(free_bits, count);
+      const auto chunk =
+        static_cast<uint8_t>((value >> (count - chunk_bits)) & ((1u << chunk_bits) - 1));
+      bytes_.back() = static_cast<uint8_t>(bytes_.back() | (chunk << (free_bits - chunk_bits)));
+      used_bits_ = (used_bits_ + chunk_bits) % 8;
+      count -= chunk_bits;
+    }
+  }
+
+private:
+  std::vector<uint8_t> & bytes_;
+  /// bits used in the last byte, 0 if it is full
+  int used_bits_ = 0;
+};
+
+class BitReader
+{
+public:
+  BitReader(const uint8_t * bytes, const size_t size)
+  : bytes_{bytes}, bit_count_{size * 8} {}
+
+  uint64_t Read(int count)
+  {
+    if (static_cast<size_t>(count) > bit_count_ - position_) {
+      throw MakeCorruptedError();
+    }
+    uint64_t value = 0;
+    while (count > 0) {
+      const int offset = static_cast<int>(position_ % 8);
+      const int chunk_bits = std::min(8 - offset, count);
+      const unsigned byte = bytes_[position_ / 8];
+      value = (value << chunk_bits) |
+        ((byte >> (8 - offset - chunk_bits)) & ((1u << chunk_bits) - 1));
+      position_ += static_cast<size_t>(chunk_bits);
+      count -= chunk_bits;
+    }
+    return value;
+  }
+
+private:
+  const uint8_t * bytes_;
+  const size_t bit_count_;
+  size_t position_ = 0;
+};
+
+int CountLeadingZeros(uint64_t value)
+{
+  int count = 0;
+  for (int shift = 32; shift > 0; shift /= 2) {
+    if (!(value >> (64 - shift))) {
+      count += shift;
+      value <<= shift;
+    }
+  }
+  return count;
+}
+
+int CountTrailingZeros(uint64_t value)
+{
+  int count = 0;
+  for (int shift = 32; shift > 0; shift /= 2) {
+    if (!(value & ((uint64_t{1} << shift) - 1))) {
+      count += shift;
+      value >>= shift;
+    }
+  }
+  return count;
+}
+
+/**
+ * The time column compression state of one metric. Times are stored as the change of the window
+ * stop delta and of the window duration since the previous record of the same metric, which is 0
+ * for the regular windows of a periodically published metric. Arithmetic is done on unsigned
+ * integers to wrap around instead of overflowing.
+ */
+struct TimeState
+{
+  uint64_t window_stop = 0;
+  uint64_t delta = 0;
+  uint64_t duration = 0;
+};
+
+/**
+ * The Gorilla XOR compression state of a double column of one metric.
+ */
+struct XorState
+{
+  uint64_t previous = 0;
+  /// leading and trailing zero bits of the last stored XOR, leading is -1 before the first one
+  int leading = -1;
+  int trailing = 0;
+};
+
+void EncodeXor(BitWriter & bits, XorState & state, const double value)
+{
+  uint64_t value_bits;
+  std::memcpy(&value_bits, &value, sizeof(value_bits));
+  const uint64_t xor_bits = value_bits ^ state.previous;
+  state.previous = value_bits;
+  if (xor_bits == 0) {
+    bits.Write(0, 1);
+    return;
+  }
+  bits.Write(1, 1);
+
+  // 5 bits store at most 31 leading zeros
+  const int leading = std::min(CountLeadingZeros(xor_bits), 31);
+  const int trailing = CountTrailingZeros(xor_bits);
+  if (state.leading >= 0 && leading >= state.leading && trailing >= state.trailing) {
+    // the meaningful bits fit the previous window
+    bits.Write(0, 1);
+    bits.Write(xor_bits >> state.trailing, 64 - state.leading - state.trailing);
+    return;
+  }
+  const int meaningful = 64 - leading - trailing;
+  bits.Write(1, 1);
+  bits.Write(static_cast<uint64_t>(leading), 5);
+  bits.Write(static_cast<uint64_t>(meaningful - 1), 6);
+  bits.Write(xor_bits >> trailing, meaningful);
+  state.leading = leading;
+  state.trailing = trailing;
+}
+
+double DecodeXor(BitReader & bits, XorState & state)
+{
+  if (bits.Read(1)) {
+    if (bits.Read(1)) {
+      state.leading = static_cast<int>(bits.Read(5));
+      const int meaningful = static_cast<int>(bits.Read(6)) + 1;
+      state.trailing = 64 - state.leading - meaningful;
+      if (state.trailing < 0) {
+        throw MakeCorruptedError();
+      }
+    } else if (state.leading < 0) {
+      throw MakeCorruptedError();
+    }
+    const int meaningful = 64 - state.leading - state.trailing;
+    state.previous ^= bits.Read(meaningful) << state.trailing;
+  }
+  double value;
+  std::memcpy(&value, &state.previous, sizeof(value));
+  return value;
+}
+
+int64_t ToNanoseconds(const builtin_interfaces::msg::Time & time)
+{
+  return static_cast<int64_t>(time.sec) * 1000000000 + static_cast<int64_t>(time.nanosec);
+}
+
+}  // namespace
+
+StatisticsStreamWriter::StatisticsStreamWriter(
+  std::ostream & stream, const size_t records_per_block)
+: stream_{stream}, records_per_block_{records_per_block}
+{
+  if (records_per_block == 0) {
+    throw std::invalid_argument("records_per_block must be positive");
+  }
+  records_.reserve(records_per_block_);
+
+  char header[statistics_stream_format::kFileHeaderSize];
+  std::memcpy(header, kFileMagic, sizeof(kFileMagic) - 1);
+  header[sizeof(kFileMagic) - 1] = static_cast<char>(statistics_stream_format::kVersion);
+  if (!stream_.write(header, sizeof(header))) {
+    throw std::runtime_error{"cannot write statistics stream header"};
+  }
+}
+
+StatisticsStreamWriter::~StatisticsStreamWriter()
+{
+  try {
+    Flush();
+  } catch (...) {
+  }
+}
+
+uint32_t StatisticsStreamWriter::InternMetric(
+  const std::string & node_name, const std::string & metric_name,
+  const std::string & metric_unit)
+{
+  const auto it = metric_ids_.find(std::forward_as_tuple(node_name, metric_name, metric_unit));
+  if (it != metric_ids_.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<uint32_t>(metrics_.size());
+  metric_ids_.emplace(std::make_tuple(node_name, metric_name, metric_unit), id);
+  metrics_.push_back(StatisticsStreamMetric{node_name, metric_name, metric_unit});
+  return id;
+}
+
+void StatisticsStreamWriter::Write(
+  const uint32_t metric_id, const int64_t window_start, const int64_t window_stop,
+  const StatisticData & statistics)
+{
+  if (metric_id >= metrics_.size()) {
+    throw std::out_of_range("unknown metric id");
+  }
+  records_.push_back(StatisticsStreamRecord{metric_id, window_start, window_stop, statistics});
+  if (records_.size() == records_per_block_) {
+    WriteBlock();
+  }
+}
+
+void StatisticsStreamWriter::Write(const statistics_msgs::msg::MetricsMessage & msg)
+{
+  using statistics_msgs::msg::StatisticDataType;
+
+  StatisticData statistics;
+  for (const auto & point : msg.statistics) {
+    switch (point.data_type) {
+      case StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE:
+        statistics.average = point.data;
+        break;
+      case StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM:
+        statistics.min = point.data;
+        break;
+      case StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM:
+        statistics.max = point.data;
+        break;
+      case StatisticDataType::STATISTICS_DATA_TYPE_STDDEV:
+        statistics.standard_deviation = point.data;
+        break;
+      case StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT:
+        statistics.sample_count = static_cast<uint64_t>(point.data);
+        break;
+      case kStatisticsDataTypeSampleRate:
+        statistics.sample_rate = point.data;
+        break;
+      default:
+        break;
+    }
+  }
+  Write(
+    InternMetric(msg.measurement_source_name, msg.metrics_source, msg.unit),
+    ToNanoseconds(msg.window_start), ToNanoseconds(msg.window_stop), statistics);
+}
+
+void StatisticsStreamWriter::Flush()
+{
+  if (!records_.empty() || written_metric_count_ != metrics_.size()) {
+    WriteBlock();
+  }
+  if (!stream_.flush()) {
+    throw std::runtime_error{"cannot flush statistics stream"};
+  }
+}
+
+size_t StatisticsStreamWriter::GetMetricCount() const
+{
+  return metrics_.size();
+}
+
+void StatisticsStreamWriter::WriteBlock()
+{
+  int64_t min_window_stop = records_.empty() ? 0 : std::numeric_limits<int64_t>::max();
+  int64_t max_window_stop = records_.empty() ? 0 : std::numeric_limits<int64_t>::min();
+  for (const auto & record : records_) {
+    min_window_stop = std::min(min_window_stop, record.window_stop);
+    max_window_stop = std::max(max_window_stop, record.window_stop);
+  }
+
+  block_.clear();
+  block_.resize(statistics_stream_format::kBlockHeaderSize);
+  for (size_t id = written_metric_count_; id < metrics_.size(); id++) {
+    PutVarint(block_, id);
+    PutString(block_, metrics_[id].node_name);
+    PutString(block_, metrics_[id].metric_name);
+    PutString(block_, metrics_[id].metric_unit);
+  }
+
+  for (const auto & record : records_) {
+    PutVarint(block_, record.metric_id);
+  }
+  std::vector<TimeState> times(metrics_.size(), TimeState{static_cast<uint64_t>(min_window_stop)});
+  for (const auto & record : records_) {
+    TimeState & time = times[record.metric_id];
+    const auto window_stop = static_cast<uint64_t>(record.window_stop);
+    const uint64_t delta = window_stop - time.window_stop;
+    const uint64_t duration = window_stop - static_cast<uint64_t>(record.window_start);
+    PutVarint(block_, ZigZagEncode(delta - time.delta));
+    PutVarint(block_, ZigZagEncode(duration - time.duration));
+    time = TimeState{window_stop, delta, duration};
+  }
+  for (const auto & record : records_) {
+    PutVarint(block_, record.statistics.sample_count);
+  }
+
+  std::vector<uint8_t> bytes;
+  std::vector<XorState> states;
+  for (const auto column : kDoubleColumns) {
+    bytes.clear();
+    states.assign(metrics_.size(), XorState{});
+    BitWriter bits{bytes};
+    for (const auto & record : records_) {
+      EncodeXor(bits, states[record.metric_id], record.statistics.*column);
+    }
+    PutVarint(block_, bytes.size());
+    block_.insert(block_.end(), bytes.begin(), bytes.end());
+  }
+
+  const size_t payload_size = block_.size() - statistics_stream_format::kBlockHeaderSize;
+  if (payload_size > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error{"statistics stream block is too large"};
+  }
+  PutFixed(block_, 0, kBlockMagic, 4);
+  PutFixed(block_, 4, payload_size, 4);
+  PutFixed(block_, 8, records_.size(), 4);
+  PutFixed(block_, 12, metrics_.size() - written_metric_count_, 4);
+  PutFixed(block_, 16, static_cast<uint64_t>(min_window_stop), 8);
+  PutFixed(block_, 24, static_cast<uint64_t>(max_window_stop), 8);
+
+  if (!stream_.write(
+      reinterpret_cast<const char *>(block_.data()), static_cast<std::streamsize>(block_.size())))
+  {
+    throw std::runtime_error{"cannot write statistics stream block"};
+  }
+  records_.clear();
+  written_metric_count_ = metrics_.size();
+}
+
+#if defined(_WIN32)
+
+StatisticsStreamReader::StatisticsStreamReader(const std::string &)
+{
+  throw std::runtime_error{"memory mapping statistics streams is not supported on this platform"};
+}
+
+StatisticsStreamReader::~StatisticsStreamReader() = default;
+
+#else
+
+StatisticsStreamReader::StatisticsStreamReader(const std::string & path)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error{"cannot open statistics stream '" + path + "': " +
+            std::strerror(errno)};
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+    static_cast<size_t>(file_stat.st_size) < statistics_stream_format::kFileHeaderSize)
+  {
+    close(fd);
+    throw std::runtime_error{"'" + path + "' is not a statistics stream"};
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+  mapping_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw std::runtime_error{"cannot map statistics stream '" + path + "': " +
+            std::strerror(errno)};
+  }
+  data_ = static_cast<const uint8_t *>(mapping_);
+  try {
+    IndexBlocks();
+  } catch (...) {
+    munmap(mapping_, size_);
+    throw;
+  }
+}
+
+StatisticsStreamReader::~StatisticsStreamReader()
+{
+  if (mapping_) {
+    munmap(mapping_, size_);
+  }
+}
+
+#endif
+
+StatisticsStreamReader::StatisticsStreamReader(const uint8_t * data, const size_t size)
+: data_{data}, size_{size}
+{
+  IndexBlocks();
+}
+
+const std::vector<StatisticsStreamMetric> & StatisticsStreamReader::GetMetrics() const
+{
+  return metrics_;
+}
+
+size_t StatisticsStreamReader::GetRecordCount() const
+{
+  return record_count_;
+}
+
+size_t StatisticsStreamReader::GetBlockCount() const
+{
+  return blocks_.size();
+}
+
+std::vector<StatisticsStreamRecord> StatisticsStreamReader::ReadAll() const
+{
+  return ReadRange(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+}
+
+std::vector<StatisticsStreamRecord> StatisticsStreamReader::ReadRange(
+  const int64_t begin, const int64_t end) const
+{
+  std::vector<StatisticsStreamRecord> records;
+  for (const auto & block : blocks_) {
+    if (block.record_count != 0 && block.max_window_stop >= begin &&
+      block.min_window_stop <= end)
+    {
+      DecodeBlock(block, begin, end, records);
+    }
+  }
+  return records;
+}
+
+void StatisticsStreamReader::IndexBlocks()
+{
+  if (size_ < statistics_stream_format::kFileHeaderSize ||
+    std::memcmp(data_, kFileMagic, sizeof(kFileMagic) - 1) != 0 ||
+    data_[sizeof(kFileMagic) - 1] != statistics_stream_format::kVersion)
+  {
+    throw std::runtime_error{"not a statistics stream of a supported version"};
+  }
+
+  size_t offset = statistics_stream_format::kFileHeaderSize;
+  while (size_ - offset >= statistics_stream_format::kBlockHeaderSize) {
+    const uint8_t * header = data_ + offset;
+    if (GetFixed(header, 4) != kBlockMagic) {
+      throw MakeCorruptedError();
+    }
+    const size_t payload_offset = offset + statistics_stream_format::kBlockHeaderSize;
+    const auto payload_size = static_cast<size_t>(GetFixed(header + 4, 4));
+    if (payload_size > size_ - payload_offset) {
+      break;  // truncated last block
+    }
+    BlockIndex block;
+    block.end_offset = payload_offset + payload_size;
+    block.record_count = static_cast<uint32_t>(GetFixed(header + 8, 4));
+    const auto definition_count = static_cast<uint32_t>(GetFixed(header + 12, 4));
+    block.min_window_stop = static_cast<int64_t>(GetFixed(header + 16, 8));
+    block.max_window_stop = static_cast<int64_t>(GetFixed(header + 24, 8));
+
+    ByteReader reader{data_, payload_offset, block.end_offset};
+    for (uint32_t i = 0; i < definition_count; i++) {
+      if (reader.ReadVarint() != metrics_.size()) {
+        throw MakeCorruptedError();
+      }
+      StatisticsStreamMetric metric;
+      metric.node_name = reader.ReadString();
+      metric.metric_name = reader.ReadString();
+      metric.metric_unit = reader.ReadString();
+      metrics_.push_back(std::move(metric));
+    }
+    block.columns_offset = reader.GetPosition();
+
+    blocks_.push_back(block);
+    record_count_ += block.record_count;
+    offset = block.end_offset;
+  }
+}
+
+void StatisticsStreamReader::DecodeBlock(
+  const BlockIndex & block, const int64_t begin, const int64_t end,
+  std::vector<StatisticsStreamRecord> & records) const
+{
+  ByteReader reader{data_, block.columns_offset, block.end_offset};
+  // every record takes at least one byte per integer column
+  if (block.record_count > block.end_offset - block.columns_offset) {
+    throw MakeCorruptedError();
+  }
+  std::vector<StatisticsStreamRecord> block_records(block.record_count);
+
+  for (auto & record : block_records) {
+    const uint64_t metric_id = reader.ReadVarint();
+    if (metric_id >= metrics_.size()) {
+      throw MakeCorruptedError();
+    }
+    record.metric_id = static_cast<uint32_t>(metric_id);
+  }
+  std::vector<TimeState> times(
+    metrics_.size(), TimeState{static_cast<uint64_t>(block.min_window_stop)});
+  for (auto & record : block_records) {
+    TimeState & time = times[record.metric_id];
+    time.delta += ZigZagDecode(reader.ReadVarint());
+    time.duration += ZigZagDecode(reader.ReadVarint());
+    time.window_stop += time.delta;
+    record.window_stop = static_cast<int64_t>(time.window_stop);
+    record.window_start = static_cast<int64_t>(time.window_stop - time.duration);
+  }
+  for (auto & record : block_records) {
+    record.statistics.sample_count = reader.ReadVarint();
+  }
+
+  std::vector<XorState> states;
+  for (const auto column : kDoubleColumns) {
+    const size_t size = reader.ReadVarint();
+    BitReader bits{reader.ReadBytes(size), size};
+    states.assign(metrics_.size(), XorState{});
+    for (auto & record : block_records) {
+      record.statistics.*column = DecodeXor(bits, states[record.metric_id]);
+    }
+  }
+
+  for (const auto & record : block_records) {
+    if (record.window_stop >= begin && record.window_stop <= end) {
+      records.push_back(record);
+    }
+  }
+}
+
+}  // namespace collector
+}  // namespace libstatistics_collector
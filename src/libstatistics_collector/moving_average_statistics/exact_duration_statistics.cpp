@@ -0,0 +1,185 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+namespace
+{
+
+constexpr uint64_t kLowHalfMask = 0xffffffffULL;
+
+/**
+ * Convert nanoseconds to milliseconds the way the age and period collectors do.
+ */
+double ToMilliseconds(const double nanoseconds)
+{
+  return std::chrono::duration<double, std::milli>(
+    std::chrono::duration<double, std::nano>{nanoseconds}).count();
+}
+
+}  // namespace
+
+void ExactDurationStatistics::Int128::Add(const int64_t value)
+{
+  const uint64_t previous_low = low;
+  low += static_cast<uint64_t>(value);
+  // sign extend the value into the high half, plus the carry out of the low half
+  high += (value < 0 ? std::numeric_limits<uint64_t>::max() : 0) + (low < previous_low ? 1 : 0);
+}
+
+void ExactDurationStatistics::Int128::AddSquare(const uint64_t value)
+{
+  uint64_t square_high = 0;
+  uint64_t square_low = 0;
+  if (value <= kLowHalfMask) {
+    // the common case, durations up to about 4.3 s offset from the first one
+    square_low = value * value;
+  } else {
+    const uint64_t value_low = value & kLowHalfMask;
+    const uint64_t value_high = value >> 32;
+    const uint64_t low_product = value_low * value_low;
+    const uint64_t cross_product = value_low * value_high;
+    const uint64_t middle = (low_product >> 32) + ((cross_product & kLowHalfMask) << 1);
+    square_low = (middle << 32) | (low_product & kLowHalfMask);
+    square_high = value_high * value_high + ((cross_product >> 32) << 1) + (middle >> 32);
+  }
+  const uint64_t previous_low = low;
+  low += square_low;
+  high += square_high + (low < previous_low ? 1 : 0);
+}
+
+double ExactDurationStatistics::Int128::ToDouble() const
+{
+  constexpr double kTwoToThe64 = 18446744073709551616.0;
+  if (high >> 63) {
+    // negate the two's complement
+    const uint64_t negated_low = ~low + 1;
+    const uint64_t negated_high = ~high + (negated_low == 0 ? 1 : 0);
+    return -(static_cast<double>(negated_high) * kTwoToThe64 + static_cast<double>(negated_low));
+  }
+  return static_cast<double>(high) * kTwoToThe64 + static_cast<double>(low);
+}
+
+void ExactDurationStatistics::AddDuration(const int64_t duration_nanoseconds)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  Update(duration_nanoseconds);
+}
+
+void ExactDurationStatistics::AddMeasurement(const double item)
+{
+  if (std::isnan(item)) {
+    return;
+  }
+  const auto duration_nanoseconds = static_cast<int64_t>(std::llround(item * 1e6));
+  std::lock_guard<std::mutex> guard{mutex_};
+  Update(duration_nanoseconds);
+}
+
+void ExactDurationStatistics::AddMeasurements(const double * items, size_t item_count)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  for (size_t i = 0; i < item_count; i++) {
+    if (!std::isnan(items[i])) {
+      Update(static_cast<int64_t>(std::llround(items[i] * 1e6)));
+    }
+  }
+}
+
+StatisticData ExactDurationStatistics::GetStatistics() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return GetStatisticsUnsynchronized();
+}
+
+void ExactDurationStatistics::Reset()
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  ResetUnsynchronized();
+}
+
+StatisticData ExactDurationStatistics::GetStatisticsAndReset()
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  const auto data = GetStatisticsUnsynchronized();
+  ResetUnsynchronized();
+  return data;
+}
+
+uint64_t ExactDurationStatistics::GetCount() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return count_;
+}
+
+void ExactDurationStatistics::Update(const int64_t duration_nanoseconds)
+{
+  if (count_ == 0) {
+    offset_ = duration_nanoseconds;
+  }
+  // wraps instead of overflowing, exact as long as the difference fits in 63 bits
+  const auto difference = static_cast<int64_t>(
+    static_cast<uint64_t>(duration_nanoseconds) - static_cast<uint64_t>(offset_));
+  const uint64_t magnitude = difference < 0 ?
+    0 - static_cast<uint64_t>(difference) : static_cast<uint64_t>(difference);
+  sum_.Add(difference);
+  sum_of_squares_.AddSquare(magnitude);
+  min_ = std::min(min_, duration_nanoseconds);
+  max_ = std::max(max_, duration_nanoseconds);
+  ++count_;
+}
+
+StatisticData ExactDurationStatistics::GetStatisticsUnsynchronized() const
+{
+  StatisticData data;
+  data.sample_count = count_;
+  if (count_ == 0) {
+    return data;
+  }
+  const auto count = static_cast<double>(count_);
+  const double mean_difference = sum_.ToDouble() / count;
+  const double variance = sum_of_squares_.ToDouble() / count - mean_difference * mean_difference;
+  data.average = ToMilliseconds(static_cast<double>(offset_) + mean_difference);
+  data.min = ToMilliseconds(static_cast<double>(min_));
+  data.max = ToMilliseconds(static_cast<double>(max_));
+  data.standard_deviation = ToMilliseconds(std::sqrt(std::max(variance, 0.0)));
+  return data;
+}
+
+void ExactDurationStatistics::ResetUnsynchronized()
+{
+  offset_ = 0;
+  sum_ = Int128{};
+  sum_of_squares_ = Int128{};
+  min_ = std::numeric_limits<int64_t>::max();
+  max_ = std::numeric_limits<int64_t>::min();
+  count_ = 0;
+}
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
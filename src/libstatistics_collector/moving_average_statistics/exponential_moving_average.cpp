@@ -0,0 +1,144 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include "libstatistics_collector/moving_average_statistics/exponential_moving_average.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+ExponentialMovingAverageStatistics::ExponentialMovingAverageStatistics()
+: ExponentialMovingAverageStatistics(kDefaultAlpha)
+{
+}
+
+ExponentialMovingAverageStatistics::ExponentialMovingAverageStatistics(const double alpha)
+: alpha_{alpha}
+{
+  if (!(alpha > 0 && alpha <= 1)) {
+    throw std::invalid_argument("alpha must be in (0, 1]");
+  }
+}
+
+double ExponentialMovingAverageStatistics::HalfLifeToAlpha(const double half_life)
+{
+  if (!(half_life > 0)) {
+    throw std::invalid_argument("half_life must be positive");
+  }
+  // (1 - alpha)^half_life == 0.5
+  return -std::expm1(-std::log(2.0) / half_life);
+}
+
+void ExponentialMovingAverageStatistics::AddMeasurement(const double item)
+{
+  if (std::isnan(item)) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard{mutex_};
+  Update(item);
+}
+
+void ExponentialMovingAverageStatistics::AddMeasurements(const double * items, size_t item_count)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  for (size_t i = 0; i < item_count; i++) {
+    if (!std::isnan(items[i])) {
+      Update(items[i]);
+    }
+  }
+}
+
+StatisticData ExponentialMovingAverageStatistics::GetStatistics() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return GetStatisticsUnsynchronized();
+}
+
+void ExponentialMovingAverageStatistics::Reset()
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  ResetUnsynchronized();
+}
+
+StatisticData ExponentialMovingAverageStatistics::GetStatisticsAndReset()
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  const auto data = GetStatisticsUnsynchronized();
+  ResetUnsynchronized();
+  return data;
+}
+
+uint64_t ExponentialMovingAverageStatistics::GetCount() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return count_;
+}
+
+double ExponentialMovingAverageStatistics::GetAlpha() const
+{
+  return alpha_;
+}
+
+void ExponentialMovingAverageStatistics::Update(const double item)
+{
+  if (count_ == 0) {
+    average_ = item;
+    variance_ = 0;
+    min_ = item;
+    max_ = item;
+  } else {
+    const double diff = item - average_;
+    const double increment = alpha_ * diff;
+    average_ += increment;
+    variance_ = (1 - alpha_) * (variance_ + diff * increment);
+    // the envelope follows a new extreme at once, and decays towards the observations otherwise
+    min_ = item < min_ ? item : min_ + alpha_ * (item - min_);
+    max_ = item > max_ ? item : max_ + alpha_ * (item - max_);
+  }
+  ++count_;
+}
+
+StatisticData ExponentialMovingAverageStatistics::GetStatisticsUnsynchronized() const
+{
+  StatisticData data;
+  data.sample_count = count_;
+  if (count_ > 0) {
+    data.average = average_;
+    data.min = min_;
+    data.max = max_;
+    data.standard_deviation = std::sqrt(variance_);
+  }
+  return data;
+}
+
+void ExponentialMovingAverageStatistics::ResetUnsynchronized()
+{
+  average_ = 0;
+  variance_ = 0;
+  min_ = std::numeric_limits<double>::max();
+  max_ = std::numeric_limits<double>::lowest();
+  count_ = 0;
+}
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
@@ -0,0 +1,248 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+namespace
+{
+
+/// Largest value in resolutions, so that bucket bounds can be computed without overflow
+constexpr const double kMaxValueInResolutions = 4611686018427387904.0;  // 2^62
+
+/**
+ * Validate the options before any member depending on them is initialized.
+ */
+const LogLinearHistogram::Options & ValidateOptions(const LogLinearHistogram::Options & options)
+{
+  if (!(options.resolution > 0 && std::isfinite(options.resolution))) {
+    throw std::invalid_argument("resolution must be positive");
+  }
+  if (options.significant_bits < 1 || options.significant_bits > 16) {
+    throw std::invalid_argument("significant_bits must be in [1, 16]");
+  }
+  if (!(options.max_value >= options.resolution &&
+    options.max_value / options.resolution < kMaxValueInResolutions))
+  {
+    throw std::invalid_argument("max_value must be in [resolution, 2^62 resolutions)");
+  }
+  return options;
+}
+
+/**
+ * Return the index of the most significant bit set of a positive value.
+ */
+size_t GetMostSignificantBit(const uint64_t value)
+{
+#if defined(_MSC_VER)
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanReverse64(&index, value);
+  return index;
+#else
+  return static_cast<size_t>(63 - __builtin_clzll(value));
+#endif
+}
+
+}  // namespace
+
+LogLinearHistogram::LogLinearHistogram()
+: LogLinearHistogram(Options{})
+{
+}
+
+LogLinearHistogram::LogLinearHistogram(const Options & options)
+: options_{ValidateOptions(options)},
+  max_value_{static_cast<uint64_t>(std::llround(options.max_value / options.resolution))},
+  linear_bucket_count_{uint64_t{1} << options.significant_bits},
+  bucket_count_{GetBucketIndex(max_value_) + 1},
+  buckets_{std::make_unique<std::atomic<uint64_t>[]>(bucket_count_)}
+{
+  Reset();
+}
+
+LogLinearHistogram::~LogLinearHistogram() = default;
+
+void LogLinearHistogram::AddMeasurement(const double item)
+{
+  if (std::isnan(item)) {
+    return;
+  }
+  const double value = item / options_.resolution;
+  uint64_t rounded_value = 0;
+  if (value >= static_cast<double>(max_value_)) {
+    rounded_value = max_value_;
+  } else if (value > 0) {
+    rounded_value = static_cast<uint64_t>(value + 0.5);
+  }
+  buckets_[GetBucketIndex(rounded_value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+StatisticData LogLinearHistogram::GetStatistics() const
+{
+  AccumulatorState state;
+  for (size_t i = 0; i < bucket_count_; i++) {
+    const uint64_t count = buckets_[i].load(std::memory_order_relaxed);
+    if (count != 0) {
+      state.Merge(GetBucketState(i, count));
+    }
+  }
+  return state.ToStatisticData();
+}
+
+void LogLinearHistogram::Reset()
+{
+  for (size_t i = 0; i < bucket_count_; i++) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+StatisticData LogLinearHistogram::GetStatisticsAndReset()
+{
+  AccumulatorState state;
+  for (size_t i = 0; i < bucket_count_; i++) {
+    const uint64_t count = buckets_[i].exchange(0, std::memory_order_relaxed);
+    if (count != 0) {
+      state.Merge(GetBucketState(i, count));
+    }
+  }
+  return state.ToStatisticData();
+}
+
+uint64_t LogLinearHistogram::GetCount() const
+{
+  uint64_t count = 0;
+  for (size_t i = 0; i < bucket_count_; i++) {
+    count += buckets_[i].load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+std::vector<HistogramBucket> LogLinearHistogram::GetBuckets() const
+{
+  std::vector<HistogramBucket> to_return;
+  for (size_t i = 0; i < bucket_count_; i++) {
+    const uint64_t count = buckets_[i].load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+    HistogramBucket bucket;
+    bucket.lower_bound = static_cast<double>(GetBucketLowerBound(i)) * options_.resolution;
+    bucket.upper_bound = static_cast<double>(GetBucketLowerBound(i + 1)) * options_.resolution;
+    bucket.count = count;
+    to_return.push_back(bucket);
+  }
+  return to_return;
+}
+
+bool LogLinearHistogram::GetAndReset(LogLinearHistogram & window)
+{
+  if (!HasSameOptions(window) || &window == this) {
+    return false;
+  }
+  for (size_t i = 0; i < bucket_count_; i++) {
+    window.buckets_[i].store(
+      buckets_[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  return true;
+}
+
+bool LogLinearHistogram::Merge(const LogLinearHistogram & other)
+{
+  if (!HasSameOptions(other)) {
+    return false;
+  }
+  for (size_t i = 0; i < bucket_count_; i++) {
+    buckets_[i].fetch_add(
+      other.buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  return true;
+}
+
+const LogLinearHistogram::Options & LogLinearHistogram::GetOptions() const
+{
+  return options_;
+}
+
+size_t LogLinearHistogram::GetBucketCount() const
+{
+  return bucket_count_;
+}
+
+bool LogLinearHistogram::HasSameOptions(const LogLinearHistogram & other) const
+{
+  return options_.resolution == other.options_.resolution &&
+         options_.significant_bits == other.options_.significant_bits &&
+         max_value_ == other.max_value_;
+}
+
+size_t LogLinearHistogram::GetBucketIndex(const uint64_t value) const
+{
+  if (value < linear_bucket_count_) {
+    return static_cast<size_t>(value);
+  }
+  // above the linear buckets, each power of two is split into half as many buckets, indexed by
+  // the significant bits of the value
+  const uint64_t half_count = linear_bucket_count_ / 2;
+  const size_t shift = GetMostSignificantBit(value) - options_.significant_bits + 1;
+  const uint64_t significand = value >> shift;
+  return static_cast<size_t>(linear_bucket_count_ + (shift - 1) * half_count +
+         (significand - half_count));
+}
+
+uint64_t LogLinearHistogram::GetBucketLowerBound(const size_t index) const
+{
+  if (index < linear_bucket_count_) {
+    return index;
+  }
+  const uint64_t half_count = linear_bucket_count_ / 2;
+  const uint64_t offset = index - linear_bucket_count_;
+  const uint64_t shift = offset / half_count + 1;
+  return (half_count + offset % half_count) << shift;
+}
+
+AccumulatorState LogLinearHistogram::GetBucketState(const size_t index, const uint64_t count) const
+{
+  // the observations of the bucket are the rounded values in [lower, upper - 1]
+  const uint64_t lower = GetBucketLowerBound(index);
+  const uint64_t upper = GetBucketLowerBound(index + 1);
+  const double value =
+    (static_cast<double>(lower) + static_cast<double>(upper - 1)) / 2 * options_.resolution;
+
+  AccumulatorState state;
+  state.average = value;
+  state.min = value;
+  state.max = value;
+  state.count = count;
+  return state;
+}
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
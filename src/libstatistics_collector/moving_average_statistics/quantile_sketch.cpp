@@ -0,0 +1,208 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "libstatistics_collector/moving_average_statistics/quantile_sketch.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+namespace
+{
+
+/**
+ * Validate the options before any member depending on them is initialized.
+ */
+const QuantileSketch::Options & ValidateOptions(const QuantileSketch::Options & options)
+{
+  if (!(options.relative_accuracy > 0 && options.relative_accuracy < 1)) {
+    throw std::invalid_argument("relative_accuracy must be in (0, 1)");
+  }
+  if (!(options.min_value > 0)) {
+    throw std::invalid_argument("min_value must be positive");
+  }
+  if (options.bucket_count == 0) {
+    throw std::invalid_argument("bucket_count must be positive");
+  }
+  return options;
+}
+
+}  // namespace
+
+QuantileSketch::QuantileSketch()
+: QuantileSketch(Options{})
+{
+}
+
+QuantileSketch::QuantileSketch(const Options & options)
+: options_{ValidateOptions(options)},
+  gamma_{(1 + options.relative_accuracy) / (1 - options.relative_accuracy)},
+  log_gamma_{std::log(gamma_)},
+  positive_buckets_{std::make_unique<std::atomic<uint64_t>[]>(options.bucket_count)},
+  negative_buckets_{std::make_unique<std::atomic<uint64_t>[]>(options.bucket_count)}
+{
+  Reset();
+}
+
+QuantileSketch::~QuantileSketch() = default;
+
+void QuantileSketch::AddMeasurement(const double item)
+{
+  if (std::isnan(item)) {
+    return;
+  }
+  const double magnitude = std::abs(item);
+  if (magnitude < options_.min_value) {
+    zero_bucket_.fetch_add(1, std::memory_order_relaxed);
+  } else if (item > 0) {
+    positive_buckets_[GetBucketIndex(magnitude)].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    negative_buckets_[GetBucketIndex(magnitude)].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+double QuantileSketch::GetQuantile(const double quantile) const
+{
+  if (!(quantile >= 0 && quantile <= 1)) {
+    return std::nan("");
+  }
+  const uint64_t count = GetCount();
+  if (count == 0) {
+    return std::nan("");
+  }
+
+  // Walk the buckets in ascending order of value: negative buckets from the largest magnitude,
+  // then zero, then positive buckets from the smallest magnitude. Observations added during the
+  // walk may prevent reaching the rank, in which case the last non-empty bucket is returned.
+  const double rank = quantile * static_cast<double>(count - 1);
+  uint64_t cumulative_count = 0;
+  double value = std::nan("");
+
+  for (size_t i = options_.bucket_count; i > 0; i--) {
+    const uint64_t bucket_count = negative_buckets_[i - 1].load(std::memory_order_relaxed);
+    if (bucket_count == 0) {
+      continue;
+    }
+    cumulative_count += bucket_count;
+    value = -GetBucketValue(i - 1);
+    if (static_cast<double>(cumulative_count) > rank) {
+      return value;
+    }
+  }
+
+  const uint64_t zero_count = zero_bucket_.load(std::memory_order_relaxed);
+  if (zero_count != 0) {
+    cumulative_count += zero_count;
+    value = 0;
+    if (static_cast<double>(cumulative_count) > rank) {
+      return value;
+    }
+  }
+
+  for (size_t i = 0; i < options_.bucket_count; i++) {
+    const uint64_t bucket_count = positive_buckets_[i].load(std::memory_order_relaxed);
+    if (bucket_count == 0) {
+      continue;
+    }
+    cumulative_count += bucket_count;
+    value = GetBucketValue(i);
+    if (static_cast<double>(cumulative_count) > rank) {
+      return value;
+    }
+  }
+
+  return value;
+}
+
+QuantileData QuantileSketch::GetQuantileData() const
+{
+  QuantileData to_return;
+  to_return.p50 = GetQuantile(0.5);
+  to_return.p90 = GetQuantile(0.9);
+  to_return.p99 = GetQuantile(0.99);
+  to_return.p999 = GetQuantile(0.999);
+  return to_return;
+}
+
+uint64_t QuantileSketch::GetCount() const
+{
+  uint64_t count = zero_bucket_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < options_.bucket_count; i++) {
+    count += positive_buckets_[i].load(std::memory_order_relaxed);
+    count += negative_buckets_[i].load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+bool QuantileSketch::Merge(const QuantileSketch & other)
+{
+  if (options_.relative_accuracy != other.options_.relative_accuracy ||
+    options_.min_value != other.options_.min_value ||
+    options_.bucket_count != other.options_.bucket_count)
+  {
+    return false;
+  }
+  zero_bucket_.fetch_add(
+    other.zero_bucket_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  for (size_t i = 0; i < options_.bucket_count; i++) {
+    positive_buckets_[i].fetch_add(
+      other.positive_buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    negative_buckets_[i].fetch_add(
+      other.negative_buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  return true;
+}
+
+void QuantileSketch::Reset()
+{
+  zero_bucket_.store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < options_.bucket_count; i++) {
+    positive_buckets_[i].store(0, std::memory_order_relaxed);
+    negative_buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+const QuantileSketch::Options & QuantileSketch::GetOptions() const
+{
+  return options_;
+}
+
+size_t QuantileSketch::GetBucketIndex(const double magnitude) const
+{
+  // bucket i holds magnitudes in [min_value * gamma^i, min_value * gamma^(i + 1))
+  const double index = std::floor(std::log(magnitude / options_.min_value) / log_gamma_);
+  const double last_index = static_cast<double>(options_.bucket_count - 1);
+  return static_cast<size_t>(std::min(std::max(index, 0.0), last_index));
+}
+
+double QuantileSketch::GetBucketValue(const size_t index) const
+{
+  // the point with equal relative distance to both bucket bounds
+  const double lower_bound = options_.min_value * std::exp(static_cast<double>(index) * log_gamma_);
+  return lower_bound * 2 * gamma_ / (1 + gamma_);
+}
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
@@ -0,0 +1,190 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+#include "libstatistics_collector/moving_average_statistics/sliding_window_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+namespace libstatistics_collector
+{
+namespace moving_average_statistics
+{
+
+namespace
+{
+
+constexpr const std::chrono::milliseconds kDefaultBucketDuration{100};
+constexpr const size_t kDefaultBucketCount = 10;
+
+}  // namespace
+
+SlidingWindowStatistics::SlidingWindowStatistics()
+: SlidingWindowStatistics(kDefaultBucketDuration, kDefaultBucketCount)
+{
+}
+
+SlidingWindowStatistics::SlidingWindowStatistics(
+  std::chrono::nanoseconds bucket_duration,
+  size_t bucket_count)
+: bucket_duration_{bucket_duration}
+{
+  if (bucket_duration.count() <= 0) {
+    throw std::invalid_argument("bucket_duration must be positive");
+  }
+  if (bucket_count == 0) {
+    throw std::invalid_argument("bucket_count must be positive");
+  }
+  buckets_.resize(bucket_count);
+}
+
+void SlidingWindowStatistics::AddMeasurement(const double item)
+{
+  AddMeasurement(item, Clock::now());
+}
+
+void SlidingWindowStatistics::AddMeasurement(const double item, const Clock::time_point now)
+{
+  if (std::isnan(item)) {
+    return;
+  }
+  const int64_t interval = GetInterval(now);
+
+  std::lock_guard<std::mutex> guard{mutex_};
+  Bucket * bucket = GetBucketForWrite(interval);
+  if (bucket != nullptr) {
+    bucket->state.Add(item);
+  }
+}
+
+void SlidingWindowStatistics::AddMeasurements(const double * items, size_t item_count)
+{
+  AccumulatorState block;
+  block.AddBlock(items, item_count);
+  if (block.count == 0) {
+    return;
+  }
+  const int64_t interval = GetInterval(Clock::now());
+
+  std::lock_guard<std::mutex> guard{mutex_};
+  Bucket * bucket = GetBucketForWrite(interval);
+  if (bucket != nullptr) {
+    bucket->state.Merge(block);
+  }
+}
+
+StatisticData SlidingWindowStatistics::GetStatistics() const
+{
+  return GetStatistics(Clock::now());
+}
+
+StatisticData SlidingWindowStatistics::GetStatistics(const Clock::time_point now) const
+{
+  return GetState(now).ToStatisticData();
+}
+
+AccumulatorState SlidingWindowStatistics::GetState(const Clock::time_point now) const
+{
+  const int64_t current_interval = GetInterval(now);
+  std::lock_guard<std::mutex> guard{mutex_};
+  return GetStateUnsynchronized(current_interval);
+}
+
+void SlidingWindowStatistics::Reset()
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  ResetUnsynchronized();
+}
+
+StatisticData SlidingWindowStatistics::GetStatisticsAndReset()
+{
+  const int64_t current_interval = GetInterval(Clock::now());
+  AccumulatorState state;
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    state = GetStateUnsynchronized(current_interval);
+    ResetUnsynchronized();
+  }
+  return state.ToStatisticData();
+}
+
+uint64_t SlidingWindowStatistics::GetCount() const
+{
+  return GetState(Clock::now()).count;
+}
+
+std::chrono::nanoseconds SlidingWindowStatistics::GetBucketDuration() const
+{
+  return bucket_duration_;
+}
+
+size_t SlidingWindowStatistics::GetBucketCount() const
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  return buckets_.size();
+}
+
+int64_t SlidingWindowStatistics::GetInterval(const Clock::time_point time) const
+{
+  return std::chrono::floor<std::chrono::nanoseconds>(time.time_since_epoch()).count() /
+         bucket_duration_.count();
+}
+
+SlidingWindowStatistics::Bucket * SlidingWindowStatistics::GetBucketForWrite(
+  const int64_t interval)
+{
+  const int64_t bucket_count = static_cast<int64_t>(buckets_.size());
+  if (latest_interval_ != kNoInterval && interval <= latest_interval_ - bucket_count) {
+    return nullptr;  // the window has already moved past this interval
+  }
+  latest_interval_ = std::max(latest_interval_, interval);
+
+  Bucket & bucket = buckets_[static_cast<size_t>(
+      ((interval % bucket_count) + bucket_count) % bucket_count)];
+  if (bucket.interval != interval) {
+    bucket.interval = interval;
+    bucket.state = AccumulatorState{};
+  }
+  return &bucket;
+}
+
+AccumulatorState SlidingWindowStatistics::GetStateUnsynchronized(
+  const int64_t current_interval) const
+{
+  const int64_t bucket_count = static_cast<int64_t>(buckets_.size());
+  AccumulatorState state;
+  for (const auto & bucket : buckets_) {
+    if (bucket.interval != kNoInterval && bucket.interval <= current_interval &&
+      bucket.interval > current_interval - bucket_count)
+    {
+      state.Merge(bucket.state);
+    }
+  }
+  return state;
+}
+
+void SlidingWindowStatistics::ResetUnsynchronized()
+{
+  std::fill(buckets_.begin(), buckets_.end(), Bucket{});
+  latest_interval_ = kNoInterval;
+}
+
+}  // namespace moving_average_statistics
+}  // namespace libstatistics_collector
@@ -12,8 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <system_error>
 
 #include "libstatistics_collector/moving_average_statistics/types.hpp"
 
@@ -22,13 +30,178 @@ namespace libstatistics_collector
 namespace moving_average_statistics
 {
 
+namespace
+{
+
+/// Number of independent partial accumulators in AddBlock, so the loops can be vectorized
+constexpr size_t kBlockLanes = 4;
+
+/// Decimals printed per value, matching std::to_string
+constexpr int kStringPrecision = 6;
+
+/**
+ * Append text at next if it fits before last, advancing next.
+ */
+bool AppendText(char *& next, char * const last, const std::string_view text)
+{
+  if (static_cast<size_t>(last - next) < text.size()) {
+    return false;
+  }
+  std::memcpy(next, text.data(), text.size());
+  next += text.size();
+  return true;
+}
+
+/**
+ * Append value formatted like std::to_string at next if it fits before last, advancing next.
+ */
+bool AppendValue(char *& next, char * const last, const double value)
+{
+  const auto result = std::to_chars(next, last, value, std::chars_format::fixed, kStringPrecision);
+  if (result.ec != std::errc{}) {
+    return false;
+  }
+  next = result.ptr;
+  return true;
+}
+
+bool AppendValue(char *& next, char * const last, const uint64_t value)
+{
+  const auto result = std::to_chars(next, last, value);
+  if (result.ec != std::errc{}) {
+    return false;
+  }
+  next = result.ptr;
+  return true;
+}
+
+}  // namespace
+
+void AccumulatorState::AddBlock(const double * items, size_t item_count)
+{
+  double lane_sum[kBlockLanes] = {};
+  double lane_min[kBlockLanes];
+  double lane_max[kBlockLanes];
+  uint64_t lane_count[kBlockLanes] = {};
+  std::fill(lane_min, lane_min + kBlockLanes, std::numeric_limits<double>::max());
+  std::fill(lane_max, lane_max + kBlockLanes, std::numeric_limits<double>::lowest());
+
+  // first pass: count, sum, min and max with NaNs masked out
+  for (size_t i = 0; i < item_count; i++) {
+    const size_t lane = i % kBlockLanes;
+    const double item = items[i];
+    const bool valid = !std::isnan(item);
+    lane_count[lane] += valid;
+    lane_sum[lane] += valid ? item : 0.0;
+    lane_min[lane] = std::min(lane_min[lane], valid ? item : std::numeric_limits<double>::max());
+    lane_max[lane] =
+      std::max(lane_max[lane], valid ? item : std::numeric_limits<double>::lowest());
+  }
+
+  AccumulatorState block;
+  double sum = 0;
+  for (size_t lane = 0; lane < kBlockLanes; lane++) {
+    block.count += lane_count[lane];
+    sum += lane_sum[lane];
+    block.min = std::min(block.min, lane_min[lane]);
+    block.max = std::max(block.max, lane_max[lane]);
+  }
+  if (block.count == 0) {
+    return;
+  }
+  block.average = sum / static_cast<double>(block.count);
+
+  // second pass: sum of squared differences from the block average
+  double lane_square_diff[kBlockLanes] = {};
+  for (size_t i = 0; i < item_count; i++) {
+    const double item = items[i];
+    const double diff = std::isnan(item) ? 0.0 : item - block.average;
+    lane_square_diff[i % kBlockLanes] += diff * diff;
+  }
+  for (size_t lane = 0; lane < kBlockLanes; lane++) {
+    block.sum_of_square_diff_from_mean += lane_square_diff[lane];
+  }
+
+  Merge(block);
+}
+
+void AccumulatorState::Merge(const AccumulatorState & other)
+{
+  if (other.count == 0) {
+    return;
+  }
+  if (count == 0) {
+    *this = other;
+    return;
+  }
+
+  const double count_a = static_cast<double>(count);
+  const double count_b = static_cast<double>(other.count);
+  const double total = count_a + count_b;
+  const double delta = other.average - average;
+
+  average += delta * count_b / total;
+  sum_of_square_diff_from_mean += other.sum_of_square_diff_from_mean +
+    delta * delta * count_a * count_b / total;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+  count += other.count;
+}
+
+StatisticData AccumulatorState::ToStatisticData() const
+{
+  StatisticData to_return;
+
+  if (count == 0) {
+    return to_return;  // already initialized
+  }
+
+  to_return.sample_count = count;
+  to_return.average = average;
+  to_return.min = min;
+  to_return.max = max;
+  to_return.standard_deviation = std::sqrt(
+    sum_of_square_diff_from_mean / static_cast<double>(count));
+
+  return to_return;
+}
+
+AccumulatorState AccumulatorState::FromStatisticData(const StatisticData & data)
+{
+  AccumulatorState state;
+  if (data.sample_count == 0) {
+    return state;
+  }
+  state.count = data.sample_count;
+  state.average = data.average;
+  state.min = data.min;
+  state.max = data.max;
+  state.sum_of_square_diff_from_mean =
+    data.standard_deviation * data.standard_deviation * static_cast<double>(data.sample_count);
+  return state;
+}
+
 std::string StatisticsDataToString(const StatisticData & results)
 {
-  std::stringstream ss;
-  ss << "avg=" << std::to_string(results.average) << ", min=" << std::to_string(results.min) <<
-    ", max=" << std::to_string(results.max) << ", std_dev=" << std::to_string(
-    results.standard_deviation) << ", count=" << std::to_string(results.sample_count);
-  return ss.str();
+  char buffer[kStatisticsDataStringMaxLength];
+  return std::string{StatisticsDataToString(results, buffer, sizeof(buffer))};
+}
+
+std::string_view StatisticsDataToString(
+  const StatisticData & results, char * buffer, size_t buffer_size)
+{
+  char * next = buffer;
+  char * const last = buffer + buffer_size;
+  const bool fits = AppendText(next, last, "avg=") && AppendValue(next, last, results.average) &&
+    AppendText(next, last, ", min=") && AppendValue(next, last, results.min) &&
+    AppendText(next, last, ", max=") && AppendValue(next, last, results.max) &&
+    AppendText(next, last, ", std_dev=") &&
+    AppendValue(next, last, results.standard_deviation) &&
+    AppendText(next, last, ", count=") && AppendValue(next, last, results.sample_count);
+  if (!fits) {
+    return {};
+  }
+  return std::string_view{buffer, static_cast<size_t>(next - buffer)};
 }
 
 }  // namespace moving_average_statistics
@@ -0,0 +1,86 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "libstatistics_collector/topic_statistics_collector/sampling_policy.hpp"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+namespace
+{
+
+/**
+ * Scramble a seed with the splitmix64 finalizer, so that nearby seeds give unrelated states.
+ */
+uint64_t SplitMix64(uint64_t value)
+{
+  value += 0x9E3779B97F4A7C15ull;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+}  // namespace
+
+SamplingPolicy SamplingPolicy::EveryNth(const uint64_t n)
+{
+  if (n == 0) {
+    throw std::invalid_argument("n must be positive");
+  }
+  SamplingPolicy policy;
+  if (n > 1) {
+    policy.type_ = Type::kEveryNth;
+    policy.every_nth_ = n;
+    policy.sample_rate_ = 1.0 / static_cast<double>(n);
+  }
+  return policy;
+}
+
+SamplingPolicy SamplingPolicy::Bernoulli(const double probability)
+{
+  if (!(probability > 0 && probability <= 1)) {
+    throw std::invalid_argument("probability must be in (0, 1]");
+  }
+  SamplingPolicy policy;
+  if (probability < 1) {
+    policy.type_ = Type::kBernoulli;
+    policy.threshold_ =
+      static_cast<uint64_t>(std::ldexp(probability, 64 - kRandomDiscardedBits));
+    policy.sample_rate_ = probability;
+  }
+  return policy;
+}
+
+uint64_t SamplingPolicy::NextRandom()
+{
+  // seeded per thread from the address of its state and the time the thread first samples
+  thread_local uint64_t state = SplitMix64(
+    reinterpret_cast<uintptr_t>(&state) ^
+    static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) | 1;
+
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545F4914F6CDD1Dull;
+}
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
@@ -0,0 +1,186 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define LIBSTATISTICS_COLLECTOR_HAS_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define LIBSTATISTICS_COLLECTOR_HAS_TSC
+#endif
+
+#include "libstatistics_collector/topic_statistics_collector/steady_time_source.hpp"
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+
+namespace
+{
+
+rcl_time_point_value_t SteadyClockNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#if defined(LIBSTATISTICS_COLLECTOR_HAS_TSC)
+/// CPUID leaf of the advanced power management information
+constexpr const unsigned int kCpuidAdvancedPowerManagementLeaf = 0x80000007;
+/// Bit of the invariant TSC flag in EDX of kCpuidAdvancedPowerManagementLeaf
+constexpr const unsigned int kCpuidInvariantTscBit = 1u << 8;
+
+/**
+ * Return whether the time stamp counter runs at a constant rate regardless of the frequency and
+ * power state of the core, without which its calibration is only valid at the calibrated
+ * frequency.
+ */
+bool HasInvariantTsc()
+{
+  unsigned int edx = 0;
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0x80000000);
+  if (static_cast<unsigned int>(info[0]) < kCpuidAdvancedPowerManagementLeaf) {
+    return false;
+  }
+  __cpuid(info, kCpuidAdvancedPowerManagementLeaf);
+  edx = static_cast<unsigned int>(info[3]);
+#else
+  unsigned int eax, ebx, ecx;
+  // checks the highest supported extended leaf first
+  if (!__get_cpuid(kCpuidAdvancedPowerManagementLeaf, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+#endif
+  return (edx & kCpuidInvariantTscBit) != 0;
+}
+
+/**
+ * Conversion of time stamp counter values to steady clock nanoseconds.
+ */
+struct TscCalibration
+{
+  uint64_t counter_origin;
+  rcl_time_point_value_t time_origin;
+  double nanoseconds_per_count;
+};
+
+/// Duration the time stamp counter is measured against the steady clock
+constexpr const std::chrono::milliseconds kTscCalibrationDuration{10};
+
+TscCalibration CalibrateTsc()
+{
+  TscCalibration calibration;
+  calibration.counter_origin = __rdtsc();
+  calibration.time_origin = SteadyClockNow();
+
+  // busy wait rather than sleep, so that the counter keeps the frequency of a running core
+  const auto calibration_end = std::chrono::steady_clock::now() + kTscCalibrationDuration;
+  while (std::chrono::steady_clock::now() < calibration_end) {
+  }
+  const uint64_t counter_end = __rdtsc();
+  const rcl_time_point_value_t time_end = SteadyClockNow();
+
+  calibration.nanoseconds_per_count = static_cast<double>(time_end - calibration.time_origin) /
+    static_cast<double>(counter_end - calibration.counter_origin);
+  return calibration;
+}
+
+const TscCalibration & GetTscCalibration()
+{
+  static const TscCalibration calibration = CalibrateTsc();
+  return calibration;
+}
+#endif
+
+}  // namespace
+
+SteadyTimeSource::SteadyTimeSource(const SteadyTimeSourceType type)
+: type_{IsSupported(type) ? type : SteadyTimeSourceType::kSteadyClock}
+{
+#if defined(LIBSTATISTICS_COLLECTOR_HAS_TSC)
+  if (type_ == SteadyTimeSourceType::kTsc) {
+    GetTscCalibration();
+  }
+#endif
+}
+
+rcl_time_point_value_t SteadyTimeSource::Now() const
+{
+  switch (type_) {
+#if defined(__linux__)
+    case SteadyTimeSourceType::kMonotonicCoarse:
+      {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+        return RCL_S_TO_NS(static_cast<rcl_time_point_value_t>(now.tv_sec)) + now.tv_nsec;
+      }
+#endif
+#if defined(LIBSTATISTICS_COLLECTOR_HAS_TSC)
+    case SteadyTimeSourceType::kTsc:
+      {
+        const auto & calibration = GetTscCalibration();
+        // signed, in case another core's counter is slightly behind the calibrating one
+        const auto counts = static_cast<int64_t>(__rdtsc() - calibration.counter_origin);
+        return calibration.time_origin + static_cast<rcl_time_point_value_t>(
+          static_cast<double>(counts) * calibration.nanoseconds_per_count);
+      }
+#endif
+    case SteadyTimeSourceType::kSteadyClock:
+    default:
+      return SteadyClockNow();
+  }
+}
+
+SteadyTimeSourceType SteadyTimeSource::GetType() const
+{
+  return type_;
+}
+
+bool SteadyTimeSource::IsSupported(const SteadyTimeSourceType type)
+{
+  switch (type) {
+    case SteadyTimeSourceType::kMonotonicCoarse:
+#if defined(__linux__)
+      return true;
+#else
+      return false;
+#endif
+    case SteadyTimeSourceType::kTsc:
+#if defined(LIBSTATISTICS_COLLECTOR_HAS_TSC)
+      {
+        static const bool invariant_tsc = HasInvariantTsc();
+        return invariant_tsc;
+      }
+#else
+      return false;
+#endif
+    case SteadyTimeSourceType::kSteadyClock:
+    default:
+      return true;
+  }
+}
+
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
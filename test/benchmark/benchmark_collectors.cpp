@@ -0,0 +1,523 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "libstatistics_collector/collector/aggregation_tree.hpp"
+#include "libstatistics_collector/collector/background_publisher.hpp"
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/collector/collector_pool.hpp"
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/collector/statistics_stream.hpp"
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+#include "libstatistics_collector/msg/dummy_message.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_age.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_jitter.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_rate.hpp"
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcl/time.h"
+#include "rcutils/macros.h"
+
+// Benchmarks of the collectors under realistic load: varying measurements, concurrent writers and
+// readers, messages with std_msgs headers, and the message and string generation of a window.
+// The performance_test_fixture reports the heap allocations of every benchmark.
+
+using performance_test_fixture::PerformanceTest;
+using libstatistics_collector::collector::AggregationTree;
+using libstatistics_collector::collector::BackgroundPublisher;
+using libstatistics_collector::collector::Collector;
+using libstatistics_collector::collector::CollectorPool;
+using libstatistics_collector::collector::GenerateStatisticMessage;
+using libstatistics_collector::collector::StatisticsStreamReader;
+using libstatistics_collector::collector::StatisticsStreamWriter;
+using libstatistics_collector::collector::UpdateStatisticMessage;
+using libstatistics_collector::moving_average_statistics::ExactDurationStatistics;
+using libstatistics_collector::moving_average_statistics::WriterMode;
+using libstatistics_collector::topic_statistics_collector::FinalReceivedMessageAgeCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessageAgeCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessageJitterCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessagePeriodCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessageRateCollector;
+
+namespace
+{
+using DummyMessage = libstatistics_collector::msg::DummyMessage;
+
+constexpr const char kTestNodeName[] = "test_node_name";
+constexpr const char kTestMetricName[] = "test_metric_name";
+constexpr const char kTestMetricUnit[] = "test_metric_unit";
+/// Number of distinct measurements cycled through, a power of two
+constexpr const uint64_t kMeasurementCycle = 1024;
+/// Period of the simulated publisher, 1 kHz
+constexpr const rcl_time_point_value_t kMessagePeriod = RCL_MS_TO_NS(1);
+/// Messages per statistics window, 1 s at the simulated rate
+constexpr const uint64_t kWindowMessageCount = 1000;
+
+/**
+ * Return a measurement varying with the iteration, so that min, max and the variance change
+ */
+double GetMeasurement(const uint64_t iteration)
+{
+  return static_cast<double>(iteration % kMeasurementCycle) * 0.01;
+}
+
+/**
+ * Return the receive time of a message from a publisher with some jitter
+ */
+rcl_time_point_value_t GetReceiveTime(const uint64_t message_index)
+{
+  const auto jitter = static_cast<rcl_time_point_value_t>(message_index % 7) * RCL_US_TO_NS(10);
+  return RCL_S_TO_NS(1) + static_cast<rcl_time_point_value_t>(message_index) * kMessagePeriod +
+         jitter;
+}
+
+builtin_interfaces::msg::Time ToTime(const rcl_time_point_value_t nanoseconds)
+{
+  builtin_interfaces::msg::Time time;
+  time.sec = static_cast<int32_t>(RCL_NS_TO_S(nanoseconds));
+  time.nanosec = static_cast<uint32_t>(nanoseconds % RCL_S_TO_NS(1));
+  return time;
+}
+
+/// Metrics of the recorded statistics streams
+constexpr const uint32_t kStreamMetricCount = 10;
+
+/**
+ * A stream buffer discarding everything written to it
+ */
+class NullBuffer : public std::streambuf
+{
+protected:
+  int overflow(const int c) override
+  {
+    return c;
+  }
+
+  std::streamsize xsputn(const char *, const std::streamsize count) override
+  {
+    return count;
+  }
+};
+
+/**
+ * Return statistics of a window varying slowly with the window, like those of a steady topic
+ */
+libstatistics_collector::moving_average_statistics::StatisticData GetWindowStatistics(
+  const uint64_t window)
+{
+  libstatistics_collector::moving_average_statistics::StatisticData statistics;
+  statistics.average = 10.0 + GetMeasurement(window / 16);
+  statistics.min = 9.5;
+  statistics.max = 10.5 + GetMeasurement(window / 4);
+  statistics.standard_deviation = 0.25;
+  statistics.sample_count = kWindowMessageCount + window % 3;
+  return statistics;
+}
+
+/**
+ * A collector of generic measurements
+ */
+class TestCollector : public Collector
+{
+public:
+  explicit TestCollector(WriterMode writer_mode)
+  : Collector{writer_mode} {}
+
+  std::string GetMetricName() const override
+  {
+    return kTestMetricName;
+  }
+
+  std::string GetMetricUnit() const override
+  {
+    return kTestMetricUnit;
+  }
+
+protected:
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+};
+
+/**
+ * Accept measurements from all benchmark threads into one collector
+ */
+void RunAcceptDataContended(benchmark::State & st, Collector & collector)
+{
+  uint64_t iteration = static_cast<uint64_t>(st.thread_index());
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.AcceptData(GetMeasurement(iteration++));
+  }
+  st.SetItemsProcessed(static_cast<int64_t>(st.iterations()));
+}
+
+/**
+ * Accept measurements from all benchmark threads but thread 0, which reads the statistics
+ */
+void RunAcceptDataWithReader(benchmark::State & st, Collector & collector)
+{
+  uint64_t iteration = static_cast<uint64_t>(st.thread_index());
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (st.thread_index() == 0) {
+      benchmark::DoNotOptimize(collector.GetStatisticsResults());
+    } else {
+      collector.AcceptData(GetMeasurement(iteration++));
+    }
+  }
+}
+
+/**
+ * Feed a collector messages with header stamps, as a subscription does, ending a window every
+ * kWindowMessageCount messages like a statistics timer does
+ */
+template<typename CollectorT>
+void RunOnMessageReceived(benchmark::State & st, CollectorT & collector)
+{
+  collector.Start();
+  DummyMessage msg;
+  uint64_t message_index = 0;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    const rcl_time_point_value_t now = GetReceiveTime(message_index);
+    const rcl_time_point_value_t stamp = now - RCL_US_TO_NS(100 + message_index % 100);
+    msg.header.stamp.sec = static_cast<int32_t>(RCL_NS_TO_S(stamp));
+    msg.header.stamp.nanosec = static_cast<uint32_t>(stamp % RCL_S_TO_NS(1));
+    collector.OnMessageReceived(msg, now);
+    if (++message_index % kWindowMessageCount == 0) {
+      benchmark::DoNotOptimize(collector.GetStatisticsAndReset());
+    }
+  }
+  collector.Stop();
+}
+
+/**
+ * Fill a collector with a window of measurements
+ */
+void FillCollector(Collector & collector)
+{
+  for (uint64_t i = 0; i < kWindowMessageCount; i++) {
+    collector.AcceptData(GetMeasurement(i));
+  }
+}
+}  // namespace
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, accept_data_contended_multi_writer)(benchmark::State & st)
+{
+  static TestCollector collector{WriterMode::kMultiWriter};
+  RunAcceptDataContended(st, collector);
+}
+BENCHMARK_REGISTER_F(PerformanceTest, accept_data_contended_multi_writer)->ThreadRange(1, 16)->
+UseRealTime();
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, accept_data_contended_sharded)(benchmark::State & st)
+{
+  static TestCollector collector{WriterMode::kSharded};
+  RunAcceptDataContended(st, collector);
+}
+BENCHMARK_REGISTER_F(PerformanceTest, accept_data_contended_sharded)->ThreadRange(1, 16)->
+UseRealTime();
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, accept_data_with_reader_multi_writer)(benchmark::State & st)
+{
+  static TestCollector collector{WriterMode::kMultiWriter};
+  RunAcceptDataWithReader(st, collector);
+}
+BENCHMARK_REGISTER_F(PerformanceTest, accept_data_with_reader_multi_writer)->Threads(2)->
+Threads(4)->UseRealTime();
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, accept_data_with_reader_sharded)(benchmark::State & st)
+{
+  static TestCollector collector{WriterMode::kSharded};
+  RunAcceptDataWithReader(st, collector);
+}
+BENCHMARK_REGISTER_F(PerformanceTest, accept_data_with_reader_sharded)->Threads(2)->Threads(4)->
+UseRealTime();
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, age_collector_end_to_end)(benchmark::State & st)
+{
+  ReceivedMessageAgeCollector<DummyMessage> collector;
+  RunOnMessageReceived(st, collector);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_end_to_end)(benchmark::State & st)
+{
+  ReceivedMessagePeriodCollector<DummyMessage> collector;
+  RunOnMessageReceived(st, collector);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, exact_age_collector_end_to_end)(benchmark::State & st)
+{
+  ReceivedMessageAgeCollector<DummyMessage> collector{std::make_unique<ExactDurationStatistics>()};
+  RunOnMessageReceived(st, collector);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, exact_period_collector_end_to_end)(benchmark::State & st)
+{
+  ReceivedMessagePeriodCollector<DummyMessage> collector{
+    std::make_unique<ExactDurationStatistics>()};
+  RunOnMessageReceived(st, collector);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, jitter_collector_end_to_end)(benchmark::State & st)
+{
+  ReceivedMessageJitterCollector<DummyMessage> collector{std::chrono::nanoseconds{kMessagePeriod}};
+  RunOnMessageReceived(st, collector);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, rate_collector_end_to_end)(benchmark::State & st)
+{
+  ReceivedMessageRateCollector<DummyMessage> collector;
+  RunOnMessageReceived(st, collector);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, heap_collector_churn)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    auto collector = std::make_unique<FinalReceivedMessageAgeCollector<DummyMessage>>();
+    benchmark::DoNotOptimize(collector.get());
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, pooled_collector_churn)(benchmark::State & st)
+{
+  CollectorPool<FinalReceivedMessageAgeCollector<DummyMessage>> pool;
+  pool.Destroy(pool.Create());  // allocate the first slab outside of the measurement
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    const auto handle = pool.Create();
+    benchmark::DoNotOptimize(pool.Get(handle));
+    pool.Destroy(handle);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, aggregation_tree_rollup)(benchmark::State & st)
+{
+  // one node of 10 topics with 10 subscriptions each
+  constexpr size_t kTopicCount = 10;
+  constexpr size_t kSubscriptionCount = 10;
+  AggregationTree tree{kTestNodeName};
+  std::vector<std::shared_ptr<TestCollector>> collectors;
+  const auto node = tree.AddGroup(kTestMetricName, kTestMetricUnit);
+  for (size_t i = 0; i < kTopicCount; i++) {
+    const auto topic = tree.AddGroup(kTestMetricName, kTestMetricUnit, node);
+    for (size_t j = 0; j < kSubscriptionCount; j++) {
+      collectors.push_back(std::make_shared<TestCollector>(WriterMode::kMultiWriter));
+      tree.AddCollector(collectors.back(), kTestMetricName, topic);
+    }
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    st.PauseTiming();
+    for (auto & collector : collectors) {
+      FillCollector(*collector);
+    }
+    st.ResumeTiming();
+    benchmark::DoNotOptimize(tree.GetStatisticsAndReset());
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, generate_statistic_message)(benchmark::State & st)
+{
+  TestCollector collector{WriterMode::kMultiWriter};
+  FillCollector(collector);
+  const auto statistics = collector.GetStatisticsResults();
+  const std::string node_name{kTestNodeName};
+  const std::string metric_name{kTestMetricName};
+  const std::string metric_unit{kTestMetricUnit};
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(
+      GenerateStatisticMessage(
+        node_name, metric_name, metric_unit, ToTime(0), ToTime(RCL_S_TO_NS(1)), statistics));
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, update_statistic_message)(benchmark::State & st)
+{
+  TestCollector collector{WriterMode::kMultiWriter};
+  FillCollector(collector);
+  const auto statistics = collector.GetStatisticsResults();
+  auto msg = GenerateStatisticMessage(
+    kTestNodeName, kTestMetricName, kTestMetricUnit, ToTime(0), ToTime(1), statistics);
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    UpdateStatisticMessage(msg, ToTime(0), ToTime(RCL_S_TO_NS(1)), statistics);
+    benchmark::DoNotOptimize(msg);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, background_publisher_submit)(benchmark::State & st)
+{
+  // the work left on the thread ending a window, compare with generate_statistic_message
+  TestCollector collector{WriterMode::kMultiWriter};
+  FillCollector(collector);
+  const auto statistics = collector.GetStatisticsResults();
+  constexpr size_t kQueueCapacity = 1024;
+  BackgroundPublisher::Options options;
+  options.queue_capacity = kQueueCapacity;
+  BackgroundPublisher publisher{
+    kTestNodeName, [](const statistics_msgs::msg::MetricsMessage & msg) {
+      benchmark::DoNotOptimize(msg);
+    }, options};
+  const size_t id = publisher.AddMetric(kTestMetricName, kTestMetricUnit);
+
+  size_t submitted = 0;
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (submitted++ == kQueueCapacity) {
+      // publish the queued windows outside of the measurement, so that no window is dropped
+      st.PauseTiming();
+      publisher.Start();
+      publisher.Stop();
+      submitted = 1;
+      st.ResumeTiming();
+    }
+    benchmark::DoNotOptimize(publisher.Submit(id, ToTime(0), ToTime(RCL_S_TO_NS(1)), statistics));
+  }
+  if (publisher.GetDroppedCount() != 0) {
+    st.SkipWithError("windows were dropped");
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, get_status_string)(benchmark::State & st)
+{
+  TestCollector collector{WriterMode::kMultiWriter};
+  FillCollector(collector);
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(collector.GetStatusString());
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, format_status_string)(benchmark::State & st)
+{
+  TestCollector collector{WriterMode::kMultiWriter};
+  FillCollector(collector);
+  char buffer[Collector::kStatusStringMaxLength];
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(collector.FormatStatusString(buffer, sizeof(buffer)));
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, statistics_stream_write)(benchmark::State & st)
+{
+  NullBuffer buffer;
+  std::ostream stream{&buffer};
+  StatisticsStreamWriter writer{stream};
+  for (uint32_t i = 0; i < kStreamMetricCount; i++) {
+    writer.InternMetric(kTestNodeName, kTestMetricName + std::to_string(i), kTestMetricUnit);
+  }
+
+  uint64_t window = 0;
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    for (uint32_t id = 0; id < kStreamMetricCount; id++) {
+      const auto stop = static_cast<int64_t>(RCL_S_TO_NS(window + 1));
+      writer.Write(id, stop - RCL_S_TO_NS(1), stop, GetWindowStatistics(window));
+    }
+    window++;
+  }
+  st.SetItemsProcessed(st.iterations() * kStreamMetricCount);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, statistics_stream_read_all)(benchmark::State & st)
+{
+  constexpr uint64_t kWindowCount = 1000;
+  std::stringstream stream;
+  {
+    StatisticsStreamWriter writer{stream};
+    for (uint32_t i = 0; i < kStreamMetricCount; i++) {
+      writer.InternMetric(kTestNodeName, kTestMetricName + std::to_string(i), kTestMetricUnit);
+    }
+    for (uint64_t window = 0; window < kWindowCount; window++) {
+      for (uint32_t id = 0; id < kStreamMetricCount; id++) {
+        const auto stop = static_cast<int64_t>(RCL_S_TO_NS(window + 1));
+        writer.Write(id, stop - RCL_S_TO_NS(1), stop, GetWindowStatistics(window));
+      }
+    }
+  }
+  const std::string bytes = stream.str();
+  StatisticsStreamReader reader{reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size()};
+  st.counters["bytes_per_record"] =
+    static_cast<double>(bytes.size()) / static_cast<double>(reader.GetRecordCount());
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(reader.ReadAll());
+  }
+  st.SetItemsProcessed(st.iterations() * static_cast<int64_t>(reader.GetRecordCount()));
+}
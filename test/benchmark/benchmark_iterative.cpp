@@ -12,23 +12,74 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
 #include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_age.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_statistics.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_serialized_message_age.hpp"
+#include "libstatistics_collector/topic_statistics_collector/topic_statistics_collector.hpp"
+
+#include "builtin_interfaces/msg/time.hpp"
 
 #include "performance_test_fixture/performance_test_fixture.hpp"
 
 #include "rcutils/macros.h"
 
 using performance_test_fixture::PerformanceTest;
+using libstatistics_collector::moving_average_statistics::BasicMovingAverageStatistics;
+using libstatistics_collector::moving_average_statistics::LogLinearHistogram;
 using libstatistics_collector::moving_average_statistics::MovingAverageStatistics;
+using libstatistics_collector::moving_average_statistics::kStatisticMax;
+using libstatistics_collector::moving_average_statistics::WriterMode;
 using libstatistics_collector::collector::Collector;
+using libstatistics_collector::topic_statistics_collector::FinalReceivedMessageAgeCollector;
+using libstatistics_collector::topic_statistics_collector::FinalReceivedMessagePeriodCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessageAgeCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessagePeriodCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessageStatisticsCollector;
+using libstatistics_collector::topic_statistics_collector::ReceivedSerializedMessageAgeCollector;
+using libstatistics_collector::topic_statistics_collector::SamplingPolicy;
+using libstatistics_collector::topic_statistics_collector::SteadyTimeSource;
+using libstatistics_collector::topic_statistics_collector::SteadyTimeSourceType;
+using libstatistics_collector::topic_statistics_collector::TopicStatisticsCollector;
 
 namespace
 {
 constexpr const char kTestMetricName[] = "test_metric_name";
 constexpr const char kTestMetricUnit[] = "test_metric_unit";
+
+/**
+ * Minimal message with a header stamp, as detected by HasHeader
+ */
+struct StampedMessage
+{
+  struct
+  {
+    builtin_interfaces::msg::Time stamp;
+  } header;
+};
+
+/**
+ * Feed messages to a collector like a subscription callback does
+ */
+template<typename CollectorT, typename MessageT>
+void RunOnMessageReceived(benchmark::State & st, CollectorT & collector, const MessageT & msg)
+{
+  int64_t now_nanoseconds = 1000000000;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.OnMessageReceived(msg, now_nanoseconds++);
+  }
+}
 }
 
 /**
@@ -38,6 +89,8 @@ class TestCollector : public libstatistics_collector::collector::Collector
 {
 public:
   TestCollector() = default;
+  explicit TestCollector(WriterMode writer_mode)
+  : Collector{writer_mode} {}
   ~TestCollector() override = default;
 
   /**
@@ -99,3 +152,312 @@ BENCHMARK_F(PerformanceTest, add_measurement)(benchmark::State & st)
     moving_average_statistics.AddMeasurement(0);
   }
 }
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, add_measurement_log_linear_histogram)(benchmark::State & st)
+{
+  LogLinearHistogram histogram;
+  double measurement = 0;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    histogram.AddMeasurement(measurement);
+    measurement = measurement < 1000 ? measurement + 1.5 : 0;
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, collector_accept_data_single_writer)(benchmark::State & st)
+{
+  TestCollector collector{WriterMode::kSingleWriter};
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.AcceptData(0);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, add_measurement_single_writer)(benchmark::State & st)
+{
+  MovingAverageStatistics moving_average_statistics{WriterMode::kSingleWriter};
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    moving_average_statistics.AddMeasurement(0);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, add_measurement_contended)(benchmark::State & st)
+{
+  static MovingAverageStatistics moving_average_statistics;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    moving_average_statistics.AddMeasurement(0);
+  }
+}
+BENCHMARK_REGISTER_F(PerformanceTest, add_measurement_contended)->Threads(4);
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, add_measurement_sharded)(benchmark::State & st)
+{
+  static MovingAverageStatistics moving_average_statistics{WriterMode::kSharded};
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    moving_average_statistics.AddMeasurement(0);
+  }
+}
+BENCHMARK_REGISTER_F(PerformanceTest, add_measurement_sharded)->Threads(4);
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, add_measurements_batch)(benchmark::State & st)
+{
+  MovingAverageStatistics moving_average_statistics;
+  const std::vector<double> batch(static_cast<size_t>(st.range(0)), 0.0);
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    moving_average_statistics.AddMeasurements(batch.data(), batch.size());
+  }
+  st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTest, add_measurements_batch)->Arg(1)->Arg(16)->Arg(256)->Arg(
+  4096);
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, collector_accept_data_batch)(benchmark::State & st)
+{
+  TestCollector collector;
+  const std::vector<double> batch(static_cast<size_t>(st.range(0)), 0.0);
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.AcceptData(batch.data(), batch.size());
+  }
+  st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTest, collector_accept_data_batch)->Arg(1)->Arg(16)->Arg(256)->Arg(
+  4096);
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, add_measurement_count_and_max)(benchmark::State & st)
+{
+  BasicMovingAverageStatistics<kStatisticMax> moving_average_statistics;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    moving_average_statistics.AddMeasurement(0);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_DEFINE_F(PerformanceTest, collector_accept_data_with_reader)(benchmark::State & st)
+{
+  // thread 0 polls the collector state like a control or diagnostics thread, the others write
+  static TestCollector collector{WriterMode::kSharded};
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (st.thread_index() == 0) {
+      benchmark::DoNotOptimize(collector.IsStarted());
+      benchmark::DoNotOptimize(collector.GetStatisticsResults());
+    } else {
+      collector.AcceptData(0);
+    }
+  }
+}
+BENCHMARK_REGISTER_F(PerformanceTest, collector_accept_data_with_reader)->Threads(2)->Threads(4);
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received)(benchmark::State & st)
+{
+  ReceivedMessagePeriodCollector<int> collector;
+  int64_t now_nanoseconds = 1;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.OnMessageReceived(0, now_nanoseconds++);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_single_writer)(
+  benchmark::State & st)
+{
+  ReceivedMessagePeriodCollector<int> collector{WriterMode::kSingleWriter};
+  int64_t now_nanoseconds = 1;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.OnMessageReceived(0, now_nanoseconds++);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_double_lock)(
+  benchmark::State & st)
+{
+  // baseline: the period collector used to lock its own mutex around the accumulator's lock
+  TestCollector collector;
+  std::mutex mutex;
+  int64_t time_last_message_received = 0;
+  int64_t now_nanoseconds = 1;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    std::lock_guard<std::mutex> guard{mutex};
+    const int64_t period = now_nanoseconds - time_last_message_received;
+    time_last_message_received = now_nanoseconds++;
+    collector.AcceptData(static_cast<double>(period) / 1e6);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, age_collector_on_message_received_virtual)(benchmark::State & st)
+{
+  std::unique_ptr<TopicStatisticsCollector<StampedMessage>> collector =
+    std::make_unique<ReceivedMessageAgeCollector<StampedMessage>>();
+  // hide the dynamic type from the optimizer, as it is hidden from a generic subscription
+  benchmark::DoNotOptimize(collector);
+  StampedMessage msg{};
+  msg.header.stamp.sec = 1;
+  RunOnMessageReceived(st, *collector, msg);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, age_collector_on_message_received_final)(benchmark::State & st)
+{
+  FinalReceivedMessageAgeCollector<StampedMessage> collector;
+  StampedMessage msg{};
+  msg.header.stamp.sec = 1;
+  RunOnMessageReceived(st, collector, msg);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, age_collector_on_message_received_final_no_header)(
+  benchmark::State & st)
+{
+  FinalReceivedMessageAgeCollector<int> collector;
+  RunOnMessageReceived(st, collector, 0);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_final_single_writer)(
+  benchmark::State & st)
+{
+  FinalReceivedMessagePeriodCollector<int> collector{WriterMode::kSingleWriter};
+  RunOnMessageReceived(st, collector, 0);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, age_and_period_collectors_on_message_received)(
+  benchmark::State & st)
+{
+  ReceivedMessageAgeCollector<StampedMessage> age_collector;
+  ReceivedMessagePeriodCollector<StampedMessage> period_collector;
+  StampedMessage msg{};
+  msg.header.stamp.sec = 1;
+  int64_t now_nanoseconds = 1000000000;
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    age_collector.OnMessageReceived(msg, now_nanoseconds);
+    period_collector.OnMessageReceived(msg, now_nanoseconds++);
+  }
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, statistics_collector_on_message_received)(benchmark::State & st)
+{
+  ReceivedMessageStatisticsCollector<StampedMessage> collector;
+  StampedMessage msg{};
+  msg.header.stamp.sec = 1;
+  RunOnMessageReceived(st, collector, msg);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, statistics_collector_on_message_received_with_jitter)(
+  benchmark::State & st)
+{
+  ReceivedMessageStatisticsCollector<StampedMessage> collector{true};
+  StampedMessage msg{};
+  msg.header.stamp.sec = 1;
+  RunOnMessageReceived(st, collector, msg);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, age_collector_on_message_received_every_100th)(
+  benchmark::State & st)
+{
+  FinalReceivedMessageAgeCollector<StampedMessage> collector;
+  collector.SetSamplingPolicy(SamplingPolicy::EveryNth(100));
+  StampedMessage msg{};
+  msg.header.stamp.sec = 1;
+  RunOnMessageReceived(st, collector, msg);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_bernoulli_1_percent)(
+  benchmark::State & st)
+{
+  FinalReceivedMessagePeriodCollector<int> collector;
+  collector.SetSamplingPolicy(SamplingPolicy::Bernoulli(0.01));
+  RunOnMessageReceived(st, collector, 0);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, serialized_age_collector_on_message_received)(
+  benchmark::State & st)
+{
+  ReceivedSerializedMessageAgeCollector collector;
+  // CDR_LE std_msgs/Header with a stamp of 1 s and an empty frame_id
+  uint8_t buffer[] = {0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0};
+  rcl_serialized_message_t serialized_message{};
+  serialized_message.buffer = buffer;
+  serialized_message.buffer_length = sizeof(buffer);
+  serialized_message.buffer_capacity = sizeof(buffer);
+  RunOnMessageReceived(st, collector, serialized_message);
+}
+
+namespace
+{
+/**
+ * Feed messages to a period collector stamping them with the given time source
+ */
+void RunSelfStampedOnMessageReceived(benchmark::State & st, const SteadyTimeSourceType type)
+{
+  FinalReceivedMessagePeriodCollector<int> collector{WriterMode::kSingleWriter};
+  collector.SetTimeSource(SteadyTimeSource{type});
+  if (collector.GetTimeSource().GetType() != type) {
+    st.SkipWithError("time source not supported");
+  }
+
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    collector.OnMessageReceived(0);
+  }
+}
+}  // namespace
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_steady_clock)(
+  benchmark::State & st)
+{
+  RunSelfStampedOnMessageReceived(st, SteadyTimeSourceType::kSteadyClock);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_monotonic_coarse)(
+  benchmark::State & st)
+{
+  RunSelfStampedOnMessageReceived(st, SteadyTimeSourceType::kMonotonicCoarse);
+}
+
+// cppcheck-suppress unknownMacro
+BENCHMARK_F(PerformanceTest, period_collector_on_message_received_tsc)(benchmark::State & st)
+{
+  RunSelfStampedOnMessageReceived(st, SteadyTimeSourceType::kTsc);
+}
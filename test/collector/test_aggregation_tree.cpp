@@ -0,0 +1,215 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "libstatistics_collector/collector/aggregation_tree.hpp"
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
+#include "libstatistics_collector/topic_statistics_collector/sampling_policy.hpp"
+
+#include "rcl/time.h"
+
+namespace
+{
+using libstatistics_collector::collector::AggregationTree;
+using libstatistics_collector::moving_average_statistics::MovingAverageStatistics;
+using libstatistics_collector::topic_statistics_collector::SamplingPolicy;
+using ReceivedIntMessagePeriodCollector =
+  libstatistics_collector::topic_statistics_collector::ReceivedMessagePeriodCollector<int>;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricUnit[] = "test_metric_unit";
+
+/**
+ * Minimal collector
+ */
+class TestCollector : public libstatistics_collector::collector::Collector
+{
+public:
+  std::string GetMetricName() const override
+  {
+    return "test_metric";
+  }
+
+  std::string GetMetricUnit() const override
+  {
+    return kMetricUnit;
+  }
+
+private:
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+};
+
+builtin_interfaces::msg::Time MakeTime(const int32_t sec)
+{
+  builtin_interfaces::msg::Time time;
+  time.sec = sec;
+  return time;
+}
+
+/**
+ * A node with two topics, the first with two subscriptions, the second with one.
+ */
+class AggregationTreeTest : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    node_ = tree_.AddGroup("message_age", kMetricUnit);
+    topic_a_ = tree_.AddGroup("/a/message_age", kMetricUnit, node_);
+    topic_b_ = tree_.AddGroup("/b/message_age", kMetricUnit, node_);
+    subscription_a1_ = tree_.AddCollector(a1_, "/a/1/message_age", topic_a_);
+    subscription_a2_ = tree_.AddCollector(a2_, "/a/2/message_age", topic_a_);
+    subscription_b1_ = tree_.AddCollector(b1_, "/b/1/message_age", topic_b_);
+
+    for (const double value : {1.0, 2.0, 3.0}) {
+      a1_->AcceptData(value);
+      expected_a_.AddMeasurement(value);
+    }
+    for (const double value : {10.0, 20.0}) {
+      a2_->AcceptData(value);
+      expected_a_.AddMeasurement(value);
+    }
+    b1_->AcceptData(-5.0);
+  }
+
+protected:
+  AggregationTree tree_{kNodeName};
+  std::shared_ptr<TestCollector> a1_ = std::make_shared<TestCollector>();
+  std::shared_ptr<TestCollector> a2_ = std::make_shared<TestCollector>();
+  std::shared_ptr<TestCollector> b1_ = std::make_shared<TestCollector>();
+  MovingAverageStatistics expected_a_;
+  AggregationTree::NodeId node_;
+  AggregationTree::NodeId topic_a_;
+  AggregationTree::NodeId topic_b_;
+  AggregationTree::NodeId subscription_a1_;
+  AggregationTree::NodeId subscription_a2_;
+  AggregationTree::NodeId subscription_b1_;
+};
+}  // namespace
+
+TEST_F(AggregationTreeTest, TestLazyRollup) {
+  EXPECT_EQ(6u, tree_.GetNodeCount());
+
+  const auto topic_a = tree_.GetStatistics(topic_a_);
+  const auto expected = expected_a_.GetStatistics();
+  EXPECT_EQ(5u, topic_a.sample_count);
+  EXPECT_DOUBLE_EQ(expected.average, topic_a.average);
+  EXPECT_DOUBLE_EQ(expected.standard_deviation, topic_a.standard_deviation);
+  EXPECT_EQ(1.0, topic_a.min);
+  EXPECT_EQ(20.0, topic_a.max);
+  EXPECT_EQ(1.0, topic_a.sample_rate);
+
+  const auto node = tree_.GetStatistics(node_);
+  EXPECT_EQ(6u, node.sample_count);
+  EXPECT_EQ(-5.0, node.min);
+  EXPECT_DOUBLE_EQ(31.0 / 6, node.average);
+
+  EXPECT_EQ(3u, tree_.GetStatistics(subscription_a1_).sample_count);
+  EXPECT_EQ(3u, a1_->GetStatisticsResults().sample_count) << "reading does not reset";
+}
+
+TEST_F(AggregationTreeTest, TestGetStatisticsAndReset) {
+  const auto statistics = tree_.GetStatisticsAndReset();
+  ASSERT_EQ(6u, statistics.size());
+  EXPECT_EQ(6u, statistics[node_].sample_count);
+  EXPECT_EQ(5u, statistics[topic_a_].sample_count);
+  EXPECT_EQ(1u, statistics[topic_b_].sample_count);
+  EXPECT_EQ(-5.0, statistics[topic_b_].average);
+  EXPECT_EQ(2u, statistics[subscription_a2_].sample_count);
+  EXPECT_EQ(15.0, statistics[subscription_a2_].average);
+
+  EXPECT_EQ(0u, a1_->GetStatisticsResults().sample_count) << "collectors are reset";
+  EXPECT_EQ(0u, tree_.GetStatistics(node_).sample_count);
+  EXPECT_TRUE(std::isnan(tree_.GetStatistics(node_).average));
+}
+
+TEST_F(AggregationTreeTest, TestGenerateStatisticMessages) {
+  const auto messages = tree_.GenerateStatisticMessages(MakeTime(1), MakeTime(2));
+  ASSERT_EQ(6u, messages.size());
+  const std::vector<std::string> expected_names{
+    "message_age", "/a/message_age", "/b/message_age",
+    "/a/1/message_age", "/a/2/message_age", "/b/1/message_age"};
+  for (size_t i = 0; i < messages.size(); i++) {
+    EXPECT_EQ(kNodeName, messages[i].measurement_source_name);
+    EXPECT_EQ(expected_names[i], messages[i].metrics_source);
+    EXPECT_EQ(kMetricUnit, messages[i].unit);
+    EXPECT_EQ(1, messages[i].window_start.sec);
+    EXPECT_EQ(2, messages[i].window_stop.sec);
+  }
+}
+
+TEST_F(AggregationTreeTest, TestRemove) {
+  tree_.Remove(topic_a_);
+  EXPECT_EQ(3u, tree_.GetNodeCount());
+  EXPECT_EQ(1u, tree_.GetStatistics(node_).sample_count);
+  EXPECT_THROW(tree_.GetStatistics(subscription_a1_), std::invalid_argument);
+  EXPECT_THROW(tree_.AddCollector(a1_, "/a/3/message_age", topic_a_), std::invalid_argument);
+
+  // removed ids are ignored, and are not reused
+  tree_.Remove(topic_a_);
+  tree_.Remove(subscription_a1_);
+  EXPECT_EQ(3u, tree_.GetNodeCount());
+  const auto subscription_b2 =
+    tree_.AddCollector(std::make_shared<TestCollector>(), "/b/2/message_age", topic_b_);
+  EXPECT_EQ(6u, subscription_b2);
+
+  const auto messages = tree_.GenerateStatisticMessages(MakeTime(1), MakeTime(2));
+  EXPECT_EQ(4u, messages.size());
+  EXPECT_EQ(3u, a1_->GetStatisticsResults().sample_count) << "removed collectors are not reset";
+}
+
+TEST_F(AggregationTreeTest, TestSampleRate) {
+  // a subscription measuring the period of one message in four
+  auto sampled = std::make_shared<ReceivedIntMessagePeriodCollector>();
+  sampled->SetSamplingPolicy(SamplingPolicy::EveryNth(4));
+  ASSERT_TRUE(sampled->Start());
+  for (int i = 1; i <= 9; i++) {
+    sampled->OnMessageReceived(0, RCL_S_TO_NS(i));
+  }
+  const auto subscription_b2 = tree_.AddCollector(sampled, "/b/2/message_period", topic_b_);
+  const auto subscription = tree_.GetStatistics(subscription_b2);
+  ASSERT_EQ(2u, subscription.sample_count);
+  ASSERT_EQ(0.25, subscription.sample_rate);
+
+  // topic b sampled 3 of an estimated 1 + 2 / 0.25 observations
+  const auto topic_b = tree_.GetStatistics(topic_b_);
+  EXPECT_EQ(3u, topic_b.sample_count);
+  EXPECT_DOUBLE_EQ(1.0 / 3, topic_b.sample_rate);
+}
+
+TEST_F(AggregationTreeTest, TestInvalidArguments) {
+  EXPECT_THROW(tree_.AddGroup("group", kMetricUnit, subscription_a1_), std::invalid_argument);
+  EXPECT_THROW(tree_.AddGroup("group", kMetricUnit, 100), std::invalid_argument);
+  EXPECT_THROW(tree_.AddCollector(nullptr, "collector", node_), std::invalid_argument);
+  EXPECT_THROW(
+    tree_.AddCollector(a1_, "collector", AggregationTree::kNoParent), std::invalid_argument);
+  EXPECT_THROW(tree_.GetStatistics(100), std::invalid_argument);
+}
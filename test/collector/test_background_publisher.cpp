@@ -0,0 +1,198 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libstatistics_collector/collector/background_publisher.hpp"
+
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+namespace
+{
+using libstatistics_collector::collector::BackgroundPublisher;
+using libstatistics_collector::moving_average_statistics::StatisticData;
+using statistics_msgs::msg::MetricsMessage;
+using statistics_msgs::msg::StatisticDataType;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricUnit[] = "test_metric_unit";
+
+builtin_interfaces::msg::Time MakeTime(const int32_t sec)
+{
+  builtin_interfaces::msg::Time time;
+  time.sec = sec;
+  return time;
+}
+
+StatisticData MakeStatistics(const double average)
+{
+  StatisticData statistics;
+  statistics.average = average;
+  statistics.min = average;
+  statistics.max = average;
+  statistics.standard_deviation = 0;
+  statistics.sample_count = 1;
+  return statistics;
+}
+
+double GetDataPoint(const MetricsMessage & msg, const uint8_t data_type)
+{
+  for (const auto & point : msg.statistics) {
+    if (point.data_type == data_type) {
+      return point.data;
+    }
+  }
+  ADD_FAILURE() << "no data point of type " << static_cast<int>(data_type);
+  return 0;
+}
+
+BackgroundPublisher::Options MakeOptions(const size_t queue_capacity)
+{
+  BackgroundPublisher::Options options;
+  options.queue_capacity = queue_capacity;
+  options.poll_period = std::chrono::milliseconds{1};
+  return options;
+}
+}  // namespace
+
+TEST(BackgroundPublisherTest, TestPublishSubmittedWindows) {
+  // only accessed by the background thread until it is stopped
+  std::vector<MetricsMessage> published;
+  std::thread::id publish_thread_id;
+  BackgroundPublisher publisher{
+    kNodeName, [&](const MetricsMessage & msg) {
+      published.push_back(msg);
+      publish_thread_id = std::this_thread::get_id();
+    }, MakeOptions(16)};
+  const size_t first = publisher.AddMetric("first_metric", kMetricUnit);
+  const size_t second = publisher.AddMetric("second_metric", kMetricUnit);
+
+  // windows submitted before starting are kept
+  EXPECT_TRUE(publisher.Submit(first, MakeTime(0), MakeTime(1), MakeStatistics(1.0)));
+  EXPECT_FALSE(publisher.IsStarted());
+  EXPECT_TRUE(publisher.Start());
+  EXPECT_FALSE(publisher.Start());
+  EXPECT_TRUE(publisher.IsStarted());
+  EXPECT_TRUE(publisher.Submit(second, MakeTime(0), MakeTime(1), MakeStatistics(2.0)));
+  EXPECT_TRUE(publisher.Submit(first, MakeTime(1), MakeTime(2), MakeStatistics(3.0)));
+  EXPECT_TRUE(publisher.Stop());
+  EXPECT_FALSE(publisher.Stop());
+  EXPECT_FALSE(publisher.IsStarted());
+
+  ASSERT_EQ(3u, published.size());
+  EXPECT_EQ(3u, publisher.GetPublishedCount());
+  EXPECT_EQ(0u, publisher.GetDroppedCount());
+  EXPECT_NE(std::this_thread::get_id(), publish_thread_id);
+
+  EXPECT_EQ(kNodeName, published[0].measurement_source_name);
+  EXPECT_EQ("first_metric", published[0].metrics_source);
+  EXPECT_EQ(kMetricUnit, published[0].unit);
+  EXPECT_EQ(1, published[0].window_stop.sec);
+  EXPECT_EQ(1.0, GetDataPoint(published[0], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  EXPECT_EQ("second_metric", published[1].metrics_source);
+  EXPECT_EQ(2.0, GetDataPoint(published[1], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  EXPECT_EQ("first_metric", published[2].metrics_source);
+  EXPECT_EQ(1, published[2].window_start.sec);
+  EXPECT_EQ(3.0, GetDataPoint(published[2], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+
+  // a restarted publisher keeps publishing
+  EXPECT_TRUE(publisher.Start());
+  EXPECT_TRUE(publisher.Submit(second, MakeTime(1), MakeTime(2), MakeStatistics(4.0)));
+  EXPECT_TRUE(publisher.Stop());
+  EXPECT_EQ(4u, published.size());
+}
+
+TEST(BackgroundPublisherTest, TestDroppedWindows) {
+  int published = 0;
+  BackgroundPublisher publisher{
+    kNodeName, [&published](const MetricsMessage &) {published++;}, MakeOptions(2)};
+  const size_t id = publisher.AddMetric("metric", kMetricUnit);
+
+  EXPECT_FALSE(publisher.Submit(id + 1, MakeTime(0), MakeTime(1), MakeStatistics(1.0)));
+  EXPECT_TRUE(publisher.Submit(id, MakeTime(0), MakeTime(1), MakeStatistics(1.0)));
+  EXPECT_TRUE(publisher.Submit(id, MakeTime(1), MakeTime(2), MakeStatistics(2.0)));
+  EXPECT_FALSE(publisher.Submit(id, MakeTime(2), MakeTime(3), MakeStatistics(3.0)));
+  EXPECT_EQ(2u, publisher.GetDroppedCount());
+
+  EXPECT_TRUE(publisher.Start());
+  EXPECT_TRUE(publisher.Stop());
+  EXPECT_EQ(2, published);
+}
+
+TEST(BackgroundPublisherTest, TestPublishFailure) {
+  int calls = 0;
+  BackgroundPublisher publisher{
+    kNodeName, [&calls](const MetricsMessage &) {
+      if (calls++ == 0) {
+        throw std::runtime_error("publish failed");
+      }
+    }, MakeOptions(4)};
+  const size_t id = publisher.AddMetric("metric", kMetricUnit);
+  publisher.Submit(id, MakeTime(0), MakeTime(1), MakeStatistics(1.0));
+  publisher.Submit(id, MakeTime(1), MakeTime(2), MakeStatistics(2.0));
+  publisher.Start();
+  publisher.Stop();
+
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ(1u, publisher.GetPublishFailureCount());
+  EXPECT_EQ(1u, publisher.GetPublishedCount());
+}
+
+TEST(BackgroundPublisherTest, TestConcurrentSubmit) {
+  constexpr int kThreads = 4;
+  constexpr int kWindowsPerThread = 1000;
+  uint64_t published = 0;
+  BackgroundPublisher publisher{
+    kNodeName, [&published](const MetricsMessage &) {published++;}, MakeOptions(64)};
+  std::array<size_t, kThreads> ids;
+  for (auto & id : ids) {
+    id = publisher.AddMetric("metric_" + std::to_string(&id - ids.data()), kMetricUnit);
+  }
+  ASSERT_TRUE(publisher.Start());
+
+  std::array<std::thread, kThreads> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads[t] = std::thread([&publisher, id = ids[t]]() {
+          for (int i = 0; i < kWindowsPerThread; i++) {
+            publisher.Submit(id, MakeTime(i), MakeTime(i + 1), MakeStatistics(i));
+          }
+        });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  ASSERT_TRUE(publisher.Stop());
+
+  // every window is either published or counted as dropped
+  EXPECT_EQ(kThreads * kWindowsPerThread, published + publisher.GetDroppedCount());
+  EXPECT_EQ(published, publisher.GetPublishedCount());
+}
+
+TEST(BackgroundPublisherTest, TestInvalidArguments) {
+  EXPECT_THROW(
+    BackgroundPublisher(kNodeName, BackgroundPublisher::PublishCallback{}), std::invalid_argument);
+  const auto publish = [](const MetricsMessage &) {};
+  EXPECT_THROW(BackgroundPublisher(kNodeName, publish, MakeOptions(0)), std::invalid_argument);
+  auto options = MakeOptions(1);
+  options.poll_period = std::chrono::nanoseconds{0};
+  EXPECT_THROW(BackgroundPublisher(kNodeName, publish, options), std::invalid_argument);
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "libstatistics_collector/collector/bounded_queue.hpp"
+
+using libstatistics_collector::collector::BoundedQueue;
+
+TEST(BoundedQueueTest, TestPushPop) {
+  BoundedQueue<int> queue{3};
+  EXPECT_EQ(4u, queue.GetCapacity());
+
+  int value = 0;
+  EXPECT_FALSE(queue.TryPop(value));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(4));
+
+  // elements come out in order, and the cells are reused after a lap
+  for (int lap = 0; lap < 3; lap++) {
+    for (int i = 0; i < 4; i++) {
+      ASSERT_TRUE(queue.TryPop(value));
+      EXPECT_EQ(lap * 4 + i, value);
+      EXPECT_TRUE(queue.TryPush((lap + 1) * 4 + i));
+    }
+  }
+  EXPECT_THROW(BoundedQueue<int>{0}, std::invalid_argument);
+}
+
+TEST(BoundedQueueTest, TestConcurrentProducers) {
+  constexpr int kThreads = 4;
+  constexpr int kValuesPerThread = 10000;
+  BoundedQueue<uint64_t> queue{64};
+
+  std::array<std::thread, kThreads> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads[t] = std::thread([&queue, t]() {
+          for (int i = 0; i < kValuesPerThread; i++) {
+            const auto value = static_cast<uint64_t>(t) * kValuesPerThread + i;
+            while (!queue.TryPush(value)) {
+              std::this_thread::yield();
+            }
+          }
+        });
+  }
+
+  // every value is popped once, and the values of each producer in order
+  std::vector<int> next_values(kThreads, 0);
+  for (int popped = 0; popped < kThreads * kValuesPerThread; ) {
+    uint64_t value;
+    if (!queue.TryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const auto thread = static_cast<size_t>(value / kValuesPerThread);
+    ASSERT_LT(thread, next_values.size());
+    ASSERT_EQ(static_cast<uint64_t>(next_values[thread]), value % kValuesPerThread);
+    next_values[thread]++;
+    popped++;
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  uint64_t value;
+  EXPECT_FALSE(queue.TryPop(value));
+}
@@ -14,10 +14,20 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "libstatistics_collector/moving_average_statistics/exponential_moving_average.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
+#include "libstatistics_collector/moving_average_statistics/sliding_window_statistics.hpp"
 #include "libstatistics_collector/moving_average_statistics/types.hpp"
 
 #include "libstatistics_collector/collector/collector.hpp"
@@ -35,6 +45,10 @@ class TestCollector : public libstatistics_collector::collector::Collector
 {
 public:
   TestCollector() = default;
+  explicit TestCollector(
+    std::unique_ptr<libstatistics_collector::moving_average_statistics::AccumulatorInterface>
+    accumulator)
+  : Collector{std::move(accumulator)} {}
   ~TestCollector() override = default;
 
   /**
@@ -124,6 +138,139 @@ TEST_F(CollectorTestFixure, TestAddAndClearMeasurement) {
   ASSERT_EQ(0, stats.sample_count);
 }
 
+TEST_F(CollectorTestFixure, TestAcceptDataBlock) {
+  const double measurements[] = {1, 2, 3, 4};
+  test_collector_->AcceptData(measurements, 4);
+  test_collector_->AcceptData(5);
+  const auto stats = test_collector_->GetStatisticsResults();
+  EXPECT_EQ(5, stats.sample_count);
+  EXPECT_DOUBLE_EQ(3, stats.average);
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(5, stats.max);
+}
+
+TEST_F(CollectorTestFixure, TestGetStatisticsAndReset) {
+  test_collector_->AcceptData(1);
+  test_collector_->AcceptData(3);
+  auto stats = test_collector_->GetStatisticsAndReset();
+  EXPECT_EQ(2, stats.sample_count);
+  EXPECT_DOUBLE_EQ(2, stats.average);
+
+  stats = test_collector_->GetStatisticsResults();
+  EXPECT_EQ(0, stats.sample_count);
+  EXPECT_TRUE(std::isnan(stats.average));
+}
+
+TEST_F(CollectorTestFixure, TestQuantileEstimation) {
+  test_collector_->AcceptData(1);
+  auto quantiles = test_collector_->GetQuantileResults();
+  EXPECT_FALSE(test_collector_->IsQuantileEstimationEnabled());
+  EXPECT_TRUE(std::isnan(quantiles.p50));
+
+  test_collector_->EnableQuantileEstimation();
+  EXPECT_TRUE(test_collector_->IsQuantileEstimationEnabled());
+  const double measurements[] = {1, 2, 3, 4};
+  test_collector_->AcceptData(measurements, 4);
+  test_collector_->AcceptData(5);
+  quantiles = test_collector_->GetQuantileResults();
+  EXPECT_NEAR(3, quantiles.p50, 3 * 0.01);
+  EXPECT_NEAR(4, quantiles.p90, 4 * 0.01);
+
+  test_collector_->ClearCurrentMeasurements();
+  EXPECT_TRUE(std::isnan(test_collector_->GetQuantileResults().p50));
+}
+
+TEST_F(CollectorTestFixure, TestGetStatisticsAndQuantilesAndReset) {
+  test_collector_->EnableQuantileEstimation();
+  test_collector_->AcceptData(3);
+  test_collector_->AcceptData(3);
+  libstatistics_collector::moving_average_statistics::QuantileData quantiles;
+  const auto stats = test_collector_->GetStatisticsAndQuantilesAndReset(quantiles);
+  EXPECT_EQ(2, stats.sample_count);
+  EXPECT_NEAR(3, quantiles.p50, 3 * 0.01);
+
+  // the next window covers only the measurements after the reset
+  test_collector_->AcceptData(10);
+  EXPECT_NEAR(10, test_collector_->GetQuantileResults().p50, 10 * 0.01);
+  test_collector_->GetStatisticsAndReset();
+  EXPECT_TRUE(std::isnan(test_collector_->GetQuantileResults().p50));
+}
+
+TEST_F(CollectorTestFixure, TestGetStatisticsAndHistogramAndReset) {
+  using libstatistics_collector::moving_average_statistics::HistogramBucket;
+  using libstatistics_collector::moving_average_statistics::LogLinearHistogram;
+  std::vector<HistogramBucket> buckets{HistogramBucket{}};
+  test_collector_->AcceptData(3);
+  EXPECT_FALSE(test_collector_->IsHistogramEnabled());
+  EXPECT_EQ(1, test_collector_->GetStatisticsAndHistogramAndReset(buckets).sample_count);
+  EXPECT_TRUE(buckets.empty());
+
+  TestCollector collector{std::make_unique<LogLinearHistogram>()};
+  EXPECT_TRUE(collector.IsHistogramEnabled());
+  const double measurements[] = {1, 1, 2};
+  collector.AcceptData(measurements, 3);
+  const auto stats = collector.GetStatisticsAndHistogramAndReset(buckets);
+  EXPECT_EQ(3, stats.sample_count);
+  ASSERT_EQ(2u, buckets.size());
+  EXPECT_EQ(2u, buckets[0].count);
+  EXPECT_EQ(1u, buckets[1].count);
+
+  // the next window covers only the measurements after the reset
+  collector.AcceptData(2);
+  EXPECT_EQ(1, collector.GetStatisticsAndHistogramAndReset(buckets).sample_count);
+  ASSERT_EQ(1u, buckets.size());
+  EXPECT_EQ(1u, buckets[0].count);
+}
+
+TEST_F(CollectorTestFixure, TestCustomAccumulator) {
+  using libstatistics_collector::moving_average_statistics::SlidingWindowStatistics;
+  EXPECT_THROW(TestCollector{nullptr}, std::invalid_argument);
+
+  TestCollector collector{std::make_unique<SlidingWindowStatistics>(std::chrono::hours{1}, 2)};
+  const double measurements[] = {1, 2, 3, 4};
+  collector.AcceptData(measurements, 4);
+  collector.AcceptData(5);
+  auto stats = collector.GetStatisticsResults();
+  EXPECT_EQ(5, stats.sample_count);
+  EXPECT_DOUBLE_EQ(3, stats.average);
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(5, stats.max);
+
+  collector.ClearCurrentMeasurements();
+  stats = collector.GetStatisticsResults();
+  EXPECT_EQ(0, stats.sample_count);
+  EXPECT_TRUE(std::isnan(stats.average));
+}
+
+TEST_F(CollectorTestFixure, TestExponentialMovingAverage) {
+  using libstatistics_collector::moving_average_statistics::ExponentialMovingAverageStatistics;
+  TestCollector collector{std::make_unique<ExponentialMovingAverageStatistics>(0.5)};
+  collector.AcceptData(4);
+  collector.AcceptData(8);
+  auto stats = collector.GetStatisticsResults();
+  EXPECT_EQ(2, stats.sample_count);
+  EXPECT_DOUBLE_EQ(6, stats.average);
+  EXPECT_DOUBLE_EQ(2, stats.standard_deviation);
+}
+
+TEST_F(CollectorTestFixure, TestIsStartedConcurrently) {
+  std::atomic<bool> done{false};
+  std::thread reader([this, &done]() {
+      while (!done) {
+        test_collector_->IsStarted();
+      }
+    });
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(test_collector_->Start());
+    EXPECT_TRUE(test_collector_->IsStarted());
+    EXPECT_TRUE(test_collector_->Stop());
+  }
+  done = true;
+  reader.join();
+  using libstatistics_collector::moving_average_statistics::kCacheLineSize;
+  EXPECT_EQ(0u, alignof(TestCollector) % kCacheLineSize);
+}
+
 TEST_F(CollectorTestFixure, TestStartAndStop) {
   ASSERT_FALSE(test_collector_->IsStarted());
   ASSERT_EQ(
@@ -143,4 +290,17 @@ TEST_F(CollectorTestFixure, TestStartAndStop) {
 TEST_F(CollectorTestFixure, TestGetMetricNameAndUnit) {
   EXPECT_FALSE(test_collector_->GetMetricName().empty());
   EXPECT_FALSE(test_collector_->GetMetricUnit().empty());
+  // not overridden by TestCollector
+  EXPECT_TRUE(test_collector_->GetMetricNameView().empty());
+  EXPECT_TRUE(test_collector_->GetMetricUnitView().empty());
+}
+
+TEST_F(CollectorTestFixure, TestFormatStatusString) {
+  test_collector_->AcceptData(2);
+  char buffer[TestCollector::kStatusStringMaxLength];
+  EXPECT_EQ(
+    test_collector_->GetStatusString(),
+    test_collector_->FormatStatusString(buffer, sizeof(buffer)));
+  EXPECT_TRUE(test_collector_->FormatStatusString(buffer, 10).empty());
+  EXPECT_TRUE(test_collector_->FormatStatusString(buffer, 20).empty());
 }
@@ -0,0 +1,185 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/collector/collector_pool.hpp"
+#include "libstatistics_collector/instrumentation.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_age.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
+
+#include "rcl/time.h"
+
+using libstatistics_collector::collector::CollectorHandle;
+using libstatistics_collector::collector::CollectorPool;
+using libstatistics_collector::topic_statistics_collector::FinalReceivedMessageAgeCollector;
+using libstatistics_collector::topic_statistics_collector::FinalReceivedMessagePeriodCollector;
+
+namespace
+{
+using PeriodCollectorPool = CollectorPool<FinalReceivedMessagePeriodCollector<int>>;
+
+constexpr const int kDefaultMessage{42};
+
+/**
+ * Counts its live instances, and throws from its constructor if asked to.
+ */
+struct CountedObject
+{
+  explicit CountedObject(const int value, const bool fail = false)
+  : value{value}
+  {
+    if (fail) {
+      throw std::runtime_error("failed");
+    }
+    live_count++;
+  }
+
+  ~CountedObject()
+  {
+    live_count--;
+  }
+
+  static int live_count;
+  int value;
+};
+
+int CountedObject::live_count = 0;
+}  // namespace
+
+TEST(CollectorPoolTest, TestCreateGetDestroy) {
+  PeriodCollectorPool pool;
+  EXPECT_EQ(0u, pool.GetSlabCount()) << "no slab is allocated before the first collector";
+
+  const auto handle = pool.Create();
+  ASSERT_TRUE(handle.IsValid());
+  auto * collector = pool.Get(handle);
+  ASSERT_NE(nullptr, collector);
+  EXPECT_EQ(1u, pool.GetSize());
+  EXPECT_EQ(PeriodCollectorPool::kDefaultSlabSize, pool.GetCapacity());
+
+  EXPECT_TRUE(collector->Start());
+  collector->OnMessageReceived(kDefaultMessage, RCL_S_TO_NS(1));
+  collector->OnMessageReceived(kDefaultMessage, RCL_S_TO_NS(2));
+  EXPECT_EQ(1, collector->GetStatisticsResults().sample_count);
+
+  EXPECT_TRUE(pool.Destroy(handle));
+  EXPECT_EQ(nullptr, pool.Get(handle));
+  EXPECT_FALSE(pool.Destroy(handle)) << "a collector is only destroyed once";
+  EXPECT_EQ(0u, pool.GetSize());
+
+  EXPECT_EQ(nullptr, pool.Get(CollectorHandle{}));
+  EXPECT_FALSE(pool.Destroy(CollectorHandle{}));
+}
+
+TEST(CollectorPoolTest, TestSlotsAreRecycled) {
+  PeriodCollectorPool pool{4};
+  std::vector<CollectorHandle> handles;
+  for (int i = 0; i < 4; i++) {
+    handles.push_back(pool.Create());
+  }
+  EXPECT_TRUE(pool.Destroy(handles[1]));
+  EXPECT_TRUE(pool.Destroy(handles[2]));
+
+  // the most recently freed slot is reused first, with a new generation
+  const auto recycled = pool.Create();
+  EXPECT_EQ(handles[2].index, recycled.index);
+  EXPECT_NE(handles[2], recycled);
+  EXPECT_EQ(nullptr, pool.Get(handles[2])) << "stale handles stay invalid after reuse";
+  EXPECT_NE(nullptr, pool.Get(recycled));
+  EXPECT_EQ(handles[1].index, pool.Create().index);
+  EXPECT_EQ(1u, pool.GetSlabCount());
+
+  // a fresh collector does not inherit the state of the previous one
+  auto * collector = pool.Get(recycled);
+  EXPECT_FALSE(collector->IsStarted());
+  EXPECT_EQ(0u, collector->GetMessageCount());
+}
+
+TEST(CollectorPoolTest, TestSlabsAreContiguous) {
+  constexpr size_t kSlabSize = 8;
+  CollectorPool<FinalReceivedMessageAgeCollector<int>> pool{kSlabSize};
+  std::vector<CollectorHandle> handles;
+  for (size_t i = 0; i < kSlabSize + 1; i++) {
+    handles.push_back(pool.Create());
+  }
+  EXPECT_EQ(2u, pool.GetSlabCount());
+  EXPECT_EQ(2 * kSlabSize, pool.GetCapacity());
+
+  const auto * first = pool.Get(handles[0]);
+  for (size_t i = 1; i < kSlabSize; i++) {
+    EXPECT_EQ(first + i, pool.Get(handles[i]));
+  }
+  for (const auto & handle : handles) {
+    EXPECT_EQ(
+      0u, reinterpret_cast<std::uintptr_t>(pool.Get(handle)) %
+      libstatistics_collector::moving_average_statistics::kCacheLineSize);
+  }
+}
+
+TEST(CollectorPoolTest, TestMaximumSize) {
+  PeriodCollectorPool pool{2, 2};
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(pool.Create().IsValid());
+  }
+  EXPECT_FALSE(pool.Create().IsValid());
+  EXPECT_EQ(4u, pool.GetSize());
+
+  EXPECT_THROW(PeriodCollectorPool(0, 1), std::invalid_argument);
+  EXPECT_THROW(PeriodCollectorPool(1, 0), std::invalid_argument);
+  EXPECT_THROW(PeriodCollectorPool(1u << 16, 1u << 16), std::invalid_argument);
+}
+
+TEST(CollectorPoolTest, TestLifetimes) {
+  {
+    CollectorPool<CountedObject> pool{2};
+    const auto first = pool.Create(1);
+    pool.Create(2);
+    pool.Create(3);
+    EXPECT_EQ(3, CountedObject::live_count);
+    EXPECT_EQ(1, pool.Get(first)->value);
+
+    EXPECT_TRUE(pool.Destroy(first));
+    EXPECT_EQ(2, CountedObject::live_count);
+
+    // a constructor that throws leaves the slot free
+    EXPECT_THROW(pool.Create(4, true), std::runtime_error);
+    EXPECT_EQ(2u, pool.GetSize());
+    EXPECT_EQ(first.index, pool.Create(5).index);
+
+    std::set<int> values;
+    pool.ForEach(
+      [&values](const CountedObject & object, const CollectorHandle &) {
+        values.insert(object.value);
+      });
+    EXPECT_EQ((std::set<int>{2, 3, 5}), values);
+  }
+  EXPECT_EQ(0, CountedObject::live_count) << "the pool destroys its remaining collectors";
+}
+
+#if defined(__x86_64__) && defined(__GLIBCXX__)
+TEST(CollectorPoolTest, TestDocumentedSizes) {
+  // the sizes documented in the README, on x86-64 with libstdc++
+  constexpr bool kInstrumented = libstatistics_collector::kInstrumentationEnabled;
+  EXPECT_EQ(kInstrumented ? 320u : 256u, sizeof(libstatistics_collector::collector::Collector));
+  EXPECT_EQ(320u, sizeof(FinalReceivedMessageAgeCollector<int>));
+  EXPECT_EQ(kInstrumented ? 448u : 384u, sizeof(FinalReceivedMessagePeriodCollector<int>));
+}
+#endif
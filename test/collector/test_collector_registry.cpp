@@ -0,0 +1,247 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/collector/collector_registry.hpp"
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
+
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+namespace
+{
+using libstatistics_collector::collector::CollectorRegistry;
+using statistics_msgs::msg::StatisticDataType;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricUnit[] = "test_metric_unit";
+
+/**
+ * Minimal collector with a configurable metric name
+ */
+class TestCollector : public libstatistics_collector::collector::Collector
+{
+public:
+  explicit TestCollector(std::string metric_name)
+  : metric_name_{std::move(metric_name)} {}
+
+  TestCollector(
+    std::string metric_name,
+    std::unique_ptr<libstatistics_collector::moving_average_statistics::AccumulatorInterface>
+    accumulator)
+  : Collector{std::move(accumulator)}, metric_name_{std::move(metric_name)} {}
+
+  std::string GetMetricName() const override
+  {
+    return metric_name_;
+  }
+
+  std::string GetMetricUnit() const override
+  {
+    return kMetricUnit;
+  }
+
+private:
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+
+  const std::string metric_name_;
+};
+
+builtin_interfaces::msg::Time MakeTime(const int32_t sec)
+{
+  builtin_interfaces::msg::Time time;
+  time.sec = sec;
+  return time;
+}
+
+double GetDataPoint(const statistics_msgs::msg::MetricsMessage & msg, const uint8_t data_type)
+{
+  for (const auto & point : msg.statistics) {
+    if (point.data_type == data_type) {
+      return point.data;
+    }
+  }
+  ADD_FAILURE() << "no data point of type " << static_cast<int>(data_type);
+  return 0;
+}
+}  // namespace
+
+TEST(CollectorRegistryTest, TestEmpty) {
+  CollectorRegistry registry{kNodeName, MakeTime(0)};
+  EXPECT_THROW(registry.Register(nullptr), std::invalid_argument);
+  EXPECT_TRUE(registry.GenerateStatisticMessages(MakeTime(1)).empty());
+  EXPECT_EQ(0u, registry.GetCollectorCount());
+}
+
+TEST(CollectorRegistryTest, TestGenerateStatisticMessages) {
+  CollectorRegistry registry{kNodeName, MakeTime(0)};
+  auto first = std::make_shared<TestCollector>("first");
+  auto second = std::make_shared<TestCollector>("second");
+  registry.Register(first);
+  registry.Register(second);
+  first->AcceptData(1);
+  first->AcceptData(3);
+  second->AcceptData(10);
+
+  const auto & messages = registry.GenerateStatisticMessages(MakeTime(1));
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ(kNodeName, messages[0].measurement_source_name);
+  EXPECT_EQ("first", messages[0].metrics_source);
+  EXPECT_EQ(kMetricUnit, messages[0].unit);
+  EXPECT_EQ(0, messages[0].window_start.sec);
+  EXPECT_EQ(1, messages[0].window_stop.sec);
+  EXPECT_EQ(2, GetDataPoint(messages[0], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  EXPECT_EQ("second", messages[1].metrics_source);
+  EXPECT_EQ(10, GetDataPoint(messages[1], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+
+  // the statistics were reset and the next window starts where the previous one stopped
+  EXPECT_EQ(0u, first->GetStatisticsResults().sample_count);
+  second->AcceptData(20);
+  registry.GenerateStatisticMessages(MakeTime(2));
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ(1, messages[1].window_start.sec);
+  EXPECT_EQ(2, messages[1].window_stop.sec);
+  EXPECT_EQ(
+    0, GetDataPoint(messages[0], StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT));
+  EXPECT_EQ(20, GetDataPoint(messages[1], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+}
+
+TEST(CollectorRegistryTest, TestFirstWindowStart) {
+  CollectorRegistry registry{kNodeName, MakeTime(100)};
+  registry.Register(std::make_shared<TestCollector>("before"));
+  const auto & messages = registry.GenerateStatisticMessages(MakeTime(101));
+  ASSERT_EQ(1u, messages.size());
+  EXPECT_EQ(100, messages[0].window_start.sec);
+
+  // a collector registered later starts at the end of the previous sweep
+  registry.Register(std::make_shared<TestCollector>("after"));
+  registry.GenerateStatisticMessages(MakeTime(102));
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ(101, messages[1].window_start.sec);
+}
+
+TEST(CollectorRegistryTest, TestQuantilesCoverTheWindow) {
+  using libstatistics_collector::collector::kStatisticsDataTypeP50;
+  CollectorRegistry registry{kNodeName, MakeTime(0)};
+  auto collector = std::make_shared<TestCollector>("quantiles");
+  collector->EnableQuantileEstimation();
+  registry.Register(collector);
+  collector->AcceptData(100);
+
+  const auto & messages = registry.GenerateStatisticMessages(MakeTime(1));
+  ASSERT_EQ(1u, messages.size());
+  EXPECT_NEAR(100, GetDataPoint(messages[0], kStatisticsDataTypeP50), 100 * 0.01);
+
+  // the quantiles of the next window do not include the measurement of the previous one
+  collector->AcceptData(1);
+  registry.GenerateStatisticMessages(MakeTime(2));
+  EXPECT_EQ(1, GetDataPoint(messages[0], StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM));
+  EXPECT_NEAR(1, GetDataPoint(messages[0], kStatisticsDataTypeP50), 0.01);
+}
+
+TEST(CollectorRegistryTest, TestHistogramCoversTheWindow) {
+  using libstatistics_collector::collector::kStatisticsDataTypeHistogramCount;
+  using libstatistics_collector::moving_average_statistics::LogLinearHistogram;
+  CollectorRegistry registry{kNodeName, MakeTime(0)};
+  auto collector =
+    std::make_shared<TestCollector>("histogram", std::make_unique<LogLinearHistogram>());
+  registry.Register(collector);
+  collector->AcceptData(1);
+  collector->AcceptData(1);
+  collector->AcceptData(100);
+
+  const auto & messages = registry.GenerateStatisticMessages(MakeTime(1));
+  ASSERT_EQ(1u, messages.size());
+  // two buckets of three data points each, after the statistics
+  ASSERT_EQ(5u + 2 * 3, messages[0].statistics.size());
+  EXPECT_EQ(2, GetDataPoint(messages[0], kStatisticsDataTypeHistogramCount));
+
+  // the buckets of the next window do not include the measurements of the previous one
+  collector->AcceptData(100);
+  registry.GenerateStatisticMessages(MakeTime(2));
+  ASSERT_EQ(5u + 3, messages[0].statistics.size());
+  EXPECT_EQ(1, GetDataPoint(messages[0], kStatisticsDataTypeHistogramCount));
+}
+
+TEST(CollectorRegistryTest, TestUnregister) {
+  CollectorRegistry registry{kNodeName, MakeTime(0)};
+  std::vector<CollectorRegistry::Handle> handles;
+  for (const auto * name : {"first", "second", "third"}) {
+    handles.push_back(registry.Register(std::make_shared<TestCollector>(name)));
+  }
+  registry.GenerateStatisticMessages(MakeTime(1));
+  EXPECT_EQ(3u, registry.GetCollectorCount());
+
+  registry.Unregister(handles[0]);
+  registry.Unregister(handles[0]);
+  auto late = std::make_shared<TestCollector>("late");
+  registry.Register(late);
+  const auto & messages = registry.GenerateStatisticMessages(MakeTime(2));
+  ASSERT_EQ(3u, messages.size());
+  EXPECT_EQ("third", messages[0].metrics_source);
+  EXPECT_EQ("second", messages[1].metrics_source);
+  EXPECT_EQ("late", messages[2].metrics_source);
+  EXPECT_EQ(1, messages[2].window_start.sec);
+
+  // a collector registered and unregistered before a sweep is never included
+  registry.Unregister(registry.Register(std::make_shared<TestCollector>("transient")));
+  registry.Unregister(handles[1]);
+  registry.Unregister(handles[2]);
+  ASSERT_EQ(1u, registry.GenerateStatisticMessages(MakeTime(3)).size());
+  EXPECT_EQ("late", messages[0].metrics_source);
+}
+
+TEST(CollectorRegistryTest, TestConcurrentRegistration) {
+  CollectorRegistry registry{kNodeName, MakeTime(0)};
+  constexpr int kCollectors = 100;
+  std::atomic<bool> done{false};
+  std::thread registrar([&registry, &done]() {
+      for (int i = 0; i < kCollectors; i++) {
+        auto collector = std::make_shared<TestCollector>(std::to_string(i));
+        collector->AcceptData(i);
+        const auto handle = registry.Register(collector);
+        if (i % 2) {
+          registry.Unregister(handle);
+        }
+      }
+      done = true;
+    });
+
+  int32_t sec = 0;
+  while (!done) {
+    registry.GenerateStatisticMessages(MakeTime(++sec));
+  }
+  registrar.join();
+  registry.GenerateStatisticMessages(MakeTime(++sec));
+  EXPECT_EQ(static_cast<size_t>(kCollectors / 2), registry.GetCollectorCount());
+}
@@ -0,0 +1,153 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+namespace
+{
+using libstatistics_collector::collector::GenerateStatisticMessage;
+using libstatistics_collector::collector::UpdateStatisticMessage;
+using libstatistics_collector::moving_average_statistics::QuantileData;
+using libstatistics_collector::moving_average_statistics::StatisticData;
+using statistics_msgs::msg::MetricsMessage;
+using statistics_msgs::msg::StatisticDataType;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricName[] = "test_metric_name";
+constexpr const char kMetricUnit[] = "test_metric_unit";
+
+builtin_interfaces::msg::Time MakeTime(const int32_t sec)
+{
+  builtin_interfaces::msg::Time time;
+  time.sec = sec;
+  return time;
+}
+
+StatisticData MakeStatisticData(const double value)
+{
+  StatisticData data;
+  data.average = value;
+  data.min = value - 1;
+  data.max = value + 1;
+  data.standard_deviation = 1;
+  data.sample_count = 3;
+  return data;
+}
+
+void ExpectStatistics(const StatisticData & data, const MetricsMessage & msg)
+{
+  ASSERT_LE(5u, msg.statistics.size());
+  EXPECT_EQ(StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE, msg.statistics[0].data_type);
+  EXPECT_EQ(data.average, msg.statistics[0].data);
+  EXPECT_EQ(StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM, msg.statistics[1].data_type);
+  EXPECT_EQ(data.max, msg.statistics[1].data);
+  EXPECT_EQ(StatisticDataType::STATISTICS_DATA_TYPE_MINIMUM, msg.statistics[2].data_type);
+  EXPECT_EQ(data.min, msg.statistics[2].data);
+  EXPECT_EQ(StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT, msg.statistics[3].data_type);
+  EXPECT_EQ(data.sample_count, msg.statistics[3].data);
+  EXPECT_EQ(StatisticDataType::STATISTICS_DATA_TYPE_STDDEV, msg.statistics[4].data_type);
+  EXPECT_EQ(data.standard_deviation, msg.statistics[4].data);
+}
+}  // namespace
+
+TEST(GenerateStatisticMessageTest, TestGenerate) {
+  const auto data = MakeStatisticData(2);
+  const auto msg = GenerateStatisticMessage(
+    kNodeName, kMetricName, kMetricUnit, MakeTime(1), MakeTime(2), data);
+  EXPECT_EQ(kNodeName, msg.measurement_source_name);
+  EXPECT_EQ(kMetricName, msg.metrics_source);
+  EXPECT_EQ(kMetricUnit, msg.unit);
+  EXPECT_EQ(1, msg.window_start.sec);
+  EXPECT_EQ(2, msg.window_stop.sec);
+  EXPECT_EQ(5u, msg.statistics.size());
+  ExpectStatistics(data, msg);
+}
+
+TEST(GenerateStatisticMessageTest, TestUpdateReusesMessage) {
+  auto msg = GenerateStatisticMessage(
+    kNodeName, kMetricName, kMetricUnit, MakeTime(1), MakeTime(2), MakeStatisticData(2));
+  const auto * const statistics = msg.statistics.data();
+  const auto * const unit = msg.unit.data();
+
+  const auto data = MakeStatisticData(5);
+  UpdateStatisticMessage(msg, MakeTime(2), MakeTime(3), data);
+  EXPECT_EQ(kNodeName, msg.measurement_source_name);
+  EXPECT_EQ(kMetricName, msg.metrics_source);
+  EXPECT_EQ(kMetricUnit, msg.unit);
+  EXPECT_EQ(2, msg.window_start.sec);
+  EXPECT_EQ(3, msg.window_stop.sec);
+  EXPECT_EQ(5u, msg.statistics.size());
+  ExpectStatistics(data, msg);
+  // nothing was reallocated
+  EXPECT_EQ(statistics, msg.statistics.data());
+  EXPECT_EQ(unit, msg.unit.data());
+}
+
+TEST(GenerateStatisticMessageTest, TestUpdateWithQuantiles) {
+  QuantileData quantiles;
+  quantiles.p50 = 1;
+  quantiles.p90 = 2;
+  quantiles.p99 = 3;
+  quantiles.p999 = 4;
+  auto msg = GenerateStatisticMessage(
+    kNodeName, kMetricName, kMetricUnit, MakeTime(1), MakeTime(2), MakeStatisticData(2),
+    quantiles);
+  ASSERT_EQ(9u, msg.statistics.size());
+  const auto * const statistics = msg.statistics.data();
+
+  quantiles.p999 = 8;
+  const auto data = MakeStatisticData(7);
+  UpdateStatisticMessage(msg, MakeTime(2), MakeTime(3), data, quantiles);
+  ASSERT_EQ(9u, msg.statistics.size());
+  ExpectStatistics(data, msg);
+  EXPECT_EQ(
+    libstatistics_collector::collector::kStatisticsDataTypeP50, msg.statistics[5].data_type);
+  EXPECT_EQ(1, msg.statistics[5].data);
+  EXPECT_EQ(
+    libstatistics_collector::collector::kStatisticsDataTypeP999, msg.statistics[8].data_type);
+  EXPECT_EQ(8, msg.statistics[8].data);
+  EXPECT_EQ(statistics, msg.statistics.data());
+}
+
+TEST(GenerateStatisticMessageTest, TestSampleRate) {
+  auto data = MakeStatisticData(3);
+  data.sample_rate = 0.5;
+  auto msg = GenerateStatisticMessage(
+    kNodeName, kMetricName, kMetricUnit, MakeTime(1), MakeTime(2), data);
+  ASSERT_EQ(6u, msg.statistics.size());
+  ExpectStatistics(data, msg);
+  EXPECT_EQ(
+    libstatistics_collector::collector::kStatisticsDataTypeSampleRate,
+    msg.statistics[5].data_type);
+  EXPECT_EQ(0.5, msg.statistics[5].data);
+
+  msg = GenerateStatisticMessage(
+    kNodeName, kMetricName, kMetricUnit, MakeTime(1), MakeTime(2), data, QuantileData{});
+  ASSERT_EQ(10u, msg.statistics.size());
+  EXPECT_EQ(
+    libstatistics_collector::collector::kStatisticsDataTypeSampleRate,
+    msg.statistics[9].data_type);
+
+  // no sample rate data point for unsampled data
+  UpdateStatisticMessage(msg, MakeTime(2), MakeTime(3), MakeStatisticData(4));
+  EXPECT_EQ(5u, msg.statistics.size());
+}
@@ -0,0 +1,203 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/collector/shared_memory_exporter.hpp"
+
+namespace
+{
+using libstatistics_collector::collector::SharedMemoryExporter;
+using libstatistics_collector::collector::SharedMemoryReader;
+using libstatistics_collector::moving_average_statistics::StatisticData;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricUnit[] = "test_metric_unit";
+
+/**
+ * Minimal collector with a configurable metric name
+ */
+class TestCollector : public libstatistics_collector::collector::Collector
+{
+public:
+  explicit TestCollector(std::string metric_name)
+  : metric_name_{std::move(metric_name)} {}
+
+  std::string GetMetricName() const override
+  {
+    return metric_name_;
+  }
+
+  std::string GetMetricUnit() const override
+  {
+    return kMetricUnit;
+  }
+
+private:
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+
+  const std::string metric_name_;
+};
+
+/**
+ * Region name unique to this process, so that tests running in parallel do not collide
+ */
+std::string GetRegionName(const std::string & test_name)
+{
+  return "/lsc_test_" + test_name + "_" + std::to_string(getpid());
+}
+}  // namespace
+
+TEST(SharedMemoryExporterTest, TestRegisterAndRead) {
+  SharedMemoryExporter exporter{GetRegionName("register"), kNodeName, 4};
+  auto first = std::make_shared<TestCollector>("first_metric");
+  auto second = std::make_shared<TestCollector>("second_metric");
+  EXPECT_EQ(0u, exporter.Register(first));
+  EXPECT_EQ(1u, exporter.Register(second));
+  EXPECT_EQ(2u, exporter.GetMetricCount());
+
+  SharedMemoryReader reader{exporter.GetRegionName()};
+  EXPECT_EQ(kNodeName, reader.GetNodeName());
+  ASSERT_EQ(2u, reader.GetMetricCount());
+  EXPECT_EQ("first_metric", reader.GetMetricName(0));
+  EXPECT_EQ("second_metric", reader.GetMetricName(1));
+  EXPECT_EQ(kMetricUnit, reader.GetMetricUnit(1));
+  EXPECT_TRUE(reader.GetMetricName(2).empty());
+
+  StatisticData statistics;
+  int64_t update_time = -1;
+  // nothing exported yet
+  ASSERT_TRUE(reader.Read(0, statistics, update_time));
+  EXPECT_EQ(0u, statistics.sample_count);
+  EXPECT_EQ(0, update_time);
+
+  first->AcceptData(1.0);
+  first->AcceptData(3.0);
+  second->AcceptData(10.0);
+  exporter.Update(42);
+
+  ASSERT_TRUE(reader.Read(0, statistics, update_time));
+  EXPECT_EQ(42, update_time);
+  EXPECT_EQ(2u, statistics.sample_count);
+  EXPECT_DOUBLE_EQ(2.0, statistics.average);
+  EXPECT_DOUBLE_EQ(1.0, statistics.min);
+  EXPECT_DOUBLE_EQ(3.0, statistics.max);
+  EXPECT_DOUBLE_EQ(1.0, statistics.standard_deviation);
+  EXPECT_DOUBLE_EQ(1.0, statistics.sample_rate);
+
+  ASSERT_TRUE(reader.Read(1, statistics, update_time));
+  EXPECT_EQ(1u, statistics.sample_count);
+  EXPECT_DOUBLE_EQ(10.0, statistics.average);
+
+  EXPECT_FALSE(reader.Read(2, statistics, update_time));
+}
+
+TEST(SharedMemoryExporterTest, TestUnregister) {
+  SharedMemoryExporter exporter{GetRegionName("unregister"), kNodeName, 2};
+  auto collector = std::make_shared<TestCollector>("metric");
+  const size_t index = exporter.Register(collector);
+  collector->AcceptData(5.0);
+  exporter.Update(1);
+
+  SharedMemoryReader reader{exporter.GetRegionName()};
+  EXPECT_FALSE(reader.IsRetired(index));
+
+  exporter.Unregister(index);
+  EXPECT_TRUE(reader.IsRetired(index));
+
+  // the last exported values stay readable, but are no longer updated
+  collector->AcceptData(7.0);
+  exporter.Update(2);
+  StatisticData statistics;
+  int64_t update_time = 0;
+  ASSERT_TRUE(reader.Read(index, statistics, update_time));
+  EXPECT_EQ(1, update_time);
+  EXPECT_EQ(1u, statistics.sample_count);
+  // slots are not reused
+  EXPECT_EQ(1u, exporter.Register(std::make_shared<TestCollector>("other_metric")));
+}
+
+TEST(SharedMemoryExporterTest, TestInvalidArguments) {
+  EXPECT_THROW(SharedMemoryExporter("no_slash", kNodeName, 1), std::invalid_argument);
+  EXPECT_THROW(SharedMemoryExporter("/a/b", kNodeName, 1), std::invalid_argument);
+  EXPECT_THROW(SharedMemoryExporter(GetRegionName("zero"), kNodeName, 0), std::invalid_argument);
+  EXPECT_THROW(
+    SharedMemoryExporter(GetRegionName("node"), std::string(200, 'n'), 1),
+    std::invalid_argument);
+  EXPECT_THROW(SharedMemoryReader(GetRegionName("missing")), std::runtime_error);
+
+  SharedMemoryExporter exporter{GetRegionName("full"), kNodeName, 1};
+  EXPECT_THROW(exporter.Register(nullptr), std::invalid_argument);
+  exporter.Register(std::make_shared<TestCollector>("metric"));
+  EXPECT_THROW(
+    exporter.Register(std::make_shared<TestCollector>("metric")), std::length_error);
+}
+
+TEST(SharedMemoryExporterTest, TestLongNamesAreTruncated) {
+  SharedMemoryExporter exporter{GetRegionName("truncate"), kNodeName, 1};
+  exporter.Register(std::make_shared<TestCollector>(std::string(500, 'm')));
+
+  SharedMemoryReader reader{exporter.GetRegionName()};
+  EXPECT_EQ(
+    libstatistics_collector::collector::shared_memory_layout::kMetricNameSize - 1,
+    reader.GetMetricName(0).size());
+}
+
+TEST(SharedMemoryExporterTest, TestConcurrentReadNeverTears) {
+  SharedMemoryExporter exporter{GetRegionName("concurrent"), kNodeName, 1};
+  auto collector = std::make_shared<TestCollector>("metric");
+  exporter.Register(collector);
+  SharedMemoryReader reader{exporter.GetRegionName()};
+
+  std::atomic<bool> done{false};
+  std::thread writer{[&]() {
+      for (int i = 1; i <= 2000; i++) {
+        collector->ClearCurrentMeasurements();
+        collector->AcceptData(static_cast<double>(i));
+        exporter.Update(i);
+      }
+      done = true;
+    }};
+
+  StatisticData statistics;
+  int64_t update_time = 0;
+  while (!done) {
+    if (reader.Read(0, statistics, update_time) && update_time > 0) {
+      // every field of a snapshot comes from the same update
+      ASSERT_EQ(static_cast<double>(update_time), statistics.average);
+      ASSERT_EQ(statistics.min, statistics.max);
+      ASSERT_EQ(1u, statistics.sample_count);
+    }
+  }
+  writer.join();
+}
@@ -0,0 +1,228 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/collector/statistics_stream.hpp"
+
+namespace
+{
+using libstatistics_collector::collector::StatisticsStreamReader;
+using libstatistics_collector::collector::StatisticsStreamRecord;
+using libstatistics_collector::collector::StatisticsStreamWriter;
+using libstatistics_collector::moving_average_statistics::StatisticData;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricUnit[] = "test_metric_unit";
+constexpr const int64_t kWindow = 1000000000;
+
+StatisticData MakeStatistics(const double value, const uint64_t sample_count)
+{
+  StatisticData statistics;
+  statistics.average = value;
+  statistics.min = value - 1.5;
+  statistics.max = value + 2.25;
+  statistics.standard_deviation = value / 3;
+  statistics.sample_count = sample_count;
+  return statistics;
+}
+
+std::vector<uint8_t> ToBytes(const std::stringstream & stream)
+{
+  const std::string bytes = stream.str();
+  return std::vector<uint8_t>{bytes.begin(), bytes.end()};
+}
+
+void ExpectEqual(const StatisticData & expected, const StatisticData & actual)
+{
+  EXPECT_EQ(expected.average, actual.average);
+  EXPECT_EQ(expected.min, actual.min);
+  EXPECT_EQ(expected.max, actual.max);
+  EXPECT_EQ(expected.standard_deviation, actual.standard_deviation);
+  EXPECT_EQ(expected.sample_count, actual.sample_count);
+  EXPECT_EQ(expected.sample_rate, actual.sample_rate);
+}
+}  // namespace
+
+TEST(StatisticsStreamTest, TestRoundTrip) {
+  std::stringstream stream;
+  std::vector<StatisticsStreamRecord> expected;
+  {
+    StatisticsStreamWriter writer{stream, 7};
+    const uint32_t first = writer.InternMetric(kNodeName, "first_metric", kMetricUnit);
+    const uint32_t second = writer.InternMetric(kNodeName, "second_metric", kMetricUnit);
+    EXPECT_EQ(first, writer.InternMetric(kNodeName, "first_metric", kMetricUnit));
+    EXPECT_EQ(2u, writer.GetMetricCount());
+
+    for (int i = 0; i < 50; i++) {
+      // interleaved metrics, slowly changing values and an occasional backwards window
+      const uint32_t id = i % 2 ? second : first;
+      const int64_t stop = (i == 20 ? i - 5 : i) * kWindow + 17;
+      StatisticData statistics = MakeStatistics(100.0 + (i / 10), static_cast<uint64_t>(i));
+      if (i == 30) {
+        statistics = StatisticData{};
+      }
+      if (i % 3 == 0) {
+        statistics.sample_rate = 0.25;
+      }
+      writer.Write(id, stop - kWindow, stop, statistics);
+      expected.push_back(StatisticsStreamRecord{id, stop - kWindow, stop, statistics});
+    }
+  }
+
+  const auto bytes = ToBytes(stream);
+  StatisticsStreamReader reader{bytes.data(), bytes.size()};
+  ASSERT_EQ(2u, reader.GetMetrics().size());
+  EXPECT_EQ(kNodeName, reader.GetMetrics()[1].node_name);
+  EXPECT_EQ("second_metric", reader.GetMetrics()[1].metric_name);
+  EXPECT_EQ(kMetricUnit, reader.GetMetrics()[1].metric_unit);
+  EXPECT_EQ(8u, reader.GetBlockCount());
+  EXPECT_EQ(50u, reader.GetRecordCount());
+
+  const auto records = reader.ReadAll();
+  ASSERT_EQ(expected.size(), records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    EXPECT_EQ(expected[i].metric_id, records[i].metric_id);
+    EXPECT_EQ(expected[i].window_start, records[i].window_start);
+    EXPECT_EQ(expected[i].window_stop, records[i].window_stop);
+    if (i == 30) {
+      EXPECT_TRUE(std::isnan(records[i].statistics.average));
+      EXPECT_EQ(0u, records[i].statistics.sample_count);
+    } else {
+      ExpectEqual(expected[i].statistics, records[i].statistics);
+    }
+  }
+}
+
+TEST(StatisticsStreamTest, TestReadRange) {
+  std::stringstream stream;
+  {
+    StatisticsStreamWriter writer{stream, 10};
+    const uint32_t id = writer.InternMetric(kNodeName, "metric", kMetricUnit);
+    for (int i = 0; i < 100; i++) {
+      writer.Write(id, i * kWindow, (i + 1) * kWindow, MakeStatistics(i, 1));
+    }
+  }
+
+  const auto bytes = ToBytes(stream);
+  StatisticsStreamReader reader{bytes.data(), bytes.size()};
+  const auto records = reader.ReadRange(25 * kWindow, 34 * kWindow);
+  ASSERT_EQ(10u, records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    EXPECT_EQ(static_cast<int64_t>(25 + i) * kWindow, records[i].window_stop);
+    EXPECT_EQ(24.0 + static_cast<double>(i), records[i].statistics.average);
+  }
+  EXPECT_TRUE(reader.ReadRange(200 * kWindow, 300 * kWindow).empty());
+}
+
+TEST(StatisticsStreamTest, TestCompression) {
+  std::stringstream stream;
+  constexpr int kRecordCount = 1000;
+  {
+    StatisticsStreamWriter writer{stream};
+    const uint32_t id = writer.InternMetric(kNodeName, "metric", kMetricUnit);
+    for (int i = 0; i < kRecordCount; i++) {
+      writer.Write(id, i * kWindow, (i + 1) * kWindow, MakeStatistics(10.0, 100));
+    }
+  }
+  // a steady metric costs a few bytes per window, instead of the 48 bytes of its numbers alone
+  EXPECT_LT(stream.str().size(), static_cast<size_t>(kRecordCount) * 5);
+}
+
+TEST(StatisticsStreamTest, TestWriteMessage) {
+  std::stringstream stream;
+  {
+    StatisticsStreamWriter writer{stream};
+    builtin_interfaces::msg::Time window_start;
+    window_start.sec = 10;
+    builtin_interfaces::msg::Time window_stop;
+    window_stop.sec = 11;
+    window_stop.nanosec = 500;
+    StatisticData statistics = MakeStatistics(3.0, 4);
+    statistics.sample_rate = 0.5;
+    writer.Write(
+      libstatistics_collector::collector::GenerateStatisticMessage(
+        kNodeName, "metric", kMetricUnit, window_start, window_stop, statistics));
+    writer.Write(
+      libstatistics_collector::collector::GenerateStatisticMessage(
+        kNodeName, "metric", kMetricUnit, window_stop, window_stop, statistics));
+    EXPECT_EQ(1u, writer.GetMetricCount());
+  }
+
+  const auto bytes = ToBytes(stream);
+  StatisticsStreamReader reader{bytes.data(), bytes.size()};
+  ASSERT_EQ(1u, reader.GetMetrics().size());
+  EXPECT_EQ("metric", reader.GetMetrics()[0].metric_name);
+  const auto records = reader.ReadAll();
+  ASSERT_EQ(2u, records.size());
+  EXPECT_EQ(10000000000, records[0].window_start);
+  EXPECT_EQ(11000000500, records[0].window_stop);
+  EXPECT_EQ(3.0, records[0].statistics.average);
+  EXPECT_EQ(4u, records[0].statistics.sample_count);
+  EXPECT_EQ(0.5, records[0].statistics.sample_rate);
+}
+
+TEST(StatisticsStreamTest, TestMappedFile) {
+  const std::string path = "/tmp/test_statistics_stream_" + std::to_string(getpid()) + ".bin";
+  {
+    std::ofstream file{path, std::ios::binary};
+    StatisticsStreamWriter writer{file, 4};
+    const uint32_t id = writer.InternMetric(kNodeName, "metric", kMetricUnit);
+    for (int i = 0; i < 10; i++) {
+      writer.Write(id, i, i + 1, MakeStatistics(i, 1));
+    }
+  }
+  {
+    StatisticsStreamReader reader{path};
+    EXPECT_EQ(3u, reader.GetBlockCount());
+    EXPECT_EQ(10u, reader.ReadAll().size());
+  }
+  std::remove(path.c_str());
+  EXPECT_THROW(StatisticsStreamReader{path}, std::runtime_error);
+}
+
+TEST(StatisticsStreamTest, TestInvalidStreams) {
+  std::stringstream stream;
+  EXPECT_THROW(StatisticsStreamWriter(stream, 0), std::invalid_argument);
+  {
+    StatisticsStreamWriter writer{stream, 4};
+    EXPECT_THROW(writer.Write(0, 0, 1, StatisticData{}), std::out_of_range);
+    const uint32_t id = writer.InternMetric(kNodeName, "metric", kMetricUnit);
+    for (int i = 0; i < 6; i++) {
+      writer.Write(id, i, i + 1, MakeStatistics(i, 1));
+    }
+  }
+  auto bytes = ToBytes(stream);
+
+  // a truncated last block is ignored
+  StatisticsStreamReader truncated{bytes.data(), bytes.size() - 1};
+  EXPECT_EQ(1u, truncated.GetBlockCount());
+  EXPECT_EQ(4u, truncated.ReadAll().size());
+
+  bytes[0] = 'X';
+  EXPECT_THROW(StatisticsStreamReader(bytes.data(), bytes.size()), std::runtime_error);
+  EXPECT_THROW(StatisticsStreamReader(bytes.data(), 3), std::runtime_error);
+}
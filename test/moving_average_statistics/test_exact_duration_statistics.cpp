@@ -0,0 +1,126 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
+
+namespace
+{
+using libstatistics_collector::moving_average_statistics::ExactDurationStatistics;
+using libstatistics_collector::moving_average_statistics::MovingAverageStatistics;
+
+constexpr const int64_t kNanosecondsPerMillisecond{1000000};
+}  // namespace
+
+TEST(ExactDurationStatisticsTest, TestDefaults) {
+  ExactDurationStatistics statistics;
+  EXPECT_EQ(0u, statistics.GetCount());
+
+  const auto stats = statistics.GetStatistics();
+  EXPECT_TRUE(std::isnan(stats.average));
+  EXPECT_TRUE(std::isnan(stats.min));
+  EXPECT_TRUE(std::isnan(stats.max));
+  EXPECT_TRUE(std::isnan(stats.standard_deviation));
+  EXPECT_EQ(0u, stats.sample_count);
+}
+
+TEST(ExactDurationStatisticsTest, TestDurations) {
+  ExactDurationStatistics statistics;
+  for (int64_t i = 1; i <= 3; i++) {
+    statistics.AddDuration(i * kNanosecondsPerMillisecond);
+  }
+  const auto stats = statistics.GetStatistics();
+  EXPECT_EQ(3u, stats.sample_count);
+  EXPECT_EQ(2.0, stats.average);
+  EXPECT_EQ(1.0, stats.min);
+  EXPECT_EQ(3.0, stats.max);
+  EXPECT_DOUBLE_EQ(std::sqrt(2.0 / 3.0), stats.standard_deviation);
+}
+
+TEST(ExactDurationStatisticsTest, TestMeasurementsInMilliseconds) {
+  ExactDurationStatistics statistics;
+  MovingAverageStatistics moving_average;
+  const double measurements[] = {0.5, 1.25, std::nan(""), -2.0, 7.000001};
+  statistics.AddMeasurement(measurements[0]);
+  statistics.AddMeasurements(measurements + 1, 4);
+  moving_average.AddMeasurements(measurements, 5);
+
+  const auto stats = statistics.GetStatistics();
+  const auto expected = moving_average.GetStatistics();
+  EXPECT_EQ(4u, stats.sample_count);
+  EXPECT_DOUBLE_EQ(expected.average, stats.average);
+  EXPECT_EQ(expected.min, stats.min);
+  EXPECT_EQ(expected.max, stats.max);
+  EXPECT_DOUBLE_EQ(expected.standard_deviation, stats.standard_deviation);
+}
+
+TEST(ExactDurationStatisticsTest, TestExactOverManySamples) {
+  // a large offset and an alternating deviation of 1 ns, which a double running mean of the
+  // milliseconds cannot resolve
+  constexpr int64_t kOffset = 12345678901234;
+  constexpr int kSampleCount = 1000000;
+  ExactDurationStatistics statistics;
+  for (int i = 0; i < kSampleCount; i++) {
+    statistics.AddDuration(kOffset + (i % 2 == 0 ? 1 : -1));
+  }
+  const auto stats = statistics.GetStatistics();
+  EXPECT_EQ(static_cast<uint64_t>(kSampleCount), stats.sample_count);
+  EXPECT_EQ(static_cast<double>(kOffset) / kNanosecondsPerMillisecond, stats.average);
+  EXPECT_EQ(static_cast<double>(kOffset - 1) / kNanosecondsPerMillisecond, stats.min);
+  EXPECT_EQ(static_cast<double>(kOffset + 1) / kNanosecondsPerMillisecond, stats.max);
+  EXPECT_DOUBLE_EQ(1.0 / kNanosecondsPerMillisecond, stats.standard_deviation);
+}
+
+TEST(ExactDurationStatisticsTest, TestLargeDeviations) {
+  // the squares of the deviations exceed 64 bits
+  constexpr int64_t kDeviation = std::numeric_limits<int64_t>::max() / 4;
+  ExactDurationStatistics statistics;
+  statistics.AddDuration(0);
+  statistics.AddDuration(kDeviation);
+  statistics.AddDuration(-kDeviation);
+  statistics.AddDuration(0);
+
+  const auto stats = statistics.GetStatistics();
+  const double deviation_milliseconds =
+    static_cast<double>(kDeviation) / kNanosecondsPerMillisecond;
+  EXPECT_EQ(0.0, stats.average);
+  EXPECT_EQ(-deviation_milliseconds, stats.min);
+  EXPECT_EQ(deviation_milliseconds, stats.max);
+  EXPECT_DOUBLE_EQ(deviation_milliseconds / std::sqrt(2.0), stats.standard_deviation);
+}
+
+TEST(ExactDurationStatisticsTest, TestReset) {
+  ExactDurationStatistics statistics;
+  statistics.AddDuration(5 * kNanosecondsPerMillisecond);
+  statistics.AddDuration(7 * kNanosecondsPerMillisecond);
+
+  const auto stats = statistics.GetStatisticsAndReset();
+  EXPECT_EQ(2u, stats.sample_count);
+  EXPECT_EQ(6.0, stats.average);
+  EXPECT_EQ(0u, statistics.GetCount());
+
+  // the offset of the sums is taken from the first duration after the reset
+  statistics.AddDuration(-kNanosecondsPerMillisecond);
+  EXPECT_EQ(-1.0, statistics.GetStatistics().average);
+  EXPECT_EQ(0.0, statistics.GetStatistics().standard_deviation);
+
+  statistics.Reset();
+  EXPECT_EQ(0u, statistics.GetStatistics().sample_count);
+}
@@ -0,0 +1,134 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "libstatistics_collector/moving_average_statistics/exponential_moving_average.hpp"
+
+namespace
+{
+using libstatistics_collector::moving_average_statistics::ExponentialMovingAverageStatistics;
+
+constexpr const double kAlpha = 0.5;
+}  // namespace
+
+TEST(ExponentialMovingAverageStatisticsTest, TestDefaults) {
+  ExponentialMovingAverageStatistics ewma;
+  EXPECT_EQ(ExponentialMovingAverageStatistics::kDefaultAlpha, ewma.GetAlpha());
+  EXPECT_EQ(0u, ewma.GetCount());
+
+  const auto stats = ewma.GetStatistics();
+  EXPECT_TRUE(std::isnan(stats.average));
+  EXPECT_TRUE(std::isnan(stats.min));
+  EXPECT_TRUE(std::isnan(stats.max));
+  EXPECT_TRUE(std::isnan(stats.standard_deviation));
+  EXPECT_EQ(0u, stats.sample_count);
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestInvalidArguments) {
+  EXPECT_THROW(ExponentialMovingAverageStatistics{0}, std::invalid_argument);
+  EXPECT_THROW(ExponentialMovingAverageStatistics{1.5}, std::invalid_argument);
+  EXPECT_THROW(
+    ExponentialMovingAverageStatistics{std::numeric_limits<double>::quiet_NaN()},
+    std::invalid_argument);
+  EXPECT_THROW(ExponentialMovingAverageStatistics::HalfLifeToAlpha(0), std::invalid_argument);
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestHalfLifeToAlpha) {
+  EXPECT_DOUBLE_EQ(0.5, ExponentialMovingAverageStatistics::HalfLifeToAlpha(1));
+  const double alpha = ExponentialMovingAverageStatistics::HalfLifeToAlpha(10);
+  EXPECT_NEAR(0.5, std::pow(1 - alpha, 10), 1e-12);
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestWeightedAverage) {
+  ExponentialMovingAverageStatistics ewma{kAlpha};
+  ewma.AddMeasurement(4);
+  ewma.AddMeasurement(std::numeric_limits<double>::quiet_NaN());
+  ewma.AddMeasurement(8);
+  ewma.AddMeasurement(0);
+
+  const auto stats = ewma.GetStatistics();
+  EXPECT_EQ(3u, stats.sample_count);
+  // 4 -> 6 -> 3
+  EXPECT_DOUBLE_EQ(3, stats.average);
+  // 0 -> 0.5 * (0 + 4 * 2) = 4 -> 0.5 * (4 + 6 * 3) = 11
+  EXPECT_DOUBLE_EQ(std::sqrt(11.0), stats.standard_deviation);
+  // the maximum decays from 8 towards 0: 4 -> 8 -> 4
+  EXPECT_DOUBLE_EQ(0, stats.min);
+  EXPECT_DOUBLE_EQ(4, stats.max);
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestConvergesToStep) {
+  ExponentialMovingAverageStatistics ewma{kAlpha};
+  ewma.AddMeasurement(100);
+  for (int i = 0; i < 64; i++) {
+    ewma.AddMeasurement(1);
+  }
+  const auto stats = ewma.GetStatistics();
+  EXPECT_NEAR(1, stats.average, 1e-12);
+  EXPECT_NEAR(0, stats.standard_deviation, 1e-6);
+  // the old maximum fades out like the average
+  EXPECT_NEAR(1, stats.max, 1e-12);
+  EXPECT_EQ(1, stats.min);
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestEnvelopeContainsAverage) {
+  ExponentialMovingAverageStatistics ewma{kAlpha};
+  const double items[] = {5, -3, 12, 7, 7, 0, 20, 1, 1, 1};
+  for (const double item : items) {
+    ewma.AddMeasurement(item);
+    const auto stats = ewma.GetStatistics();
+    EXPECT_LE(stats.min, stats.average);
+    EXPECT_GE(stats.max, stats.average);
+    EXPECT_LE(stats.min, item);
+    EXPECT_GE(stats.max, item);
+  }
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestAddMeasurementsAndReset) {
+  ExponentialMovingAverageStatistics block{kAlpha};
+  ExponentialMovingAverageStatistics single{kAlpha};
+  const double items[] = {4, 8, std::numeric_limits<double>::quiet_NaN(), 0, 2};
+  block.AddMeasurements(items, 5);
+  for (const double item : items) {
+    single.AddMeasurement(item);
+  }
+  EXPECT_EQ(single.GetStatistics().average, block.GetStatistics().average);
+  EXPECT_EQ(
+    single.GetStatistics().standard_deviation, block.GetStatistics().standard_deviation);
+  EXPECT_EQ(4u, block.GetCount());
+
+  block.Reset();
+  EXPECT_EQ(0u, block.GetCount());
+  EXPECT_TRUE(std::isnan(block.GetStatistics().average));
+  block.AddMeasurement(5);
+  EXPECT_EQ(5, block.GetStatistics().average);
+  EXPECT_EQ(0, block.GetStatistics().standard_deviation);
+}
+
+TEST(ExponentialMovingAverageStatisticsTest, TestGetStatisticsAndReset) {
+  ExponentialMovingAverageStatistics ewma{kAlpha};
+  ewma.AddMeasurement(4);
+  ewma.AddMeasurement(8);
+
+  const auto stats = ewma.GetStatisticsAndReset();
+  EXPECT_EQ(2u, stats.sample_count);
+  EXPECT_DOUBLE_EQ(6, stats.average);
+  EXPECT_EQ(0u, ewma.GetCount());
+  EXPECT_TRUE(std::isnan(ewma.GetStatistics().average));
+}
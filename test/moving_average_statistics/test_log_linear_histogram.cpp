@@ -0,0 +1,208 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
+
+namespace
+{
+using libstatistics_collector::moving_average_statistics::LogLinearHistogram;
+
+constexpr const int kSampleCount = 100000;
+/// relative precision of the default options, 2^-(7 - 1)
+constexpr const double kRelativePrecision = 1.0 / 64;
+}  // namespace
+
+TEST(LogLinearHistogramTest, TestEmpty) {
+  const LogLinearHistogram histogram;
+  EXPECT_EQ(0u, histogram.GetCount());
+  EXPECT_TRUE(histogram.GetBuckets().empty());
+  const auto stats = histogram.GetStatistics();
+  EXPECT_EQ(0u, stats.sample_count);
+  EXPECT_TRUE(std::isnan(stats.average));
+  EXPECT_TRUE(std::isnan(stats.min));
+}
+
+TEST(LogLinearHistogramTest, TestInvalidOptions) {
+  LogLinearHistogram::Options options;
+  options.resolution = 0;
+  EXPECT_THROW(LogLinearHistogram{options}, std::invalid_argument);
+  options = LogLinearHistogram::Options{};
+  options.significant_bits = 0;
+  EXPECT_THROW(LogLinearHistogram{options}, std::invalid_argument);
+  options.significant_bits = 17;
+  EXPECT_THROW(LogLinearHistogram{options}, std::invalid_argument);
+  options = LogLinearHistogram::Options{};
+  options.max_value = options.resolution / 2;
+  EXPECT_THROW(LogLinearHistogram{options}, std::invalid_argument);
+  options.max_value = 1e300;
+  EXPECT_THROW(LogLinearHistogram{options}, std::invalid_argument);
+}
+
+TEST(LogLinearHistogramTest, TestLinearBucketsAreExact) {
+  LogLinearHistogram::Options options;
+  options.resolution = 1;
+  LogLinearHistogram histogram{options};
+  // values below 2^significant_bits resolutions have their own bucket
+  for (const double item : {1.0, 2.0, 3.0, 4.0, 5.0, std::nan("")}) {
+    histogram.AddMeasurement(item);
+  }
+  const auto stats = histogram.GetStatistics();
+  EXPECT_EQ(5u, stats.sample_count);
+  EXPECT_DOUBLE_EQ(3.0, stats.average);
+  EXPECT_DOUBLE_EQ(1.0, stats.min);
+  EXPECT_DOUBLE_EQ(5.0, stats.max);
+  EXPECT_DOUBLE_EQ(std::sqrt(2.0), stats.standard_deviation);
+
+  const auto buckets = histogram.GetBuckets();
+  ASSERT_EQ(5u, buckets.size());
+  EXPECT_EQ(1.0, buckets[0].lower_bound);
+  EXPECT_EQ(2.0, buckets[0].upper_bound);
+  EXPECT_EQ(1u, buckets[0].count);
+}
+
+TEST(LogLinearHistogramTest, TestStatisticsWithinRelativePrecision) {
+  LogLinearHistogram histogram;
+  double sum = 0;
+  for (int i = 1; i <= kSampleCount; i++) {
+    // 0.01 to 1000
+    const double item = 0.01 * static_cast<double>(i);
+    histogram.AddMeasurement(item);
+    sum += item;
+  }
+  const auto stats = histogram.GetStatistics();
+  EXPECT_EQ(static_cast<uint64_t>(kSampleCount), stats.sample_count);
+  EXPECT_NEAR(sum / kSampleCount, stats.average, stats.average * kRelativePrecision);
+  EXPECT_NEAR(0.01, stats.min, 0.01 * kRelativePrecision);
+  EXPECT_NEAR(1000.0, stats.max, 1000.0 * kRelativePrecision);
+
+  // consecutive buckets cover the range without gaps, no wider than the relative precision
+  const auto buckets = histogram.GetBuckets();
+  uint64_t count = 0;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    EXPECT_LT(buckets[i].lower_bound, buckets[i].upper_bound);
+    EXPECT_LE(
+      buckets[i].upper_bound - buckets[i].lower_bound,
+      std::max(buckets[i].lower_bound * kRelativePrecision, 1e-3) * (1 + 1e-9));
+    if (i > 0) {
+      EXPECT_LE(buckets[i - 1].upper_bound, buckets[i].lower_bound * (1 + 1e-12));
+    }
+    count += buckets[i].count;
+  }
+  EXPECT_EQ(static_cast<uint64_t>(kSampleCount), count);
+}
+
+TEST(LogLinearHistogramTest, TestOutOfRangeValuesAreClamped) {
+  LogLinearHistogram::Options options;
+  options.resolution = 1;
+  options.max_value = 1000;
+  LogLinearHistogram histogram{options};
+  histogram.AddMeasurement(-5);
+  histogram.AddMeasurement(1e9);
+  const auto buckets = histogram.GetBuckets();
+  ASSERT_EQ(2u, buckets.size());
+  EXPECT_EQ(0.0, buckets[0].lower_bound);
+  EXPECT_GE(1000.0, buckets[1].lower_bound);
+  EXPECT_LT(1000.0, buckets[1].upper_bound);
+  EXPECT_EQ(1u, buckets[0].count);
+  EXPECT_EQ(1u, buckets[1].count);
+}
+
+TEST(LogLinearHistogramTest, TestMergeAndWindows) {
+  LogLinearHistogram histogram;
+  LogLinearHistogram other;
+  histogram.AddMeasurement(1.0);
+  other.AddMeasurement(3.0);
+  EXPECT_TRUE(histogram.Merge(other));
+  EXPECT_EQ(2u, histogram.GetCount());
+  EXPECT_EQ(1u, other.GetCount());
+
+  LogLinearHistogram window;
+  window.AddMeasurement(100.0);
+  EXPECT_TRUE(histogram.GetAndReset(window));
+  EXPECT_EQ(0u, histogram.GetCount());
+  EXPECT_EQ(2u, window.GetCount());
+  EXPECT_NEAR(2.0, window.GetStatistics().average, 2.0 * kRelativePrecision);
+
+  const auto stats = window.GetStatisticsAndReset();
+  EXPECT_EQ(2u, stats.sample_count);
+  EXPECT_EQ(0u, window.GetCount());
+
+  LogLinearHistogram::Options options;
+  options.significant_bits = 8;
+  LogLinearHistogram different{options};
+  EXPECT_FALSE(histogram.Merge(different));
+  EXPECT_FALSE(histogram.GetAndReset(different));
+}
+
+TEST(LogLinearHistogramTest, TestConcurrentGetStatisticsAndReset) {
+  LogLinearHistogram histogram;
+  std::array<std::thread, 2> writers;
+  for (auto & writer : writers) {
+    writer = std::thread{[&histogram]() {
+          for (int i = 0; i < kSampleCount; i++) {
+            histogram.AddMeasurement(static_cast<double>(i % 100));
+          }
+        }};
+  }
+
+  uint64_t count = 0;
+  while (count < 2 * kSampleCount) {
+    count += histogram.GetStatisticsAndReset().sample_count;
+  }
+  for (auto & writer : writers) {
+    writer.join();
+  }
+  EXPECT_EQ(static_cast<uint64_t>(2 * kSampleCount), count) << "Expect no observation lost";
+}
+
+TEST(LogLinearHistogramTest, TestAppendHistogramDataPoints) {
+  namespace collector = libstatistics_collector::collector;
+
+  LogLinearHistogram::Options options;
+  options.resolution = 1;
+  LogLinearHistogram histogram{options};
+  histogram.AddMeasurement(2);
+  histogram.AddMeasurement(2);
+  histogram.AddMeasurement(500);
+
+  auto msg = collector::GenerateStatisticMessage(
+    "node", "metric", "unit", builtin_interfaces::msg::Time{}, builtin_interfaces::msg::Time{},
+    histogram.GetStatistics());
+  const size_t statistics_size = msg.statistics.size();
+  collector::AppendHistogramDataPoints(msg, histogram.GetBuckets());
+  ASSERT_EQ(statistics_size + 6, msg.statistics.size());
+
+  const auto * const bucket = &msg.statistics[statistics_size];
+  EXPECT_EQ(collector::kStatisticsDataTypeHistogramLowerBound, bucket[0].data_type);
+  EXPECT_EQ(2.0, bucket[0].data);
+  EXPECT_EQ(collector::kStatisticsDataTypeHistogramUpperBound, bucket[1].data_type);
+  EXPECT_EQ(3.0, bucket[1].data);
+  EXPECT_EQ(collector::kStatisticsDataTypeHistogramCount, bucket[2].data_type);
+  EXPECT_EQ(2.0, bucket[2].data);
+  EXPECT_LE(bucket[3].data, 500.0);
+  EXPECT_GT(bucket[4].data, 500.0);
+  EXPECT_EQ(1.0, bucket[5].data);
+}
@@ -16,14 +16,23 @@
 
 #include <array>
 #include <atomic>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "libstatistics_collector/moving_average_statistics/moving_average.hpp"
 
 namespace
 {
+using libstatistics_collector::moving_average_statistics::AccumulatorState;
+using libstatistics_collector::moving_average_statistics::BasicMovingAverageStatistics;
+using libstatistics_collector::moving_average_statistics::StatisticSet;
+using libstatistics_collector::moving_average_statistics::StatisticData;
+namespace statistic_set = libstatistics_collector::moving_average_statistics;
 using libstatistics_collector::moving_average_statistics::MovingAverageStatistics;
+using libstatistics_collector::moving_average_statistics::WriterMode;
 
 // Useful testing constants
 constexpr const uint64_t kExpectedSize = 9;
@@ -192,6 +201,287 @@ TEST_F(MovingAverageStatisticsTestFixture, TestThreadSafe) {
   ASSERT_NEAR(moving_average_statistics_->Average(), control, var);
 }
 
+TEST(MovingAverageStatisticsTest, TestSingleWriterMatchesMultiWriter) {
+  MovingAverageStatistics multi_writer;
+  MovingAverageStatistics single_writer{WriterMode::kSingleWriter};
+  EXPECT_EQ(WriterMode::kMultiWriter, multi_writer.GetWriterMode());
+  EXPECT_EQ(WriterMode::kSingleWriter, single_writer.GetWriterMode());
+
+  for (double d : kTestData) {
+    multi_writer.AddMeasurement(d);
+    single_writer.AddMeasurement(d);
+  }
+  single_writer.AddMeasurement(std::nan(""));
+
+  const auto expected = multi_writer.GetStatistics();
+  const auto result = single_writer.GetStatistics();
+  EXPECT_EQ(expected.average, result.average);
+  EXPECT_EQ(expected.min, result.min);
+  EXPECT_EQ(expected.max, result.max);
+  EXPECT_EQ(expected.standard_deviation, result.standard_deviation);
+  EXPECT_EQ(expected.sample_count, result.sample_count);
+
+  single_writer.Reset();
+  EXPECT_EQ(0, single_writer.GetCount());
+  EXPECT_TRUE(std::isnan(single_writer.Average()));
+}
+
+TEST(MovingAverageStatisticsTest, TestSingleWriterConcurrentReaderSeesConsistentSnapshot) {
+  MovingAverageStatistics stats{WriterMode::kSingleWriter};
+  constexpr int kSamples = 100000;
+  std::atomic<bool> done{false};
+
+  std::thread writer([&stats, &done]() {
+      for (int i = 1; i <= kSamples; i++) {
+        stats.AddMeasurement(static_cast<double>(i));
+      }
+      done = true;
+    });
+
+  // Samples are 1, 2, ..., n, so every consistent snapshot satisfies these invariants.
+  bool consistent = true;
+  while (!done && consistent) {
+    const auto result = stats.GetStatistics();
+    if (result.sample_count == 0) {
+      continue;
+    }
+    const double n = static_cast<double>(result.sample_count);
+    consistent = result.min == 1.0 && result.max == n &&
+      std::abs(result.average - (n + 1.0) / 2.0) < 1e-6 * n;
+  }
+  writer.join();
+
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(static_cast<uint64_t>(kSamples), stats.GetCount());
+}
+
+TEST(MovingAverageStatisticsTest, TestMaximumAllNegative) {
+  MovingAverageStatistics stats;
+  stats.AddMeasurement(-2.0);
+  stats.AddMeasurement(-1.0);
+  EXPECT_EQ(-1.0, stats.Max());
+  EXPECT_EQ(-2.0, stats.Min());
+}
+
+TEST(MovingAverageStatisticsTest, TestMerge) {
+  MovingAverageStatistics first_half;
+  MovingAverageStatistics second_half;
+  for (size_t i = 0; i < kTestData.size(); i++) {
+    (i < kTestData.size() / 2 ? first_half : second_half).AddMeasurement(kTestData[i]);
+  }
+
+  first_half.Merge(second_half);
+  const auto result = first_half.GetStatistics();
+  EXPECT_DOUBLE_EQ(kExpectedAvg, result.average);
+  EXPECT_EQ(kExpectedMin, result.min);
+  EXPECT_EQ(kExpectedMax, result.max);
+  EXPECT_DOUBLE_EQ(kExpectedStd, result.standard_deviation);
+  EXPECT_EQ(kExpectedSize, result.sample_count);
+
+  // the merged instance is left unchanged
+  EXPECT_EQ(kExpectedSize - kExpectedSize / 2, second_half.GetCount());
+}
+
+TEST(MovingAverageStatisticsTest, TestMergeEmpty) {
+  MovingAverageStatistics stats;
+  MovingAverageStatistics empty;
+  stats.Merge(empty);
+  EXPECT_EQ(0, stats.GetCount());
+  EXPECT_TRUE(std::isnan(stats.Average()));
+
+  for (double d : kTestData) {
+    empty.AddMeasurement(d);
+  }
+  stats.Merge(empty);
+  EXPECT_DOUBLE_EQ(kExpectedAvg, stats.Average());
+  EXPECT_DOUBLE_EQ(kExpectedStd, stats.StandardDeviation());
+
+  stats.Merge(AccumulatorState{});
+  EXPECT_EQ(kExpectedSize, stats.GetCount());
+}
+
+TEST(MovingAverageStatisticsTest, TestMergeStatisticData) {
+  MovingAverageStatistics first_half;
+  MovingAverageStatistics second_half;
+  for (size_t i = 0; i < kTestData.size(); i++) {
+    (i < kTestData.size() / 2 ? first_half : second_half).AddMeasurement(kTestData[i]);
+  }
+
+  // states recovered from the statistics merge like the states themselves
+  auto state = AccumulatorState::FromStatisticData(first_half.GetStatistics());
+  state.Merge(AccumulatorState::FromStatisticData(second_half.GetStatistics()));
+  const auto result = state.ToStatisticData();
+  EXPECT_DOUBLE_EQ(kExpectedAvg, result.average);
+  EXPECT_EQ(kExpectedMin, result.min);
+  EXPECT_EQ(kExpectedMax, result.max);
+  EXPECT_DOUBLE_EQ(kExpectedStd, result.standard_deviation);
+  EXPECT_EQ(kExpectedSize, result.sample_count);
+
+  EXPECT_EQ(0u, AccumulatorState::FromStatisticData(StatisticData{}).count);
+}
+
+TEST(MovingAverageStatisticsTest, TestSharded) {
+  MovingAverageStatistics stats{WriterMode::kSharded, 4};
+  EXPECT_EQ(WriterMode::kSharded, stats.GetWriterMode());
+  EXPECT_EQ(4u, stats.GetShardCount());
+  EXPECT_EQ(1u, MovingAverageStatistics{}.GetShardCount());
+  EXPECT_LE(1u, MovingAverageStatistics{WriterMode::kSharded}.GetShardCount());
+
+  constexpr int kThreads = 8;
+  constexpr int kSamplesPerThread = 1000;
+  std::array<std::thread, kThreads> threads;
+  for (auto & thread : threads) {
+    thread = std::thread([&stats]() {
+          for (int i = 1; i <= kSamplesPerThread; i++) {
+            stats.AddMeasurement(static_cast<double>(i));
+          }
+        });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  const auto result = stats.GetStatistics();
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kSamplesPerThread), result.sample_count);
+  EXPECT_EQ(result.sample_count, stats.GetCount());
+  EXPECT_DOUBLE_EQ((kSamplesPerThread + 1) / 2.0, result.average);
+  EXPECT_EQ(1.0, result.min);
+  EXPECT_EQ(static_cast<double>(kSamplesPerThread), result.max);
+  // population standard deviation of 1..N is sqrt((N^2 - 1) / 12)
+  EXPECT_NEAR(
+    std::sqrt((kSamplesPerThread * kSamplesPerThread - 1) / 12.0), result.standard_deviation,
+    1e-9);
+
+  stats.Reset();
+  EXPECT_EQ(0, stats.GetCount());
+  EXPECT_TRUE(std::isnan(stats.Average()));
+}
+
+TEST(MovingAverageStatisticsTest, TestGetStatisticsAndReset) {
+  for (const auto writer_mode :
+    {WriterMode::kMultiWriter, WriterMode::kSingleWriter, WriterMode::kSharded})
+  {
+    MovingAverageStatistics stats{writer_mode, 2};
+    for (const auto item : kTestData) {
+      stats.AddMeasurement(item);
+    }
+    const auto result = stats.GetStatisticsAndReset();
+    EXPECT_EQ(kExpectedSize, result.sample_count);
+    EXPECT_DOUBLE_EQ(kExpectedAvg, result.average);
+    EXPECT_EQ(kExpectedMin, result.min);
+    EXPECT_EQ(kExpectedMax, result.max);
+    EXPECT_DOUBLE_EQ(kExpectedStd, result.standard_deviation);
+
+    EXPECT_EQ(0u, stats.GetCount());
+    EXPECT_EQ(0u, stats.GetStatisticsAndReset().sample_count);
+    EXPECT_TRUE(std::isnan(stats.Average()));
+  }
+}
+
+TEST(MovingAverageStatisticsTest, TestGetStatisticsAndResetLosesNoMeasurement) {
+  for (const auto writer_mode :
+    {WriterMode::kMultiWriter, WriterMode::kSingleWriter, WriterMode::kSharded})
+  {
+    MovingAverageStatistics stats{writer_mode, 2};
+    constexpr uint64_t kSamples = 100000;
+    std::atomic<bool> done{false};
+    std::thread writer([&stats, &done]() {
+        for (uint64_t i = 0; i < kSamples; i++) {
+          stats.AddMeasurement(1.0);
+        }
+        done = true;
+      });
+
+    uint64_t total = 0;
+    while (!done) {
+      total += stats.GetStatisticsAndReset().sample_count;
+    }
+    writer.join();
+    total += stats.GetStatisticsAndReset().sample_count;
+    EXPECT_EQ(kSamples, total);
+  }
+}
+
+TEST(MovingAverageStatisticsTest, TestAddMeasurements) {
+  std::vector<double> data(kTestData.begin(), kTestData.end());
+  data.insert(data.begin() + 3, std::nan(""));
+  data.push_back(std::nan(""));
+
+  for (const auto writer_mode : {WriterMode::kMultiWriter, WriterMode::kSingleWriter,
+      WriterMode::kSharded})
+  {
+    MovingAverageStatistics stats{writer_mode};
+    stats.AddMeasurements(data.data(), 0);
+    EXPECT_EQ(0, stats.GetCount());
+
+    // split into two blocks so that the second one is merged into a non-empty state
+    stats.AddMeasurements(data.data(), 5);
+    stats.AddMeasurements(data.data() + 5, data.size() - 5);
+    const auto result = stats.GetStatistics();
+    EXPECT_DOUBLE_EQ(kExpectedAvg, result.average);
+    EXPECT_EQ(kExpectedMin, result.min);
+    EXPECT_EQ(kExpectedMax, result.max);
+    EXPECT_DOUBLE_EQ(kExpectedStd, result.standard_deviation);
+    EXPECT_EQ(kExpectedSize, result.sample_count);
+  }
+}
+
+TEST(MovingAverageStatisticsTest, TestAddMeasurementsOnlyNan) {
+  MovingAverageStatistics stats;
+  const std::array<double, 3> data{std::nan(""), std::nan(""), std::nan("")};
+  stats.AddMeasurements(data.data(), data.size());
+  EXPECT_EQ(0, stats.GetCount());
+  EXPECT_TRUE(std::isnan(stats.Average()));
+}
+
+TEST(MovingAverageStatisticsTest, TestSelectedStatistics) {
+  BasicMovingAverageStatistics<statistic_set::kStatisticCountOnly> count_only;
+  BasicMovingAverageStatistics<statistic_set::kStatisticMax> count_and_max;
+  BasicMovingAverageStatistics<statistic_set::kStatisticAverage> average_only{
+    WriterMode::kSingleWriter};
+  for (double d : kTestData) {
+    count_only.AddMeasurement(d);
+    count_and_max.AddMeasurement(d);
+    average_only.AddMeasurement(d);
+  }
+
+  auto result = count_only.GetStatistics();
+  EXPECT_EQ(kExpectedSize, result.sample_count);
+  EXPECT_TRUE(std::isnan(result.average));
+  EXPECT_TRUE(std::isnan(result.min));
+  EXPECT_TRUE(std::isnan(result.max));
+  EXPECT_TRUE(std::isnan(result.standard_deviation));
+
+  result = count_and_max.GetStatistics();
+  EXPECT_EQ(kExpectedSize, result.sample_count);
+  EXPECT_EQ(kExpectedMax, result.max);
+  EXPECT_TRUE(std::isnan(result.average));
+  EXPECT_TRUE(std::isnan(result.min));
+
+  result = average_only.GetStatistics();
+  EXPECT_DOUBLE_EQ(kExpectedAvg, result.average);
+  EXPECT_TRUE(std::isnan(result.standard_deviation));
+
+  // statistics that are not selected take no space
+  EXPECT_LT(sizeof(count_and_max), sizeof(MovingAverageStatistics));
+  EXPECT_LE(sizeof(count_only), sizeof(count_and_max));
+}
+
+TEST(MovingAverageStatisticsTest, TestMergeSelectedStatistics) {
+  MovingAverageStatistics all;
+  BasicMovingAverageStatistics<statistic_set::kStatisticMax> count_and_max;
+  for (double d : kTestData) {
+    all.AddMeasurement(d);
+  }
+  count_and_max.AddMeasurement(100.0);
+  count_and_max.Merge(all);
+
+  const auto result = count_and_max.GetStatistics();
+  EXPECT_EQ(kExpectedSize + 1, result.sample_count);
+  EXPECT_EQ(100.0, result.max);
+  EXPECT_TRUE(std::isnan(result.average));
+}
+
 TEST(MovingAverageStatisticsTest, TestPrettyPrinting) {
   libstatistics_collector::moving_average_statistics::StatisticData data;
   ASSERT_EQ("avg=nan, min=nan, max=nan, std_dev=nan, count=0", StatisticsDataToString(data));
@@ -203,3 +493,24 @@ TEST(MovingAverageStatisticsTest, TestPrettyPrinting) {
     libstatistics_collector::moving_average_statistics::StatisticsDataToString(
       stats.GetStatistics()));
 }
+
+TEST(MovingAverageStatisticsTest, TestPrettyPrintingIntoBuffer) {
+  using libstatistics_collector::moving_average_statistics::kStatisticsDataStringMaxLength;
+  using libstatistics_collector::moving_average_statistics::StatisticsDataToString;
+  char buffer[kStatisticsDataStringMaxLength];
+
+  libstatistics_collector::moving_average_statistics::StatisticData data;
+  EXPECT_EQ(StatisticsDataToString(data), StatisticsDataToString(data, buffer, sizeof(buffer)));
+
+  data.average = -std::numeric_limits<double>::max();
+  data.min = -std::numeric_limits<double>::max();
+  data.max = -std::numeric_limits<double>::max();
+  data.standard_deviation = -std::numeric_limits<double>::max();
+  data.sample_count = std::numeric_limits<uint64_t>::max();
+  const auto printed = StatisticsDataToString(data, buffer, sizeof(buffer));
+  EXPECT_EQ(kStatisticsDataStringMaxLength, printed.size());
+  EXPECT_EQ(StatisticsDataToString(data), printed);
+
+  EXPECT_TRUE(StatisticsDataToString(data, buffer, sizeof(buffer) - 1).empty());
+  EXPECT_TRUE(StatisticsDataToString(data, buffer, 0).empty());
+}
@@ -0,0 +1,147 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#include "libstatistics_collector/moving_average_statistics/quantile_sketch.hpp"
+
+namespace
+{
+using libstatistics_collector::moving_average_statistics::QuantileSketch;
+
+constexpr const int kSampleCount = 100000;
+constexpr const double kRelativeAccuracy = 0.01;
+
+/**
+ * Expect the estimate to be within the sketch's relative accuracy of the exact value.
+ */
+void ExpectWithinRelativeAccuracy(const double expected, const double estimate)
+{
+  EXPECT_NEAR(expected, estimate, std::abs(expected) * kRelativeAccuracy) <<
+    "expected " << expected << ", estimated " << estimate;
+}
+}  // namespace
+
+TEST(QuantileSketchTest, TestEmpty) {
+  QuantileSketch sketch;
+  EXPECT_EQ(0u, sketch.GetCount());
+  EXPECT_TRUE(std::isnan(sketch.GetQuantile(0.5)));
+  const auto quantiles = sketch.GetQuantileData();
+  EXPECT_TRUE(std::isnan(quantiles.p50));
+  EXPECT_TRUE(std::isnan(quantiles.p90));
+  EXPECT_TRUE(std::isnan(quantiles.p99));
+  EXPECT_TRUE(std::isnan(quantiles.p999));
+}
+
+TEST(QuantileSketchTest, TestInvalidOptions) {
+  QuantileSketch::Options options;
+  options.relative_accuracy = 0;
+  EXPECT_THROW(QuantileSketch{options}, std::invalid_argument);
+
+  options = QuantileSketch::Options{};
+  options.min_value = -1;
+  EXPECT_THROW(QuantileSketch{options}, std::invalid_argument);
+
+  options = QuantileSketch::Options{};
+  options.bucket_count = 0;
+  EXPECT_THROW(QuantileSketch{options}, std::invalid_argument);
+}
+
+TEST(QuantileSketchTest, TestQuantilesWithinRelativeAccuracy) {
+  QuantileSketch sketch;
+  // add in reverse to make sure the order of observations doesn't matter
+  for (int i = kSampleCount; i > 0; i--) {
+    sketch.AddMeasurement(static_cast<double>(i));
+  }
+  sketch.AddMeasurement(std::nan(""));
+  EXPECT_EQ(static_cast<uint64_t>(kSampleCount), sketch.GetCount());
+
+  const auto quantiles = sketch.GetQuantileData();
+  ExpectWithinRelativeAccuracy(0.5 * kSampleCount, quantiles.p50);
+  ExpectWithinRelativeAccuracy(0.9 * kSampleCount, quantiles.p90);
+  ExpectWithinRelativeAccuracy(0.99 * kSampleCount, quantiles.p99);
+  ExpectWithinRelativeAccuracy(0.999 * kSampleCount, quantiles.p999);
+  ExpectWithinRelativeAccuracy(1, sketch.GetQuantile(0));
+  ExpectWithinRelativeAccuracy(kSampleCount, sketch.GetQuantile(1));
+  EXPECT_TRUE(std::isnan(sketch.GetQuantile(1.5)));
+  EXPECT_TRUE(std::isnan(sketch.GetQuantile(-0.5)));
+}
+
+TEST(QuantileSketchTest, TestNegativeAndZeroValues) {
+  QuantileSketch sketch;
+  const std::array<double, 5> data{-100.0, -10.0, 0.0, 10.0, 100.0};
+  for (double d : data) {
+    sketch.AddMeasurement(d);
+  }
+  ExpectWithinRelativeAccuracy(-100, sketch.GetQuantile(0));
+  ExpectWithinRelativeAccuracy(-10, sketch.GetQuantile(0.25));
+  EXPECT_EQ(0, sketch.GetQuantile(0.5));
+  ExpectWithinRelativeAccuracy(10, sketch.GetQuantile(0.75));
+  ExpectWithinRelativeAccuracy(100, sketch.GetQuantile(1));
+}
+
+TEST(QuantileSketchTest, TestOutOfRangeValuesAreClamped) {
+  QuantileSketch::Options options;
+  options.bucket_count = 16;
+  QuantileSketch sketch{options};
+  sketch.AddMeasurement(1e12);
+  sketch.AddMeasurement(1e-12);
+  EXPECT_EQ(2u, sketch.GetCount());
+  EXPECT_EQ(0, sketch.GetQuantile(0));
+  EXPECT_LT(sketch.GetQuantile(1), 1e12);
+}
+
+TEST(QuantileSketchTest, TestMergeAndReset) {
+  QuantileSketch lower;
+  QuantileSketch upper;
+  for (int i = 1; i <= kSampleCount; i++) {
+    (i <= kSampleCount / 2 ? lower : upper).AddMeasurement(static_cast<double>(i));
+  }
+  ASSERT_TRUE(lower.Merge(upper));
+  EXPECT_EQ(static_cast<uint64_t>(kSampleCount), lower.GetCount());
+  EXPECT_EQ(static_cast<uint64_t>(kSampleCount / 2), upper.GetCount());
+  ExpectWithinRelativeAccuracy(0.5 * kSampleCount, lower.GetQuantile(0.5));
+  ExpectWithinRelativeAccuracy(0.99 * kSampleCount, lower.GetQuantile(0.99));
+
+  QuantileSketch::Options options;
+  options.relative_accuracy = 0.05;
+  QuantileSketch incompatible{options};
+  EXPECT_FALSE(lower.Merge(incompatible));
+
+  lower.Reset();
+  EXPECT_EQ(0u, lower.GetCount());
+  EXPECT_TRUE(std::isnan(lower.GetQuantile(0.5)));
+}
+
+TEST(QuantileSketchTest, TestThreadSafe) {
+  QuantileSketch sketch;
+  std::array<std::thread, 4> threads;
+  for (auto & thread : threads) {
+    thread = std::thread([&sketch]() {
+          for (int i = 1; i <= kSampleCount; i++) {
+            sketch.AddMeasurement(static_cast<double>(i));
+          }
+        });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(static_cast<uint64_t>(threads.size() * kSampleCount), sketch.GetCount());
+  ExpectWithinRelativeAccuracy(0.9 * kSampleCount, sketch.GetQuantile(0.9));
+}
@@ -0,0 +1,148 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "libstatistics_collector/moving_average_statistics/sliding_window_statistics.hpp"
+
+namespace
+{
+using libstatistics_collector::moving_average_statistics::SlidingWindowStatistics;
+using Clock = SlidingWindowStatistics::Clock;
+
+constexpr const std::chrono::milliseconds kBucketDuration{100};
+constexpr const size_t kBucketCount = 10;
+
+/**
+ * Return a fixed time point so the tests don't depend on the wall time.
+ */
+Clock::time_point Start()
+{
+  return Clock::time_point{} + std::chrono::hours{1};
+}
+}  // namespace
+
+TEST(SlidingWindowStatisticsTest, TestDefaults) {
+  SlidingWindowStatistics window;
+  EXPECT_EQ(kBucketDuration, window.GetBucketDuration());
+  EXPECT_EQ(kBucketCount, window.GetBucketCount());
+  EXPECT_EQ(0u, window.GetCount());
+
+  const auto stats = window.GetStatistics();
+  EXPECT_TRUE(std::isnan(stats.average));
+  EXPECT_TRUE(std::isnan(stats.min));
+  EXPECT_TRUE(std::isnan(stats.max));
+  EXPECT_TRUE(std::isnan(stats.standard_deviation));
+  EXPECT_EQ(0u, stats.sample_count);
+}
+
+TEST(SlidingWindowStatisticsTest, TestInvalidArguments) {
+  EXPECT_THROW(
+    SlidingWindowStatistics(std::chrono::nanoseconds{0}, kBucketCount), std::invalid_argument);
+  EXPECT_THROW(
+    SlidingWindowStatistics(kBucketDuration, 0), std::invalid_argument);
+}
+
+TEST(SlidingWindowStatisticsTest, TestWithinWindow) {
+  SlidingWindowStatistics window{kBucketDuration, kBucketCount};
+  const auto start = Start();
+  for (int i = 1; i <= 5; i++) {
+    window.AddMeasurement(i, start + i * kBucketDuration);
+  }
+  window.AddMeasurement(std::numeric_limits<double>::quiet_NaN(), start);
+
+  const auto stats = window.GetStatistics(start + 5 * kBucketDuration);
+  EXPECT_EQ(5u, stats.sample_count);
+  EXPECT_DOUBLE_EQ(3, stats.average);
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(5, stats.max);
+  EXPECT_NEAR(1.4142, stats.standard_deviation, 1e-4);
+}
+
+TEST(SlidingWindowStatisticsTest, TestWindowRollsForward) {
+  SlidingWindowStatistics window{kBucketDuration, kBucketCount};
+  const auto start = Start();
+  for (size_t i = 0; i < 2 * kBucketCount; i++) {
+    window.AddMeasurement(static_cast<double>(i), start + i * kBucketDuration);
+  }
+
+  // only the newest kBucketCount intervals are still within the window
+  auto stats = window.GetStatistics(start + (2 * kBucketCount - 1) * kBucketDuration);
+  EXPECT_EQ(kBucketCount, stats.sample_count);
+  EXPECT_EQ(kBucketCount, stats.min);
+  EXPECT_EQ(2 * kBucketCount - 1, stats.max);
+
+  // expire half of the remaining buckets without any new observation
+  stats = window.GetStatistics(start + (2 * kBucketCount + 4) * kBucketDuration);
+  EXPECT_EQ(kBucketCount / 2, stats.sample_count);
+  EXPECT_EQ(kBucketCount + 5, stats.min);
+
+  stats = window.GetStatistics(start + 4 * kBucketCount * kBucketDuration);
+  EXPECT_EQ(0u, stats.sample_count);
+  EXPECT_TRUE(std::isnan(stats.average));
+}
+
+TEST(SlidingWindowStatisticsTest, TestDiscardsLateMeasurement) {
+  SlidingWindowStatistics window{kBucketDuration, kBucketCount};
+  const auto start = Start();
+  window.AddMeasurement(1, start + kBucketCount * kBucketDuration);
+  // older than the window, must not recycle the bucket of the newer observation
+  window.AddMeasurement(2, start);
+  // late but still within the window
+  window.AddMeasurement(3, start + kBucketDuration);
+
+  const auto stats = window.GetStatistics(start + kBucketCount * kBucketDuration);
+  EXPECT_EQ(2u, stats.sample_count);
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(3, stats.max);
+}
+
+TEST(SlidingWindowStatisticsTest, TestAddMeasurementsAndReset) {
+  SlidingWindowStatistics window{std::chrono::hours{1}, 2};
+  const double items[] = {1, 2, std::numeric_limits<double>::quiet_NaN(), 3};
+  window.AddMeasurements(items, 4);
+  window.AddMeasurement(4);
+
+  auto stats = window.GetStatistics();
+  EXPECT_EQ(4u, window.GetCount());
+  EXPECT_DOUBLE_EQ(2.5, stats.average);
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(4, stats.max);
+
+  window.Reset();
+  EXPECT_EQ(0u, window.GetCount());
+  stats = window.GetStatistics();
+  EXPECT_TRUE(std::isnan(stats.average));
+}
+
+TEST(SlidingWindowStatisticsTest, TestGetStatisticsAndReset) {
+  SlidingWindowStatistics window{std::chrono::hours{1}, 2};
+  window.AddMeasurement(1);
+  window.AddMeasurement(3);
+
+  auto stats = window.GetStatisticsAndReset();
+  EXPECT_EQ(2u, stats.sample_count);
+  EXPECT_DOUBLE_EQ(2, stats.average);
+  EXPECT_EQ(0u, window.GetCount());
+
+  window.AddMeasurement(5);
+  stats = window.GetStatisticsAndReset();
+  EXPECT_EQ(1u, stats.sample_count);
+  EXPECT_EQ(5, stats.average);
+}
@@ -0,0 +1,184 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "libstatistics_collector/collector/collector.hpp"
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/instrumentation.hpp"
+#include "libstatistics_collector/msg/dummy_message.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_age.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
+
+namespace
+{
+using libstatistics_collector::InstrumentationData;
+using libstatistics_collector::kInstrumentationEnabled;
+using DummyMessage = libstatistics_collector::msg::DummyMessage;
+
+constexpr const char kNodeName[] = "test_node_name";
+constexpr const char kMetricName[] = "test_metric_name";
+
+/**
+ * Minimal collector of generic measurements
+ */
+class TestCollector : public libstatistics_collector::collector::Collector
+{
+public:
+  std::string GetMetricName() const override
+  {
+    return kMetricName;
+  }
+
+  std::string GetMetricUnit() const override
+  {
+    return "test_metric_unit";
+  }
+
+private:
+  bool SetupStart() override
+  {
+    return true;
+  }
+
+  bool SetupStop() override
+  {
+    return true;
+  }
+};
+
+/**
+ * Return expected if instrumentation is enabled, 0 otherwise
+ */
+uint64_t Expected(const uint64_t expected)
+{
+  return kInstrumentationEnabled ? expected : 0;
+}
+}  // namespace
+
+TEST(InstrumentationTest, TestAcceptData) {
+  TestCollector collector;
+  collector.AcceptData(1.0);
+  collector.AcceptData(std::nan(""));
+  const double block[] = {2.0, std::nan(""), std::nan(""), 3.0};
+  collector.AcceptData(block, 4);
+
+  const InstrumentationData data = collector.GetInstrumentationData();
+  EXPECT_EQ(Expected(3), data.accept_data_count);
+  EXPECT_EQ(Expected(3), data.dropped_sample_count);
+  EXPECT_EQ(0u, data.message_count);
+  EXPECT_EQ(0u, data.message_nanoseconds);
+  EXPECT_EQ(0u, data.lock_contention_count);
+  if (!kInstrumentationEnabled) {
+    EXPECT_EQ(0u, data.accept_data_nanoseconds);
+  }
+  // NaN measurements are dropped either way
+  EXPECT_EQ(3u, collector.GetStatisticsResults().sample_count);
+}
+
+TEST(InstrumentationTest, TestTopicStatisticsCollectors) {
+  libstatistics_collector::topic_statistics_collector::ReceivedMessageAgeCollector<DummyMessage>
+  age_collector;
+  DummyMessage msg;
+  msg.header.stamp.sec = 1;
+  age_collector.OnMessageReceived(msg, RCL_S_TO_NS(2));
+  // a message without stamp has no age
+  age_collector.OnMessageReceived(DummyMessage{}, RCL_S_TO_NS(2));
+
+  InstrumentationData data = age_collector.GetInstrumentationData();
+  EXPECT_EQ(Expected(2), data.message_count);
+  EXPECT_EQ(Expected(1), data.accept_data_count);
+  EXPECT_EQ(Expected(1), data.dropped_sample_count);
+  EXPECT_GE(data.message_nanoseconds, data.accept_data_nanoseconds);
+
+  libstatistics_collector::topic_statistics_collector::ReceivedMessagePeriodCollector<DummyMessage>
+  period_collector;
+  period_collector.OnMessageReceived(msg, RCL_S_TO_NS(2));
+  period_collector.OnMessageReceived(msg, RCL_S_TO_NS(3));
+  // a negative period is discarded
+  period_collector.OnMessageReceived(msg, RCL_S_TO_NS(1));
+
+  data = period_collector.GetInstrumentationData();
+  EXPECT_EQ(Expected(3), data.message_count);
+  EXPECT_EQ(Expected(1), data.accept_data_count);
+  EXPECT_EQ(Expected(1), data.dropped_sample_count);
+  EXPECT_EQ(1u, period_collector.GetDiscardedPeriodCount());
+}
+
+TEST(InstrumentationTest, TestLockContention) {
+  std::mutex mutex;
+  std::atomic<uint64_t> contention_count{0};
+  {
+    auto lock = libstatistics_collector::LockCountingContention(mutex, contention_count);
+    EXPECT_TRUE(lock.owns_lock());
+  }
+  EXPECT_EQ(0u, contention_count.load());
+
+  std::unique_lock<std::mutex> held{mutex};
+  std::atomic<bool> locked{false};
+  std::thread waiter{[&]() {
+      auto lock = libstatistics_collector::LockCountingContention(mutex, contention_count);
+      locked = true;
+    }};
+  if (kInstrumentationEnabled) {
+    // the waiter counts the contention before blocking
+    while (contention_count.load() == 0) {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_FALSE(locked.load());
+  held.unlock();
+  waiter.join();
+  EXPECT_TRUE(locked.load());
+  EXPECT_EQ(Expected(1), contention_count.load());
+}
+
+TEST(InstrumentationTest, TestGenerateInstrumentationMessage) {
+  InstrumentationData data;
+  data.accept_data_count = 1;
+  data.accept_data_nanoseconds = 2;
+  data.message_count = 3;
+  data.message_nanoseconds = 4;
+  data.lock_contention_count = 5;
+  data.dropped_sample_count = 6;
+  builtin_interfaces::msg::Time window_start;
+  window_start.sec = 10;
+  builtin_interfaces::msg::Time window_stop;
+  window_stop.sec = 11;
+
+  const auto msg = libstatistics_collector::collector::GenerateInstrumentationMessage(
+    kNodeName, kMetricName, window_start, window_stop, data);
+  EXPECT_EQ(kNodeName, msg.measurement_source_name);
+  EXPECT_EQ(
+    std::string{kMetricName} + libstatistics_collector::collector::kInstrumentationMetricSuffix,
+    msg.metrics_source);
+  EXPECT_EQ(libstatistics_collector::collector::kInstrumentationMetricUnit, msg.unit);
+  EXPECT_EQ(10, msg.window_start.sec);
+  EXPECT_EQ(11, msg.window_stop.sec);
+  ASSERT_EQ(6u, msg.statistics.size());
+  for (size_t i = 0; i < msg.statistics.size(); i++) {
+    EXPECT_EQ(
+      libstatistics_collector::collector::kStatisticsDataTypeAcceptDataCount + i,
+      msg.statistics[i].data_type);
+    EXPECT_EQ(static_cast<double>(i + 1), msg.statistics[i].data);
+  }
+}
@@ -15,15 +15,59 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cmath>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
+#include "libstatistics_collector/moving_average_statistics/log_linear_histogram.hpp"
 #include "libstatistics_collector/msg/dummy_message.hpp"
 #include "libstatistics_collector/msg/dummy_custom_header_message.hpp"
 #include "libstatistics_collector/topic_statistics_collector/constants.hpp"
 #include "libstatistics_collector/topic_statistics_collector/received_message_age.hpp"
 
+#include "builtin_interfaces/msg/time.hpp"
 #include "rcl/time.h"
 
+namespace
+{
+/**
+ * Message without a header, with its stamp at the top level
+ */
+struct TopLevelStampMessage
+{
+  builtin_interfaces::msg::Time stamp;
+};
+
+/**
+ * Message without a header, with its stamp in integer nanoseconds in a nested field
+ */
+struct NestedStampMessage
+{
+  struct Info
+  {
+    int64_t timestamp_ns = 0;
+  };
+  Info info;
+};
+}  // namespace
+
+namespace libstatistics_collector
+{
+namespace topic_statistics_collector
+{
+template<>
+struct TimeStamp<TopLevelStampMessage>: StampField<&TopLevelStampMessage::stamp> {};
+
+template<>
+struct TimeStamp<NestedStampMessage>
+  : StampField<&NestedStampMessage::info, &NestedStampMessage::Info::timestamp_ns> {};
+}  // namespace topic_statistics_collector
+}  // namespace libstatistics_collector
+
 namespace
 {
 using DummyMessage = libstatistics_collector::msg::DummyMessage;
@@ -142,9 +186,135 @@ TEST(ReceivedMessageAgeTest, TestAgeMeasurement) {
   EXPECT_DOUBLE_EQ(kExpectedStandardDeviation, stats.standard_deviation);
 }
 
+TEST(ReceivedMessageAgeTest, TestSampledAgeMeasurement) {
+  using libstatistics_collector::topic_statistics_collector::SamplingPolicy;
+
+  ReceivedDummyMessageAgeCollector test_collector{};
+  test_collector.SetSamplingPolicy(SamplingPolicy::EveryNth(kDefaultTimesToTest));
+  EXPECT_EQ(1.0 / kDefaultTimesToTest, test_collector.GetSamplingPolicy().GetSampleRate());
+
+  auto msg = DummyMessage{};
+  msg.header.stamp.sec = kDefaultTimeMessageReceived;
+  for (int i = 0; i < 3 * kDefaultTimesToTest; ++i) {
+    test_collector.OnMessageReceived(msg, kDefaultTimeMessageReceived);
+  }
+  EXPECT_EQ(static_cast<uint64_t>(3 * kDefaultTimesToTest), test_collector.GetMessageCount());
+  const auto stats = test_collector.GetStatisticsResults();
+  EXPECT_EQ(3, stats.sample_count);
+  EXPECT_EQ(1.0 / kDefaultTimesToTest, stats.sample_rate);
+}
+
+TEST(ReceivedMessageAgeTest, TestHistogramAgeMeasurement) {
+  using libstatistics_collector::moving_average_statistics::LogLinearHistogram;
+
+  ReceivedDummyMessageAgeCollector test_collector{std::make_unique<LogLinearHistogram>()};
+
+  auto msg = DummyMessage{};
+  msg.header.stamp.sec = 1;
+  for (int i = 1; i <= kDefaultTimesToTest; ++i) {
+    test_collector.OnMessageReceived(msg, RCL_S_TO_NS(1) + RCL_MS_TO_NS(i));
+  }
+  const auto stats = test_collector.GetStatisticsResults();
+  EXPECT_EQ(kDefaultTimesToTest, stats.sample_count);
+  // within the relative precision of the default histogram
+  EXPECT_NEAR(5.5, stats.average, 5.5 / 64);
+  EXPECT_NEAR(1.0, stats.min, 1.0 / 64);
+  EXPECT_NEAR(10.0, stats.max, 10.0 / 64);
+
+  std::vector<libstatistics_collector::moving_average_statistics::HistogramBucket> buckets;
+  const auto window = test_collector.GetStatisticsAndHistogramAndReset(buckets);
+  EXPECT_EQ(kDefaultTimesToTest, window.sample_count);
+  EXPECT_EQ(1.0, window.sample_rate);
+  EXPECT_EQ(static_cast<size_t>(kDefaultTimesToTest), buckets.size());
+  EXPECT_EQ(0, test_collector.GetStatisticsResults().sample_count);
+}
+
+TEST(ReceivedMessageAgeTest, TestExactAgeMeasurement) {
+  using libstatistics_collector::moving_average_statistics::ExactDurationStatistics;
+
+  ReceivedDummyMessageAgeCollector test_collector{std::make_unique<ExactDurationStatistics>()};
+
+  auto msg = DummyMessage{};
+  msg.header.stamp.sec = 1;
+  for (int i = 1; i <= kDefaultTimesToTest; ++i) {
+    test_collector.OnMessageReceived(msg, RCL_S_TO_NS(1) + RCL_MS_TO_NS(i));
+  }
+  // no stamp, not measured
+  test_collector.OnMessageReceived(DummyMessage{}, RCL_S_TO_NS(1));
+
+  const auto stats = test_collector.GetStatisticsResults();
+  EXPECT_EQ(kDefaultTimesToTest, stats.sample_count);
+  EXPECT_EQ(5.5, stats.average);
+  EXPECT_EQ(1.0, stats.min);
+  EXPECT_EQ(10.0, stats.max);
+  EXPECT_DOUBLE_EQ(std::sqrt(8.25), stats.standard_deviation);
+}
+
+TEST(ReceivedMessageAgeTest, TestStampFieldAgeMeasurement) {
+  using libstatistics_collector::topic_statistics_collector::ReceivedMessageAgeCollector;
+
+  ReceivedMessageAgeCollector<TopLevelStampMessage> top_level_collector;
+  ReceivedMessageAgeCollector<NestedStampMessage> nested_collector;
+
+  // a zero stamp is not measured
+  top_level_collector.OnMessageReceived(TopLevelStampMessage{}, kStartTime);
+  nested_collector.OnMessageReceived(NestedStampMessage{}, kStartTime);
+
+  auto top_level_msg = TopLevelStampMessage{};
+  top_level_msg.stamp.sec = 1;
+  auto nested_msg = NestedStampMessage{};
+  nested_msg.info.timestamp_ns = RCL_S_TO_NS(1);
+  for (int i = 1; i <= 3; ++i) {
+    top_level_collector.OnMessageReceived(top_level_msg, RCL_S_TO_NS(1 + i));
+    nested_collector.OnMessageReceived(nested_msg, RCL_S_TO_NS(1 + i));
+  }
+
+  for (const auto & stats : {
+      top_level_collector.GetStatisticsResults(), nested_collector.GetStatisticsResults()})
+  {
+    EXPECT_EQ(3, stats.sample_count);
+    EXPECT_DOUBLE_EQ(kExpectedAverageMilliseconds, stats.average);
+    EXPECT_DOUBLE_EQ(kExpectedMinMilliseconds, stats.min);
+    EXPECT_DOUBLE_EQ(kExpectedMaxMilliseconds, stats.max);
+    EXPECT_DOUBLE_EQ(kExpectedStandardDeviation, stats.standard_deviation);
+  }
+  if (libstatistics_collector::kInstrumentationEnabled) {
+    EXPECT_EQ(1u, nested_collector.GetInstrumentationData().dropped_sample_count);
+  }
+}
+
+TEST(ReceivedMessageAgeTest, TestStampFieldSelectsWithoutCopy) {
+  using libstatistics_collector::topic_statistics_collector::SelectField;
+
+  const auto nested_msg = NestedStampMessage{};
+  EXPECT_EQ(
+    &nested_msg.info.timestamp_ns,
+    &(SelectField<&NestedStampMessage::info, &NestedStampMessage::Info::timestamp_ns>(
+      nested_msg)));
+}
+
 TEST(ReceivedMessageAgeTest, TestGetStatNameAndUnit) {
   ReceivedDummyMessageAgeCollector test_collector{};
 
   EXPECT_FALSE(test_collector.GetMetricName().empty());
   EXPECT_FALSE(test_collector.GetMetricUnit().empty());
+  EXPECT_EQ(test_collector.GetMetricName(), test_collector.GetMetricNameView());
+  EXPECT_EQ(test_collector.GetMetricUnit(), test_collector.GetMetricUnitView());
+}
+
+TEST(ReceivedMessageAgeTest, TestFinalCollector) {
+  using libstatistics_collector::topic_statistics_collector::FinalReceivedMessageAgeCollector;
+  static_assert(std::is_final<FinalReceivedMessageAgeCollector<DummyMessage>>::value, "");
+
+  FinalReceivedMessageAgeCollector<DummyMessage> test_collector{};
+  auto msg = DummyMessage{};
+  msg.header.stamp.sec = 1;
+  test_collector.OnMessageReceived(msg, RCL_S_TO_NS(3));
+  auto stats = test_collector.GetStatisticsResults();
+  EXPECT_EQ(1, stats.sample_count);
+  EXPECT_EQ(2000.0, stats.average);
+
+  FinalReceivedMessageAgeCollector<int> int_msg_collector{};
+  int_msg_collector.OnMessageReceived(kRandomIntMessage, kDefaultTimeMessageReceived);
+  EXPECT_EQ(0, int_msg_collector.GetStatisticsResults().sample_count);
 }
@@ -0,0 +1,207 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "libstatistics_collector/topic_statistics_collector/constants.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_jitter.hpp"
+
+#include "rcl/time.h"
+
+namespace
+{
+using ReceivedIntMessageJitterCollector =
+  libstatistics_collector::topic_statistics_collector::ReceivedMessageJitterCollector<int>;
+
+constexpr const std::chrono::milliseconds kExpectedPeriod{10};
+constexpr const int kDefaultMessage{42};
+constexpr const rcl_time_point_value_t kStartTime{RCL_S_TO_NS(1)};
+}  // namespace
+
+TEST(ReceivedMessageJitterTest, TestJitterMeasurement) {
+  ReceivedIntMessageJitterCollector test{kExpectedPeriod};
+  EXPECT_EQ(kExpectedPeriod, test.GetExpectedPeriod());
+  EXPECT_TRUE(test.Start());
+
+  // periods of 8, 12, 10 and 14 ms
+  rcl_time_point_value_t now = kStartTime;
+  test.OnMessageReceived(kDefaultMessage, now);
+  for (const int64_t period_ms : {8, 12, 10, 14}) {
+    now += RCL_MS_TO_NS(period_ms);
+    test.OnMessageReceived(kDefaultMessage, now);
+  }
+
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(4, stats.sample_count);
+  EXPECT_DOUBLE_EQ(2.0, stats.average);
+  EXPECT_DOUBLE_EQ(0.0, stats.min);
+  EXPECT_DOUBLE_EQ(4.0, stats.max);
+  EXPECT_EQ(0u, test.GetBurstCount());
+  EXPECT_EQ(0u, test.GetGapCount());
+  EXPECT_EQ(std::chrono::nanoseconds::zero(), test.GetLongestGap());
+}
+
+TEST(ReceivedMessageJitterTest, TestBurstsAndGaps) {
+  ReceivedIntMessageJitterCollector test{kExpectedPeriod};
+  EXPECT_TRUE(test.Start());
+
+  // a batch of 3 messages within 1 ms, a stall of 50 ms, a stall of 25 ms, and a period of 20 ms,
+  // which is not above the gap threshold of twice the expected period
+  rcl_time_point_value_t now = kStartTime;
+  test.OnMessageReceived(kDefaultMessage, now);
+  for (const int64_t period_us : {500, 500, 50000, 25000, 20000}) {
+    now += RCL_US_TO_NS(period_us);
+    test.OnMessageReceived(kDefaultMessage, now);
+  }
+
+  EXPECT_EQ(2u, test.GetBurstCount());
+  EXPECT_EQ(2u, test.GetGapCount());
+  EXPECT_EQ(std::chrono::milliseconds{50}, test.GetLongestGap());
+  EXPECT_EQ(5, test.GetStatisticsAndReset().sample_count);
+
+  // the counts are kept across windows
+  EXPECT_EQ(2u, test.GetGapCount());
+  EXPECT_EQ(0, test.GetStatisticsResults().sample_count);
+}
+
+TEST(ReceivedMessageJitterTest, TestStalledTopic) {
+  ReceivedIntMessageJitterCollector test{kExpectedPeriod};
+  EXPECT_TRUE(test.Start());
+  EXPECT_EQ(std::chrono::nanoseconds::zero(), test.GetTimeSinceLastMessage(kStartTime));
+
+  rcl_time_point_value_t now = kStartTime;
+  for (int i = 0; i < 5; ++i) {
+    test.OnMessageReceived(kDefaultMessage, now);
+    now += RCL_MS_TO_NS(kExpectedPeriod.count());
+  }
+
+  // the topic stops publishing: the gap is open, so it is not counted yet
+  now += RCL_S_TO_NS(1);
+  EXPECT_EQ(0u, test.GetGapCount());
+  EXPECT_EQ(std::chrono::nanoseconds::zero(), test.GetLongestGap());
+  EXPECT_EQ(std::chrono::milliseconds{1010}, test.GetTimeSinceLastMessage(now));
+
+  // the message ending the gap counts it
+  test.OnMessageReceived(kDefaultMessage, now);
+  EXPECT_EQ(1u, test.GetGapCount());
+  EXPECT_EQ(std::chrono::milliseconds{1010}, test.GetLongestGap());
+  EXPECT_EQ(std::chrono::nanoseconds::zero(), test.GetTimeSinceLastMessage(now));
+
+  // restarting forgets the last message
+  EXPECT_TRUE(test.Stop());
+  EXPECT_TRUE(test.Start());
+  EXPECT_EQ(std::chrono::nanoseconds::zero(), test.GetTimeSinceLastMessage(now));
+}
+
+TEST(ReceivedMessageJitterTest, TestBurstsAndGapsOfUnsampledPeriods) {
+  ReceivedIntMessageJitterCollector test{kExpectedPeriod};
+  test.SetSamplingPolicy(
+    libstatistics_collector::topic_statistics_collector::SamplingPolicy::EveryNth(4));
+  EXPECT_TRUE(test.Start());
+
+  // 8 periods, 2 of them bursts and 2 gaps, of which only every 4th is sampled
+  rcl_time_point_value_t now = kStartTime;
+  test.OnMessageReceived(kDefaultMessage, now);
+  for (const int64_t period_ms : {10, 1, 10, 50, 10, 1, 10, 50}) {
+    now += RCL_MS_TO_NS(period_ms);
+    test.OnMessageReceived(kDefaultMessage, now);
+  }
+
+  EXPECT_EQ(2u, test.GetBurstCount());
+  EXPECT_EQ(2u, test.GetGapCount());
+  EXPECT_EQ(2, test.GetStatisticsResults().sample_count);
+}
+
+TEST(ReceivedMessageJitterTest, TestCustomThresholds) {
+  ReceivedIntMessageJitterCollector test{
+    kExpectedPeriod, std::chrono::milliseconds{9}, std::chrono::milliseconds{11}};
+  EXPECT_TRUE(test.Start());
+
+  rcl_time_point_value_t now = kStartTime;
+  test.OnMessageReceived(kDefaultMessage, now);
+  for (const int64_t period_ms : {8, 10, 12}) {
+    now += RCL_MS_TO_NS(period_ms);
+    test.OnMessageReceived(kDefaultMessage, now);
+  }
+  EXPECT_EQ(1u, test.GetBurstCount());
+  EXPECT_EQ(1u, test.GetGapCount());
+}
+
+TEST(ReceivedMessageJitterTest, TestDiscardedPeriodsAreNotGaps) {
+  ReceivedIntMessageJitterCollector test{kExpectedPeriod};
+  test.SetMaxPeriod(std::chrono::seconds{1});
+  EXPECT_TRUE(test.Start());
+
+  test.OnMessageReceived(kDefaultMessage, kStartTime);
+  test.OnMessageReceived(kDefaultMessage, kStartTime + RCL_S_TO_NS(2));
+  test.OnMessageReceived(kDefaultMessage, kStartTime + RCL_S_TO_NS(1));
+
+  EXPECT_EQ(2u, test.GetDiscardedPeriodCount());
+  EXPECT_EQ(0u, test.GetGapCount());
+  EXPECT_EQ(0u, test.GetBurstCount());
+  EXPECT_EQ(0, test.GetStatisticsResults().sample_count);
+}
+
+TEST(ReceivedMessageJitterTest, TestInvalidArguments) {
+  EXPECT_THROW(
+    ReceivedIntMessageJitterCollector{std::chrono::nanoseconds::zero()}, std::invalid_argument);
+  EXPECT_THROW(
+    ReceivedIntMessageJitterCollector(
+      kExpectedPeriod, std::chrono::milliseconds{20}, std::chrono::milliseconds{5}),
+    std::invalid_argument);
+}
+
+TEST(ReceivedMessageJitterTest, TestGetMetricNameAndUnit) {
+  ReceivedIntMessageJitterCollector test{kExpectedPeriod};
+  EXPECT_EQ(
+    libstatistics_collector::topic_statistics_collector::topic_statistics_constants::
+    kMsgPeriodDeviationStatName, test.GetMetricName());
+  EXPECT_EQ(
+    libstatistics_collector::topic_statistics_collector::topic_statistics_constants::
+    kMillisecondUnitName, test.GetMetricUnit());
+}
+
+TEST(ReceivedMessageJitterTest, TestConcurrentGapCounts) {
+  constexpr int kThreadCount{4};
+  constexpr int kMessagesPerThread{1000};
+  // every period is a gap, on a clock shared by all threads
+  ReceivedIntMessageJitterCollector test{std::chrono::nanoseconds{1}};
+  EXPECT_TRUE(test.Start());
+
+  std::atomic<rcl_time_point_value_t> clock{kStartTime};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back(
+      [&test, &clock]() {
+        for (int j = 0; j < kMessagesPerThread; ++j) {
+          test.OnMessageReceived(kDefaultMessage, clock.fetch_add(RCL_US_TO_NS(10)));
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  // the threads stamp and measure in different orders, so some periods are negative
+  EXPECT_EQ(
+    static_cast<uint64_t>(kThreadCount * kMessagesPerThread - 1),
+    test.GetGapCount() + test.GetDiscardedPeriodCount());
+  EXPECT_EQ(test.GetGapCount(), static_cast<uint64_t>(test.GetStatisticsResults().sample_count));
+}
@@ -15,10 +15,16 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <thread>
+#include <type_traits>
 
+#include "libstatistics_collector/moving_average_statistics/exact_duration_statistics.hpp"
 #include "libstatistics_collector/moving_average_statistics/types.hpp"
 #include "libstatistics_collector/topic_statistics_collector/constants.hpp"
 #include "libstatistics_collector/topic_statistics_collector/received_message_period.hpp"
@@ -79,9 +85,179 @@ TEST(ReceivedMessagePeriodTest, TestPeriodMeasurement) {
   EXPECT_EQ(kExpectedStandardDeviation, stats.standard_deviation);
 }
 
+TEST(ReceivedMessagePeriodTest, TestSingleWriterPeriodMeasurement) {
+  ReceivedIntMessagePeriodCollector test{
+    libstatistics_collector::moving_average_statistics::WriterMode::kSingleWriter};
+  ASSERT_TRUE(test.Start());
+
+  rcl_time_point_value_t fake_now_nanos_{1};
+  for (int i = 0; i < 4; i++) {
+    test.OnMessageReceived(kDefaultMessage, fake_now_nanos_);
+    fake_now_nanos_ +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(kDefaultDurationSeconds).count();
+  }
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(3, stats.sample_count);
+  EXPECT_EQ(kExpectedAverageMilliseconds, stats.average);
+  EXPECT_EQ(kExpectedStandardDeviation, stats.standard_deviation);
+}
+
+TEST(ReceivedMessagePeriodTest, TestExactPeriodMeasurement) {
+  using libstatistics_collector::moving_average_statistics::ExactDurationStatistics;
+
+  ReceivedIntMessagePeriodCollector test{std::make_unique<ExactDurationStatistics>()};
+  ASSERT_TRUE(test.Start());
+
+  // periods of 1 s alternating with 1 s + 1 ns, far from the first time stamp
+  rcl_time_point_value_t fake_now_nanos_{RCL_S_TO_NS(1000000)};
+  for (int i = 0; i < 101; i++) {
+    test.OnMessageReceived(kDefaultMessage, fake_now_nanos_);
+    fake_now_nanos_ += RCL_S_TO_NS(1) + i % 2;
+  }
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(100, stats.sample_count);
+  EXPECT_EQ(1000.0000005, stats.average);
+  EXPECT_EQ(kExpectedMinMilliseconds, stats.min);
+  EXPECT_EQ(1000.000001, stats.max);
+  EXPECT_DOUBLE_EQ(0.0000005, stats.standard_deviation);
+}
+
+TEST(ReceivedMessagePeriodTest, TestSampledPeriodMeasurement) {
+  using libstatistics_collector::topic_statistics_collector::SamplingPolicy;
+
+  ReceivedIntMessagePeriodCollector test{};
+  test.SetSamplingPolicy(SamplingPolicy::EveryNth(4));
+  ASSERT_TRUE(test.Start());
+
+  // every 4th message is measured, with the period to the message following it
+  rcl_time_point_value_t fake_now_nanos_{1};
+  for (int i = 0; i < 16; i++) {
+    test.OnMessageReceived(kDefaultMessage, fake_now_nanos_);
+    fake_now_nanos_ += (i % 4 == 0) ?
+      std::chrono::duration_cast<std::chrono::nanoseconds>(kDefaultDurationSeconds).count() : 1;
+  }
+  EXPECT_EQ(16u, test.GetMessageCount());
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(4, stats.sample_count);
+  EXPECT_EQ(kExpectedAverageMilliseconds, stats.average);
+  EXPECT_EQ(0.25, stats.sample_rate);
+  EXPECT_EQ(0.25, test.GetStatisticsAndReset().sample_rate);
+
+  // a restart forgets a pending measurement
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_);
+  ASSERT_TRUE(test.Stop());
+  ASSERT_TRUE(test.Start());
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_ + 1);
+  EXPECT_EQ(0, test.GetStatisticsResults().sample_count);
+}
+
+TEST(ReceivedMessagePeriodTest, TestDiscardedPeriods) {
+  ReceivedIntMessagePeriodCollector test{};
+  test.SetMaxPeriod(std::chrono::seconds{10});
+  ASSERT_TRUE(test.Start());
+
+  const rcl_time_point_value_t period =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(kDefaultDurationSeconds).count();
+  rcl_time_point_value_t fake_now_nanos_{period};
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_);
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_ += period);
+  // the clock jumps backwards, then forwards, periods are measured again from the new time
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_ -= 5 * period);
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_ += period);
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_ += 100 * period);
+  test.OnMessageReceived(kDefaultMessage, fake_now_nanos_ += period);
+
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(3, stats.sample_count);
+  EXPECT_EQ(kExpectedAverageMilliseconds, stats.average);
+  EXPECT_EQ(kExpectedMaxMilliseconds, stats.max);
+  EXPECT_EQ(2u, test.GetDiscardedPeriodCount());
+}
+
+TEST(ReceivedMessagePeriodTest, TestTimeSourcePeriodMeasurement) {
+  using libstatistics_collector::topic_statistics_collector::SteadyTimeSource;
+  using libstatistics_collector::topic_statistics_collector::SteadyTimeSourceType;
+
+  ReceivedIntMessagePeriodCollector test{};
+  test.SetTimeSource(SteadyTimeSource{SteadyTimeSourceType::kTsc});
+  EXPECT_TRUE(
+    test.GetTimeSource().GetType() == SteadyTimeSourceType::kTsc ||
+    !SteadyTimeSource::IsSupported(SteadyTimeSourceType::kTsc));
+  ASSERT_TRUE(test.Start());
+
+  for (int i = 0; i < 3; i++) {
+    test.OnMessageReceived(kDefaultMessage);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(2, stats.sample_count);
+  // slept at least 10 ms between messages, allowing for a loaded machine
+  EXPECT_GE(stats.min, 9.0);
+  EXPECT_LT(stats.max, 1000.0);
+  EXPECT_EQ(0u, test.GetDiscardedPeriodCount());
+}
+
+TEST(ReceivedMessagePeriodTest, TestFinalCollector) {
+  using libstatistics_collector::topic_statistics_collector::FinalReceivedMessagePeriodCollector;
+  static_assert(std::is_final<FinalReceivedMessagePeriodCollector<int>>::value, "");
+
+  FinalReceivedMessagePeriodCollector<int> test{
+    libstatistics_collector::moving_average_statistics::WriterMode::kSingleWriter};
+  test.OnMessageReceived(kDefaultMessage, 1);
+  test.OnMessageReceived(
+    kDefaultMessage,
+    1 + std::chrono::duration_cast<std::chrono::nanoseconds>(kDefaultDurationSeconds).count());
+  const auto stats = test.GetStatisticsResults();
+  EXPECT_EQ(1, stats.sample_count);
+  EXPECT_EQ(kExpectedAverageMilliseconds, stats.average);
+}
+
 TEST(ReceivedMessagePeriodTest, TestGetStatNameAndUnit) {
   ReceivedIntMessagePeriodCollector test{};
 
   EXPECT_FALSE(test.GetMetricName().empty());
   EXPECT_FALSE(test.GetMetricUnit().empty());
+  EXPECT_EQ(test.GetMetricName(), test.GetMetricNameView());
+  EXPECT_EQ(test.GetMetricUnit(), test.GetMetricUnitView());
+}
+
+TEST(ReceivedMessagePeriodTest, TestConcurrentMessages) {
+  using libstatistics_collector::moving_average_statistics::WriterMode;
+  for (const auto writer_mode : {WriterMode::kMultiWriter, WriterMode::kSharded}) {
+    ReceivedIntMessagePeriodCollector test{writer_mode};
+    ASSERT_TRUE(test.Start());
+
+    constexpr int kThreads = 4;
+    constexpr int kMessagesPerThread = 1000;
+    std::atomic<rcl_time_point_value_t> fake_now_nanos{1};
+    std::array<std::thread, kThreads> threads;
+    for (auto & thread : threads) {
+      thread = std::thread([&test, &fake_now_nanos]() {
+            for (int i = 0; i < kMessagesPerThread; i++) {
+              test.OnMessageReceived(kDefaultMessage, fake_now_nanos.fetch_add(1));
+            }
+          });
+    }
+    uint64_t sample_count = 0;
+    for (int i = 0; i < 10; i++) {
+      sample_count += test.GetStatisticsAndReset().sample_count;
+    }
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    sample_count += test.GetStatisticsAndReset().sample_count;
+
+    // every message but the first one is paired with exactly one predecessor. The threads can
+    // take the lock in another order than they took their time stamps, so some periods are
+    // negative and discarded.
+    EXPECT_EQ(
+      static_cast<uint64_t>(kThreads * kMessagesPerThread - 1),
+      sample_count + test.GetDiscardedPeriodCount());
+
+    // restarting forgets the time of the last message
+    EXPECT_TRUE(test.Stop());
+    EXPECT_TRUE(test.Start());
+    test.OnMessageReceived(kDefaultMessage, fake_now_nanos.load());
+    EXPECT_EQ(0, test.GetStatisticsResults().sample_count);
+  }
 }
@@ -0,0 +1,230 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libstatistics_collector/msg/dummy_message.hpp"
+#include "libstatistics_collector/topic_statistics_collector/constants.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_rate.hpp"
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+#include "rcl/time.h"
+#include "rcl/types.h"
+
+namespace
+{
+namespace constants =
+  libstatistics_collector::topic_statistics_collector::topic_statistics_constants;
+using DummyMessage = libstatistics_collector::msg::DummyMessage;
+using ReceivedDummyMessageRateCollector = libstatistics_collector::
+  topic_statistics_collector::ReceivedMessageRateCollector<DummyMessage>;
+using ReceivedSerializedMessageRateCollector = libstatistics_collector::
+  topic_statistics_collector::ReceivedMessageRateCollector<rcl_serialized_message_t>;
+
+constexpr const int kDefaultTimesToTest{50};
+constexpr const rcl_duration_value_t kHalfSecond{RCL_MS_TO_NS(500)};
+constexpr const size_t kSerializedSize{64};
+constexpr const char kTestNodeName[] = "test_node";
+
+/**
+ * Message that cannot be default constructed
+ */
+struct NoDefaultMessage
+{
+  explicit NoDefaultMessage(int message_value)
+  : value{message_value} {}
+
+  int value;
+};
+
+builtin_interfaces::msg::Time MakeTime(const int32_t sec, const uint32_t nanosec)
+{
+  builtin_interfaces::msg::Time time;
+  time.sec = sec;
+  time.nanosec = nanosec;
+  return time;
+}
+}  // namespace
+
+TEST(ReceivedMessageRateTest, TestRateOfWindow) {
+  ReceivedDummyMessageRateCollector collector{};
+  EXPECT_FALSE(collector.IsBandwidthMeasured());
+
+  for (int i = 0; i < kDefaultTimesToTest; ++i) {
+    collector.OnMessageReceived(DummyMessage{}, 0);
+  }
+  EXPECT_EQ(static_cast<uint64_t>(kDefaultTimesToTest), collector.GetMessageCount());
+
+  const auto rate = collector.GetRateAndReset(kHalfSecond);
+  EXPECT_EQ(static_cast<uint64_t>(kDefaultTimesToTest), rate.message_count);
+  EXPECT_DOUBLE_EQ(2.0 * kDefaultTimesToTest, rate.message_rate);
+  EXPECT_EQ(0u, rate.byte_count);
+  EXPECT_TRUE(std::isnan(rate.byte_rate)) << "the bandwidth is not measured";
+
+  const auto next = collector.GetRateAndReset(kHalfSecond);
+  EXPECT_EQ(0u, next.message_count) << "the window should have been reset";
+  EXPECT_DOUBLE_EQ(0.0, next.message_rate);
+  EXPECT_EQ(static_cast<uint64_t>(kDefaultTimesToTest), collector.GetMessageCount());
+}
+
+TEST(ReceivedMessageRateTest, TestEmptyWindowDuration) {
+  ReceivedDummyMessageRateCollector collector{};
+  collector.OnMessageReceived(DummyMessage{}, 0);
+
+  const auto rate = collector.GetRateResults(0);
+  EXPECT_EQ(1u, rate.message_count);
+  EXPECT_TRUE(std::isnan(rate.message_rate));
+  EXPECT_EQ(1u, collector.GetRateResults(0).message_count) << "results should not reset";
+}
+
+TEST(ReceivedMessageRateTest, TestMessageWithoutDefaultConstructor) {
+  libstatistics_collector::topic_statistics_collector::ReceivedMessageRateCollector<
+    NoDefaultMessage> collector{};
+  EXPECT_FALSE(collector.IsBandwidthMeasured());
+  collector.OnMessageReceived(NoDefaultMessage{1}, 0);
+  EXPECT_EQ(1u, collector.GetMessageCount());
+}
+
+TEST(ReceivedMessageRateTest, TestBandwidthOfSerializedMessages) {
+  ReceivedSerializedMessageRateCollector collector{};
+  EXPECT_TRUE(collector.IsBandwidthMeasured());
+
+  rcl_serialized_message_t message{};
+  message.buffer_length = kSerializedSize;
+  for (int i = 0; i < kDefaultTimesToTest; ++i) {
+    collector.OnMessageReceived(message, 0);
+  }
+
+  const auto rate = collector.GetRateAndReset(kHalfSecond);
+  EXPECT_EQ(kSerializedSize * kDefaultTimesToTest, rate.byte_count);
+  EXPECT_DOUBLE_EQ(2.0 * kSerializedSize * kDefaultTimesToTest, rate.byte_rate);
+}
+
+TEST(ReceivedMessageRateTest, TestCallerProvidedSerializedSize) {
+  ReceivedDummyMessageRateCollector measured{true};
+  ReceivedDummyMessageRateCollector unmeasured{};
+  for (int i = 0; i < kDefaultTimesToTest; ++i) {
+    measured.OnSerializedMessageReceived(DummyMessage{}, kSerializedSize);
+    unmeasured.OnSerializedMessageReceived(DummyMessage{}, kSerializedSize);
+  }
+
+  EXPECT_EQ(kSerializedSize * kDefaultTimesToTest, measured.GetRateResults(kHalfSecond).byte_count);
+  EXPECT_EQ(0u, unmeasured.GetRateResults(kHalfSecond).byte_count);
+  EXPECT_EQ(
+    static_cast<uint64_t>(kDefaultTimesToTest),
+    unmeasured.GetRateResults(kHalfSecond).message_count);
+}
+
+TEST(ReceivedMessageRateTest, TestGenerateStatisticMessages) {
+  ReceivedSerializedMessageRateCollector collector{};
+  rcl_serialized_message_t message{};
+  message.buffer_length = kSerializedSize;
+  for (int i = 0; i < kDefaultTimesToTest; ++i) {
+    collector.OnMessageReceived(message, 0);
+  }
+
+  const auto messages = collector.GenerateStatisticMessages(
+    kTestNodeName, MakeTime(10, 0), MakeTime(10, static_cast<uint32_t>(kHalfSecond)));
+  ASSERT_EQ(2u, messages.size());
+
+  EXPECT_EQ(kTestNodeName, messages[0].measurement_source_name);
+  EXPECT_EQ(constants::kMsgRateStatName, messages[0].metrics_source);
+  EXPECT_EQ(constants::kHertzUnitName, messages[0].unit);
+  EXPECT_EQ(constants::kMsgBandwidthStatName, messages[1].metrics_source);
+  EXPECT_EQ(constants::kBytesPerSecondUnitName, messages[1].unit);
+
+  const auto find = [](const statistics_msgs::msg::MetricsMessage & message, const uint8_t type) {
+      for (const auto & statistic : message.statistics) {
+        if (statistic.data_type == type) {
+          return statistic.data;
+        }
+      }
+      return std::nan("");
+    };
+  using statistics_msgs::msg::StatisticDataType;
+  EXPECT_DOUBLE_EQ(
+    2.0 * kDefaultTimesToTest, find(messages[0], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  EXPECT_DOUBLE_EQ(
+    kDefaultTimesToTest, find(messages[0], StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT));
+  EXPECT_TRUE(
+    std::isnan(find(messages[0], StatisticDataType::STATISTICS_DATA_TYPE_STDDEV)));
+  EXPECT_DOUBLE_EQ(
+    2.0 * kSerializedSize * kDefaultTimesToTest,
+    find(messages[1], StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+
+  ReceivedDummyMessageRateCollector unmeasured{};
+  EXPECT_EQ(
+    1u, unmeasured.GenerateStatisticMessages(kTestNodeName, MakeTime(1, 0), MakeTime(2, 0)).size());
+}
+
+TEST(ReceivedMessageRateTest, TestStatisticsResults) {
+  ReceivedDummyMessageRateCollector collector{};
+  EXPECT_EQ(constants::kMsgRateStatName, collector.GetMetricName());
+  EXPECT_EQ(constants::kHertzUnitName, collector.GetMetricUnit());
+  EXPECT_TRUE(collector.Start());
+
+  for (int i = 0; i < kDefaultTimesToTest; ++i) {
+    collector.OnMessageReceived(DummyMessage{}, 0);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+  const auto stats = collector.GetStatisticsAndReset();
+  // a window is a single rate sample, the message count is reported by GetRateAndReset
+  EXPECT_EQ(1u, stats.sample_count);
+  EXPECT_GT(stats.average, 0.0);
+  EXPECT_DOUBLE_EQ(stats.average, stats.min);
+  EXPECT_DOUBLE_EQ(stats.average, stats.max);
+  EXPECT_TRUE(std::isnan(stats.standard_deviation));
+  EXPECT_FALSE(collector.GetStatisticsResults().average > 0.0);
+
+  EXPECT_TRUE(collector.Stop());
+}
+
+TEST(ReceivedMessageRateTest, TestConcurrentMessagesAreNotLost) {
+  constexpr int kThreadCount{4};
+  constexpr int kMessagesPerThread{10000};
+  ReceivedDummyMessageRateCollector collector{true};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back(
+      [&collector]() {
+        for (int j = 0; j < kMessagesPerThread; ++j) {
+          collector.OnSerializedMessageReceived(DummyMessage{}, kSerializedSize);
+        }
+      });
+  }
+  uint64_t message_count = 0;
+  uint64_t byte_count = 0;
+  for (int i = 0; i < 100; ++i) {
+    const auto rate = collector.GetRateAndReset(kHalfSecond);
+    message_count += rate.message_count;
+    byte_count += rate.byte_count;
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  const auto rate = collector.GetRateAndReset(kHalfSecond);
+  message_count += rate.message_count;
+  byte_count += rate.byte_count;
+
+  EXPECT_EQ(static_cast<uint64_t>(kThreadCount * kMessagesPerThread), message_count);
+  EXPECT_EQ(kSerializedSize * kThreadCount * kMessagesPerThread, byte_count);
+}
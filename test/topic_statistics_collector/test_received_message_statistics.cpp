@@ -0,0 +1,288 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libstatistics_collector/collector/collector_registry.hpp"
+#include "libstatistics_collector/msg/dummy_message.hpp"
+#include "libstatistics_collector/topic_statistics_collector/constants.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_message_statistics.hpp"
+
+#include "rcl/time.h"
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+namespace
+{
+using DummyMessage = libstatistics_collector::msg::DummyMessage;
+using libstatistics_collector::collector::CollectorRegistry;
+using libstatistics_collector::topic_statistics_collector::ReceivedMessageMetric;
+using libstatistics_collector::topic_statistics_collector::SamplingPolicy;
+using ReceivedDummyMessageStatisticsCollector = libstatistics_collector::
+  topic_statistics_collector::ReceivedMessageStatisticsCollector<DummyMessage>;
+using ReceivedIntMessageStatisticsCollector = libstatistics_collector::
+  topic_statistics_collector::ReceivedMessageStatisticsCollector<int>;
+using statistics_msgs::msg::StatisticDataType;
+
+constexpr const int64_t kNanosPerMilli{1000000};
+constexpr const rcl_time_point_value_t kStartTime{123456789};
+constexpr const int kDefaultTimesToTest{10};
+constexpr const int kRandomIntMessage{7};
+
+DummyMessage MakeMessage(const rcl_time_point_value_t stamp_nanoseconds)
+{
+  auto msg = DummyMessage{};
+  msg.header.stamp.sec = static_cast<int32_t>(stamp_nanoseconds / 1000000000);
+  msg.header.stamp.nanosec = static_cast<uint32_t>(stamp_nanoseconds % 1000000000);
+  return msg;
+}
+}  // namespace
+
+TEST(ReceivedMessageStatisticsTest, TestAgeAndPeriodMeasurement) {
+  ReceivedDummyMessageStatisticsCollector test_collector{};
+  EXPECT_FALSE(test_collector.IsStarted());
+  EXPECT_TRUE(test_collector.Start());
+  EXPECT_FALSE(test_collector.Start());
+  EXPECT_TRUE(test_collector.IsStarted());
+
+  // received every 10, 20, 30, ... ms, each 1, 2, 3, ... ms old
+  rcl_time_point_value_t now = kStartTime;
+  for (int i = 1; i <= kDefaultTimesToTest; i++) {
+    now += 10 * i * kNanosPerMilli;
+    test_collector.OnMessageReceived(MakeMessage(now - i * kNanosPerMilli), now);
+  }
+
+  const auto age = test_collector.GetStatisticsResults(ReceivedMessageMetric::kAge);
+  EXPECT_EQ(kDefaultTimesToTest, age.sample_count);
+  EXPECT_NEAR(5.5, age.average, 1e-6);
+  EXPECT_NEAR(1.0, age.min, 1e-6);
+  EXPECT_NEAR(10.0, age.max, 1e-6);
+
+  const auto period = test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod);
+  EXPECT_EQ(kDefaultTimesToTest - 1, period.sample_count);
+  EXPECT_NEAR(60.0, period.average, 1e-6);
+  EXPECT_NEAR(20.0, period.min, 1e-6);
+  EXPECT_NEAR(100.0, period.max, 1e-6);
+
+  const auto jitter = test_collector.GetStatisticsResults(ReceivedMessageMetric::kJitter);
+  EXPECT_EQ(0, jitter.sample_count) << "Expect no jitter samples unless requested";
+  EXPECT_TRUE(std::isnan(jitter.average));
+  EXPECT_FALSE(test_collector.IsMeasured(ReceivedMessageMetric::kJitter));
+
+  EXPECT_TRUE(test_collector.Stop());
+  EXPECT_FALSE(test_collector.Stop());
+  EXPECT_EQ(0, test_collector.GetStatisticsResults(ReceivedMessageMetric::kAge).sample_count);
+  EXPECT_EQ(0, test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod).sample_count);
+}
+
+TEST(ReceivedMessageStatisticsTest, TestJitterMeasurement) {
+  ReceivedDummyMessageStatisticsCollector test_collector{true};
+  EXPECT_TRUE(test_collector.IsMeasured(ReceivedMessageMetric::kJitter));
+  EXPECT_TRUE(test_collector.Start());
+
+  // periods of 10, 30, 20, 20 ms: jitter of 20, 10 and 0 ms
+  rcl_time_point_value_t now = kStartTime;
+  for (const int64_t period_ms : {0, 10, 30, 20, 20}) {
+    now += period_ms * kNanosPerMilli;
+    test_collector.OnMessageReceived(MakeMessage(now), now);
+  }
+
+  const auto jitter = test_collector.GetStatisticsResults(ReceivedMessageMetric::kJitter);
+  EXPECT_EQ(3, jitter.sample_count);
+  EXPECT_NEAR(10.0, jitter.average, 1e-6);
+  EXPECT_NEAR(0.0, jitter.min, 1e-6);
+  EXPECT_NEAR(20.0, jitter.max, 1e-6);
+
+  // restarting forgets the last message and period
+  EXPECT_TRUE(test_collector.Stop());
+  EXPECT_TRUE(test_collector.Start());
+  test_collector.OnMessageReceived(MakeMessage(now), now + 1000 * kNanosPerMilli);
+  test_collector.OnMessageReceived(MakeMessage(now), now + 1010 * kNanosPerMilli);
+  EXPECT_EQ(1, test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod).sample_count);
+  EXPECT_EQ(0, test_collector.GetStatisticsResults(ReceivedMessageMetric::kJitter).sample_count);
+}
+
+TEST(ReceivedMessageStatisticsTest, TestDiscardedPeriods) {
+  ReceivedIntMessageStatisticsCollector test_collector{true};
+  test_collector.SetMaxPeriod(std::chrono::seconds{1});
+  EXPECT_TRUE(test_collector.Start());
+
+  // periods of 10, -50, 10, 5000, 10 and 20 ms, as ReceivedMessagePeriodTest.TestDiscardedPeriods
+  rcl_time_point_value_t now = kStartTime;
+  for (const int64_t period_ms : {0, 10, -50, 10, 5000, 10, 20}) {
+    now += period_ms * kNanosPerMilli;
+    test_collector.OnMessageReceived(kRandomIntMessage, now);
+  }
+
+  const auto period = test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod);
+  EXPECT_EQ(4, period.sample_count);
+  EXPECT_NEAR(12.5, period.average, 1e-6);
+  EXPECT_NEAR(20.0, period.max, 1e-6);
+  EXPECT_EQ(2u, test_collector.GetDiscardedPeriodCount());
+
+  // only the last two periods follow a measured period
+  const auto jitter = test_collector.GetStatisticsResults(ReceivedMessageMetric::kJitter);
+  EXPECT_EQ(1, jitter.sample_count);
+  EXPECT_NEAR(10.0, jitter.average, 1e-6);
+}
+
+TEST(ReceivedMessageStatisticsTest, TestMessageWithoutHeaderOnlyMeasuresPeriod) {
+  ReceivedIntMessageStatisticsCollector test_collector{true};
+  EXPECT_TRUE(test_collector.Start());
+  for (int i = 0; i < kDefaultTimesToTest; i++) {
+    test_collector.OnMessageReceived(kRandomIntMessage, kStartTime + i * kNanosPerMilli);
+  }
+  EXPECT_EQ(0, test_collector.GetStatisticsResults(ReceivedMessageMetric::kAge).sample_count);
+  EXPECT_EQ(
+    kDefaultTimesToTest - 1,
+    test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod).sample_count);
+  EXPECT_EQ(
+    kDefaultTimesToTest - 2,
+    test_collector.GetStatisticsResults(ReceivedMessageMetric::kJitter).sample_count);
+}
+
+TEST(ReceivedMessageStatisticsTest, TestGenerateStatisticMessages) {
+  namespace constants =
+    libstatistics_collector::topic_statistics_collector::topic_statistics_constants;
+
+  ReceivedDummyMessageStatisticsCollector test_collector{};
+  EXPECT_TRUE(test_collector.Start());
+  test_collector.OnMessageReceived(MakeMessage(kStartTime), kStartTime + kNanosPerMilli);
+  test_collector.OnMessageReceived(MakeMessage(kStartTime), kStartTime + 3 * kNanosPerMilli);
+
+  builtin_interfaces::msg::Time window_start;
+  window_start.sec = 1;
+  builtin_interfaces::msg::Time window_stop;
+  window_stop.sec = 2;
+  auto messages = test_collector.GenerateStatisticMessages("node", window_start, window_stop);
+
+  ASSERT_EQ(2u, messages.size()) << "Expect one message per measured metric";
+  EXPECT_EQ("node", messages[0].measurement_source_name);
+  EXPECT_EQ(constants::kMsgAgeStatName, messages[0].metrics_source);
+  EXPECT_EQ(constants::kMillisecondUnitName, messages[0].unit);
+  EXPECT_EQ(constants::kMsgPeriodStatName, messages[1].metrics_source);
+  EXPECT_EQ(1, messages[0].window_start.sec);
+  EXPECT_EQ(2, messages[1].window_stop.sec);
+  for (const auto & data_point : messages[1].statistics) {
+    if (data_point.data_type == StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE) {
+      EXPECT_NEAR(2.0, data_point.data, 1e-6);
+    }
+  }
+
+  // the window was reset
+  EXPECT_EQ(0, test_collector.GetStatisticsResults(ReceivedMessageMetric::kAge).sample_count);
+  EXPECT_EQ(0, test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod).sample_count);
+
+  ReceivedDummyMessageStatisticsCollector jitter_collector{true};
+  messages = jitter_collector.GenerateStatisticMessages("node", window_start, window_stop);
+  ASSERT_EQ(3u, messages.size());
+  EXPECT_EQ(constants::kMsgJitterStatName, messages[2].metrics_source);
+}
+
+TEST(ReceivedMessageStatisticsTest, TestConcurrentGetStatisticsAndReset) {
+  ReceivedIntMessageStatisticsCollector test_collector{true};
+  EXPECT_TRUE(test_collector.Start());
+
+  constexpr const int kMessages{100000};
+  std::thread writer{[&test_collector]() {
+      for (int i = 0; i < kMessages; i++) {
+        test_collector.OnMessageReceived(kRandomIntMessage, kStartTime + i * kNanosPerMilli);
+      }
+    }};
+
+  uint64_t periods = 0;
+  uint64_t jitters = 0;
+  while (periods + jitters < 2 * kMessages - 3) {
+    const auto results = test_collector.GetAllStatisticsAndReset();
+    periods += results[static_cast<size_t>(ReceivedMessageMetric::kPeriod)].sample_count;
+    jitters += results[static_cast<size_t>(ReceivedMessageMetric::kJitter)].sample_count;
+    std::this_thread::yield();
+  }
+  writer.join();
+
+  EXPECT_EQ(static_cast<uint64_t>(kMessages - 1), periods) << "Expect no period to be lost";
+  EXPECT_EQ(static_cast<uint64_t>(kMessages - 2), jitters) << "Expect no jitter to be lost";
+}
+
+TEST(ReceivedMessageStatisticsTest, TestSampling) {
+  ReceivedIntMessageStatisticsCollector test_collector{true};
+  test_collector.SetSamplingPolicy(SamplingPolicy::EveryNth(2));
+  EXPECT_TRUE(test_collector.Start());
+
+  // periods of 10, 20, 30, ... ms: every other one is measured, each 10 ms longer than the last
+  rcl_time_point_value_t now = kStartTime;
+  for (int i = 0; i < kDefaultTimesToTest; i++) {
+    now += 10 * i * kNanosPerMilli;
+    test_collector.OnMessageReceived(kRandomIntMessage, now);
+  }
+  EXPECT_EQ(static_cast<uint64_t>(kDefaultTimesToTest), test_collector.GetMessageCount());
+
+  const auto period = test_collector.GetStatisticsResults(ReceivedMessageMetric::kPeriod);
+  EXPECT_EQ(kDefaultTimesToTest / 2, period.sample_count);
+  EXPECT_DOUBLE_EQ(0.5, period.sample_rate);
+
+  // every message is stamped, so every measured period but the first has a previous one
+  const auto jitter = test_collector.GetStatisticsResults(ReceivedMessageMetric::kJitter);
+  EXPECT_EQ(kDefaultTimesToTest / 2 - 1, jitter.sample_count);
+  EXPECT_NEAR(10.0, jitter.average, 1e-6);
+  EXPECT_DOUBLE_EQ(0.5, jitter.sample_rate);
+}
+
+TEST(ReceivedMessageStatisticsTest, TestRegisterEveryMetric) {
+  namespace constants =
+    libstatistics_collector::topic_statistics_collector::topic_statistics_constants;
+
+  auto test_collector = std::make_shared<ReceivedDummyMessageStatisticsCollector>(true);
+  EXPECT_NE(nullptr, test_collector->GetJitterCollector());
+  EXPECT_EQ(nullptr, ReceivedDummyMessageStatisticsCollector{}.GetJitterCollector());
+
+  builtin_interfaces::msg::Time window_start;
+  window_start.sec = 1;
+  CollectorRegistry registry{"node", window_start};
+  registry.Register(test_collector->GetAgeCollector());
+  registry.Register(test_collector);
+  registry.Register(test_collector->GetJitterCollector());
+
+  EXPECT_TRUE(test_collector->Start());
+  EXPECT_TRUE(test_collector->GetAgeCollector()->IsStarted());
+  EXPECT_TRUE(test_collector->GetJitterCollector()->IsStarted());
+  for (int i = 0; i < kDefaultTimesToTest; i++) {
+    const rcl_time_point_value_t now = kStartTime + 10 * i * kNanosPerMilli;
+    test_collector->OnMessageReceived(MakeMessage(now - kNanosPerMilli), now);
+  }
+
+  builtin_interfaces::msg::Time window_stop;
+  window_stop.sec = 2;
+  const auto & messages = registry.GenerateStatisticMessages(window_stop);
+  ASSERT_EQ(3u, messages.size());
+  EXPECT_EQ(constants::kMsgAgeStatName, messages[0].metrics_source);
+  EXPECT_EQ(constants::kMsgPeriodStatName, messages[1].metrics_source);
+  EXPECT_EQ(constants::kMsgJitterStatName, messages[2].metrics_source);
+  for (const auto & data_point : messages[2].statistics) {
+    if (data_point.data_type == StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT) {
+      EXPECT_EQ(kDefaultTimesToTest - 2, data_point.data);
+    }
+  }
+  EXPECT_EQ(0, test_collector->GetStatisticsResults(ReceivedMessageMetric::kAge).sample_count)
+    << "the registry resets every metric";
+
+  EXPECT_TRUE(test_collector->Stop());
+  EXPECT_FALSE(test_collector->GetAgeCollector()->IsStarted());
+}
@@ -0,0 +1,148 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "libstatistics_collector/topic_statistics_collector/constants.hpp"
+#include "libstatistics_collector/topic_statistics_collector/received_serialized_message_age.hpp"
+
+#include "rcl/time.h"
+#include "rcl/types.h"
+
+namespace
+{
+using libstatistics_collector::topic_statistics_collector::ReadSerializedStamp;
+using libstatistics_collector::topic_statistics_collector::ReceivedSerializedMessageAgeCollector;
+
+constexpr const int32_t kStampSec{1000};
+constexpr const uint32_t kStampNanosec{500000000};
+constexpr const int64_t kStampNanoseconds{1000500000000};
+constexpr const uint8_t kCdrLittleEndian{0x01};
+constexpr const uint8_t kCdrBigEndian{0x00};
+
+/**
+ * CDR serialize a message holding a std_msgs/Header with an empty frame_id, preceded by
+ * padding_bytes bytes of other fields.
+ */
+std::vector<uint8_t> SerializeStampedMessage(
+  const uint8_t representation, const int32_t sec, const uint32_t nanosec,
+  const size_t padding_bytes = 0)
+{
+  std::vector<uint8_t> buffer{0x00, representation, 0x00, 0x00};
+  buffer.resize(buffer.size() + padding_bytes, 0xff);
+  const bool little_endian = representation & 0x01;
+  for (const uint32_t value : {static_cast<uint32_t>(sec), nanosec, 1u}) {
+    for (int i = 0; i < 4; i++) {
+      const int shift = 8 * (little_endian ? i : 3 - i);
+      buffer.push_back(static_cast<uint8_t>(value >> shift));
+    }
+  }
+  buffer.push_back(0);  // frame_id terminator
+  return buffer;
+}
+
+rcl_serialized_message_t AsSerializedMessage(std::vector<uint8_t> & buffer)
+{
+  rcl_serialized_message_t serialized_message{};
+  serialized_message.buffer = buffer.data();
+  serialized_message.buffer_length = buffer.size();
+  serialized_message.buffer_capacity = buffer.size();
+  return serialized_message;
+}
+}  // namespace
+
+TEST(ReceivedSerializedMessageAgeTest, TestReadSerializedStamp) {
+  for (const uint8_t representation : {kCdrLittleEndian, kCdrBigEndian, uint8_t{0x07}}) {
+    auto buffer = SerializeStampedMessage(representation, kStampSec, kStampNanosec);
+    const auto stamp = ReadSerializedStamp(AsSerializedMessage(buffer));
+    EXPECT_TRUE(stamp.first) << "representation " << int{representation};
+    EXPECT_EQ(kStampNanoseconds, stamp.second);
+  }
+
+  auto buffer = SerializeStampedMessage(kCdrLittleEndian, kStampSec, kStampNanosec, 8);
+  EXPECT_EQ(kStampNanoseconds, ReadSerializedStamp(AsSerializedMessage(buffer), 8).second);
+
+  buffer = SerializeStampedMessage(kCdrLittleEndian, -1, 0);
+  EXPECT_EQ(-RCL_S_TO_NS(1), ReadSerializedStamp(AsSerializedMessage(buffer)).second);
+}
+
+TEST(ReceivedSerializedMessageAgeTest, TestUnreadableStamp) {
+  auto buffer = SerializeStampedMessage(kCdrLittleEndian, kStampSec, kStampNanosec);
+  auto serialized_message = AsSerializedMessage(buffer);
+
+  // stamp past the end of the buffer
+  EXPECT_FALSE(ReadSerializedStamp(serialized_message, 8).first);
+  EXPECT_FALSE(ReadSerializedStamp(serialized_message, SIZE_MAX - 3).first);
+  serialized_message.buffer_length = 11;
+  EXPECT_FALSE(ReadSerializedStamp(serialized_message).first);
+  serialized_message.buffer_length = 2;
+  EXPECT_FALSE(ReadSerializedStamp(serialized_message).first);
+
+  // parameter list encapsulation
+  buffer[1] = 0x03;
+  EXPECT_FALSE(ReadSerializedStamp(AsSerializedMessage(buffer)).first);
+
+  rcl_serialized_message_t empty_message{};
+  EXPECT_FALSE(ReadSerializedStamp(empty_message).first);
+}
+
+TEST(ReceivedSerializedMessageAgeTest, TestAgeMeasurement) {
+  ReceivedSerializedMessageAgeCollector test_collector{};
+  EXPECT_TRUE(test_collector.Start());
+
+  auto buffer = SerializeStampedMessage(kCdrLittleEndian, kStampSec, kStampNanosec);
+  const auto serialized_message = AsSerializedMessage(buffer);
+  for (int i = 1; i <= 3; i++) {
+    test_collector.OnMessageReceived(serialized_message, kStampNanoseconds + RCL_MS_TO_NS(i));
+  }
+  auto stats = test_collector.GetStatisticsResults();
+  EXPECT_EQ(3, stats.sample_count);
+  EXPECT_DOUBLE_EQ(2.0, stats.average);
+  EXPECT_DOUBLE_EQ(1.0, stats.min);
+  EXPECT_DOUBLE_EQ(3.0, stats.max);
+
+  // zero stamps and unreadable messages are not measured
+  auto zero_buffer = SerializeStampedMessage(kCdrLittleEndian, 0, 0);
+  test_collector.OnMessageReceived(AsSerializedMessage(zero_buffer), kStampNanoseconds);
+  test_collector.OnMessageReceived(rcl_serialized_message_t{}, kStampNanoseconds);
+  EXPECT_EQ(3, test_collector.GetStatisticsResults().sample_count);
+  EXPECT_EQ(5u, test_collector.GetMessageCount());
+}
+
+TEST(ReceivedSerializedMessageAgeTest, TestStampOffset) {
+  EXPECT_THROW(ReceivedSerializedMessageAgeCollector{2}, std::invalid_argument);
+
+  ReceivedSerializedMessageAgeCollector test_collector{8};
+  EXPECT_EQ(8u, test_collector.GetStampOffset());
+  auto buffer = SerializeStampedMessage(kCdrBigEndian, kStampSec, kStampNanosec, 8);
+  test_collector.OnMessageReceived(
+    AsSerializedMessage(buffer), kStampNanoseconds + RCL_MS_TO_NS(5));
+  const auto stats = test_collector.GetStatisticsResults();
+  EXPECT_EQ(1, stats.sample_count);
+  EXPECT_DOUBLE_EQ(5.0, stats.average);
+}
+
+TEST(ReceivedSerializedMessageAgeTest, TestGetStatNameAndUnit) {
+  namespace constants =
+    libstatistics_collector::topic_statistics_collector::topic_statistics_constants;
+
+  ReceivedSerializedMessageAgeCollector test_collector{};
+  EXPECT_EQ(constants::kMsgAgeStatName, test_collector.GetMetricName());
+  EXPECT_EQ(constants::kMillisecondUnitName, test_collector.GetMetricUnit());
+}
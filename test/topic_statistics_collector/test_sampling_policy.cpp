@@ -0,0 +1,68 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "libstatistics_collector/topic_statistics_collector/sampling_policy.hpp"
+
+namespace
+{
+using libstatistics_collector::topic_statistics_collector::SamplingPolicy;
+
+constexpr const uint64_t kMessages{100000};
+}  // namespace
+
+TEST(SamplingPolicyTest, TestDefaultSamplesAll) {
+  const SamplingPolicy policy;
+  EXPECT_TRUE(policy.SamplesAll());
+  EXPECT_EQ(1.0, policy.GetSampleRate());
+  for (uint64_t i = 0; i < 100; i++) {
+    EXPECT_TRUE(policy.IsSampled(i));
+  }
+
+  EXPECT_TRUE(SamplingPolicy::EveryNth(1).SamplesAll());
+  EXPECT_TRUE(SamplingPolicy::Bernoulli(1.0).SamplesAll());
+}
+
+TEST(SamplingPolicyTest, TestEveryNth) {
+  const auto policy = SamplingPolicy::EveryNth(4);
+  EXPECT_FALSE(policy.SamplesAll());
+  EXPECT_EQ(0.25, policy.GetSampleRate());
+  for (uint64_t i = 0; i < 100; i++) {
+    EXPECT_EQ(i % 4 == 0, policy.IsSampled(i)) << "message " << i;
+  }
+
+  EXPECT_THROW(SamplingPolicy::EveryNth(0), std::invalid_argument);
+}
+
+TEST(SamplingPolicyTest, TestBernoulli) {
+  const auto policy = SamplingPolicy::Bernoulli(0.1);
+  EXPECT_FALSE(policy.SamplesAll());
+  EXPECT_EQ(0.1, policy.GetSampleRate());
+
+  uint64_t sampled = 0;
+  for (uint64_t i = 0; i < kMessages; i++) {
+    sampled += policy.IsSampled(i) ? 1 : 0;
+  }
+  // 10000 expected, with a standard deviation of about 95
+  EXPECT_NEAR(10000, static_cast<double>(sampled), 1000);
+
+  EXPECT_THROW(SamplingPolicy::Bernoulli(0.0), std::invalid_argument);
+  EXPECT_THROW(SamplingPolicy::Bernoulli(1.5), std::invalid_argument);
+  EXPECT_THROW(SamplingPolicy::Bernoulli(std::nan("")), std::invalid_argument);
+}
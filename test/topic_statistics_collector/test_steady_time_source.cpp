@@ -0,0 +1,57 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "libstatistics_collector/topic_statistics_collector/steady_time_source.hpp"
+
+#include "rcl/time.h"
+
+namespace
+{
+using libstatistics_collector::topic_statistics_collector::SteadyTimeSource;
+using libstatistics_collector::topic_statistics_collector::SteadyTimeSourceType;
+
+constexpr const std::chrono::milliseconds kSleepDuration{20};
+}  // namespace
+
+TEST(SteadyTimeSourceTest, TestDefaultIsSteadyClock) {
+  const SteadyTimeSource time_source;
+  EXPECT_EQ(SteadyTimeSourceType::kSteadyClock, time_source.GetType());
+  EXPECT_TRUE(SteadyTimeSource::IsSupported(SteadyTimeSourceType::kSteadyClock));
+}
+
+TEST(SteadyTimeSourceTest, TestTimeAdvances) {
+  for (const auto type : {SteadyTimeSourceType::kSteadyClock,
+      SteadyTimeSourceType::kMonotonicCoarse, SteadyTimeSourceType::kTsc})
+  {
+    const SteadyTimeSource time_source{type};
+    if (SteadyTimeSource::IsSupported(type)) {
+      EXPECT_EQ(type, time_source.GetType());
+    } else {
+      EXPECT_EQ(SteadyTimeSourceType::kSteadyClock, time_source.GetType());
+    }
+
+    const rcl_time_point_value_t start = time_source.Now();
+    std::this_thread::sleep_for(kSleepDuration);
+    const rcl_time_point_value_t stop = time_source.Now();
+
+    // allow for the resolution of the coarse clock and a loaded machine
+    EXPECT_GE(stop - start, RCL_MS_TO_NS(kSleepDuration.count()) - RCL_MS_TO_NS(5));
+    EXPECT_LT(stop - start, RCL_S_TO_NS(1));
+  }
+}